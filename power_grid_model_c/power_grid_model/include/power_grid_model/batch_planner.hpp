@@ -0,0 +1,134 @@
+// SPDX-FileCopyrightText: Contributors to the Power Grid Model project <powergridmodel@lfenergy.org>
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#pragma once
+
+#include "all_components.hpp"
+
+#include "common/common.hpp"
+#include "common/three_phase_tensor.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <functional>
+#include <numeric>
+#include <span>
+#include <vector>
+
+namespace power_grid_model {
+
+// result of the planning pass over a batch update dataset
+struct BatchPlan {
+    // all scenarios update the same components, in the same order
+    bool is_independent{true};
+    // scenario indices in the order in which they should be calculated
+    IdxVector execution_order;
+};
+
+// planning pass over a batch update dataset
+//
+// per scenario, the switching state it produces is summarized in a topology signature:
+// a hash of the ids and statuses of all updated branches, 3-way branches and sources.
+// scenarios without status updates keep the topology of the base model and have signature 0.
+// the execution order groups scenarios with the same signature, base topology first, so that consecutive scenarios
+// (which are calculated by the same worker) share the topology.
+// at the same time, the ids of each scenario are compared to the first scenario to find out if the batch is
+// independent, so that the update data is only read once.
+// if only the independence is needed, the topology signatures are skipped and the comparison stops at the first
+// scenario with different ids.
+class BatchPlanner {
+  public:
+    explicit BatchPlanner(Idx n_scenarios, bool plan_topology = true)
+        : n_scenarios_{n_scenarios},
+          plan_topology_{plan_topology},
+          topology_signature_(plan_topology ? n_scenarios : 0, 0) {}
+
+    // add the update data of all scenarios of one component type
+    template <typename Component, typename ScenarioSpans> void add_component(ScenarioSpans const& all_spans) {
+        using UpdateType = typename Component::UpdateType;
+
+        assert(static_cast<Idx>(all_spans.size()) == n_scenarios_);
+        if (n_scenarios_ == 0 || is_finished()) {
+            return;
+        }
+        ++component_type_;
+
+        auto const& first_span = all_spans.front();
+        for (Idx scenario = 0; scenario != n_scenarios_ && !is_finished(); ++scenario) {
+            auto const& span = all_spans[scenario];
+            if (is_independent_ && scenario != 0) {
+                is_independent_ = std::ranges::equal(
+                    span, first_span, [](UpdateType const& obj, UpdateType const& first) { return obj.id == first.id; });
+            }
+            if constexpr (is_topology_component<Component>) {
+                if (plan_topology_) {
+                    for (UpdateType const& obj : span) {
+                        add_topology_status<Component>(topology_signature_[scenario], obj);
+                    }
+                }
+            }
+        }
+    }
+
+    Idx n_scenarios() const { return n_scenarios_; }
+    bool is_independent() const { return is_independent_; }
+    std::vector<size_t> const& topology_signature() const { return topology_signature_; }
+
+    BatchPlan plan() const {
+        assert(plan_topology_);
+        BatchPlan plan{.is_independent = is_independent_, .execution_order = IdxVector(n_scenarios_)};
+        std::iota(plan.execution_order.begin(), plan.execution_order.end(), Idx{0});
+        // stable: scenarios with the same signature keep their relative order
+        std::ranges::stable_sort(plan.execution_order, [this](Idx x, Idx y) {
+            return topology_signature_[x] < topology_signature_[y];
+        });
+        return plan;
+    }
+
+  private:
+    Idx n_scenarios_;
+    bool plan_topology_;
+    bool is_independent_{true};
+    size_t component_type_{0};
+    std::vector<size_t> topology_signature_;
+
+    // the statuses of these components determine the topology
+    template <typename Component>
+    static constexpr bool is_topology_component = std::derived_from<Component, Branch> ||
+                                                  std::derived_from<Component, Branch3> ||
+                                                  std::same_as<Component, Source>;
+
+    // without topology planning, nothing is left to do once the batch is known to be dependent
+    bool is_finished() const { return !plan_topology_ && !is_independent_; }
+
+    static void hash_combine(size_t& seed, size_t value) {
+        seed ^= value + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+    }
+
+    template <typename Component>
+    void add_topology_status(size_t& signature, typename Component::UpdateType const& obj) const {
+        auto const statuses = [&obj] {
+            if constexpr (std::derived_from<Component, Branch>) {
+                return std::array{obj.from_status, obj.to_status};
+            } else if constexpr (std::derived_from<Component, Branch3>) {
+                return std::array{obj.status_1, obj.status_2, obj.status_3};
+            } else {
+                return std::array{obj.status};
+            }
+        }();
+        if (std::ranges::all_of(statuses, [](IntS status) { return is_nan(status); })) {
+            return;
+        }
+        hash_combine(signature, component_type_);
+        hash_combine(signature, std::hash<ID>{}(obj.id));
+        for (IntS const status : statuses) {
+            hash_combine(signature, std::hash<IntS>{}(status));
+        }
+        // reserve 0 for the base topology
+        signature = std::max(signature, size_t{1});
+    }
+};
+
+} // namespace power_grid_model
@@ -0,0 +1,70 @@
+// SPDX-FileCopyrightText: Contributors to the Power Grid Model project <powergridmodel@lfenergy.org>
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#pragma once
+
+#include "common/common.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+
+namespace power_grid_model {
+
+// contiguous range of batch scenarios [begin, end)
+struct ScenarioRange {
+    Idx begin;
+    Idx end;
+
+    constexpr bool empty() const { return begin >= end; }
+    constexpr Idx size() const { return empty() ? 0 : end - begin; }
+};
+
+// scheduler of batch scenarios over a number of workers
+//
+// all workers pull ranges of scenarios from one shared queue, instead of a fixed stride per worker.
+// the chunk size is guided by the remaining work: it is large at the start of the batch to keep the overhead low,
+// and shrinks towards the end of the batch, so that expensive scenarios (e.g. topology changes or slow convergence)
+// do not pile up on a single worker.
+// the scenarios in a chunk are consecutive, so that similar scenarios (e.g. the same topology) stay on one worker.
+//
+// next() is thread-safe and lock-free
+class BatchScheduler {
+  public:
+    BatchScheduler(Idx n_scenarios, Idx n_workers, Idx min_chunk_size = 1)
+        : n_scenarios_{std::max(n_scenarios, Idx{0})},
+          n_workers_{std::max(n_workers, Idx{1})},
+          min_chunk_size_{std::max(min_chunk_size, Idx{1})} {}
+
+    // get the next range of scenarios to calculate
+    // return an empty range if all scenarios are already handed out
+    ScenarioRange next() {
+        Idx begin = next_scenario_.load(std::memory_order_relaxed);
+        while (begin < n_scenarios_) {
+            Idx const end = std::min(n_scenarios_, begin + chunk_size(n_scenarios_ - begin));
+            if (next_scenario_.compare_exchange_weak(begin, end, std::memory_order_relaxed)) {
+                return {begin, end};
+            }
+            // begin is updated by the failed exchange, try again
+        }
+        return {n_scenarios_, n_scenarios_};
+    }
+
+    Idx n_scenarios() const { return n_scenarios_; }
+    Idx n_workers() const { return n_workers_; }
+
+  private:
+    Idx n_scenarios_;
+    Idx n_workers_;
+    Idx min_chunk_size_;
+    std::atomic<Idx> next_scenario_{0};
+
+    // guided self-scheduling: hand out half of the fair share of the remaining scenarios
+    Idx chunk_size(Idx n_remaining) const {
+        assert(n_remaining > 0);
+        return std::max(min_chunk_size_, n_remaining / (2 * n_workers_));
+    }
+};
+
+} // namespace power_grid_model
@@ -286,6 +286,35 @@ template <symmetry_tag sym_type> struct SolverOutput {
     std::vector<ApplianceSolverOutput<sym>> load_gen;
 };
 
+// sensitivities of the power flow solution to the active and reactive power injection at a bus
+// for asymmetric calculations, entry (i, j) of a tensor is the derivative of phase i to the injection in phase j
+template <symmetry_tag sym_type> struct VoltageSensitivity {
+    using sym = sym_type;
+
+    RealTensor<sym> dtheta_dp{};
+    RealTensor<sym> dtheta_dq{};
+    RealTensor<sym> dv_dp{};
+    RealTensor<sym> dv_dq{};
+};
+
+// the active and reactive power at the from side of the branch
+template <symmetry_tag sym_type> struct BranchFlowSensitivity {
+    using sym = sym_type;
+
+    RealTensor<sym> dp_dp{};
+    RealTensor<sym> dp_dq{};
+    RealTensor<sym> dq_dp{};
+    RealTensor<sym> dq_dq{};
+};
+
+// row major, entry [i * n_injection_bus + k] is the sensitivity of bus or branch i to the injection at bus k
+template <symmetry_tag sym_type> struct PowerFlowSensitivity {
+    using sym = sym_type;
+
+    std::vector<VoltageSensitivity<sym>> voltage;
+    std::vector<BranchFlowSensitivity<sym>> branch;
+};
+
 template <symmetry_tag sym_type> struct ShortCircuitSolverOutput {
     using type = solver_output_t;
     using sym = sym_type;
@@ -383,6 +412,8 @@ struct ComponentConnections {
     // 3-way branch, phase shift = phase_node_x - phase_internal_node
     std::vector<std::array<double, 3>> branch3_phase_shift;
     IntSVector source_connected;
+
+    bool operator==(ComponentConnections const&) const = default;
 };
 
 // To couple 3-way branch, to math model, 3 virtual branches are created
@@ -34,6 +34,8 @@ enum class CalculationMethod : IntS {
     iterative_current = 3,
     linear_current = 4,
     iec60909 = 5,
+    fast_decoupled = 6,
+    dc = 7,
 };
 
 enum class MeasuredTerminalType : IntS {
@@ -101,6 +103,11 @@ enum class FaultPhase : IntS {
     nan = na_IntS
 };
 
+enum class InitializationStrategy : IntS {
+    default_initialization = 0, // initialization of the calculation method (e.g. linear, flat start)
+    previous_solution = 1,      // start from the solution of the previous calculation with the same topology
+};
+
 enum class ShortCircuitVoltageScaling : IntS { minimum = 0, maximum = 1 };
 
 enum class CType : IntS { c_int32 = 0, c_int8 = 1, c_double = 2, c_double3 = 3 };
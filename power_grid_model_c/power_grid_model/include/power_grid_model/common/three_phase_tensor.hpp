@@ -121,6 +121,34 @@ static_assert(alignof(ComplexValue<asymmetric_t>) >= alignof(double[6]));
 static_assert(std::is_standard_layout_v<ComplexValue<asymmetric_t>>);
 static_assert(std::is_trivially_destructible_v<ComplexValue<asymmetric_t>>);
 
+// memory layout of complex tensors and vectors in solver-internal data
+//    interleaved: std::complex entries, as in ComplexTensor and ComplexValue
+//    split: separate planes of the real and imaginary parts, see SplitComplexTensor and SplitComplexValue
+struct interleaved_complex_t {};
+struct split_complex_t {};
+
+template <typename T>
+concept complex_layout_tag = std::derived_from<T, interleaved_complex_t> || std::derived_from<T, split_complex_t>;
+
+template <complex_layout_tag T> constexpr bool is_split_complex_v = std::derived_from<T, split_complex_t>;
+
+// complex tensor and vector with the real and imaginary parts in separate planes
+// products of them only need real arithmetic on contiguous doubles, which the compiler can vectorize
+template <symmetry_tag sym> struct SplitComplexTensor {
+    RealTensor<sym> real{};
+    RealTensor<sym> imag{};
+
+    SplitComplexTensor() = default;
+    explicit SplitComplexTensor(ComplexTensor<sym> const& x) : real{x.real()}, imag{x.imag()} {}
+};
+template <symmetry_tag sym> struct SplitComplexValue {
+    RealValue<sym> real{};
+    RealValue<sym> imag{};
+
+    SplitComplexValue() = default;
+    explicit SplitComplexValue(ComplexValue<sym> const& x) : real{x.real()}, imag{x.imag()} {}
+};
+
 // enabler
 template <class T>
 concept column_vector = (T::ColsAtCompileTime == 1);
@@ -190,6 +218,9 @@ template <column_vector_or_tensor Derived> inline auto dot_prepare(Eigen::ArrayB
 // calculate matrix multiply, dot
 inline double dot(double x, double y) { return x * y; }
 inline DoubleComplex dot(DoubleComplex const& x, DoubleComplex const& y) { return x * y; }
+// single precision, for the matrix data of the mixed precision sparse LU solver
+inline float dot(float x, float y) { return x * y; }
+inline std::complex<float> dot(std::complex<float> const& x, std::complex<float> const& y) { return x * y; }
 
 template <scalar_value... T> inline auto dot(T const&... x) { return (... * x); }
 
@@ -102,7 +102,7 @@ class Branch : public Base {
     BranchOutput<sym> get_output(BranchSolverOutput<sym> const& branch_solver_output) const {
         // result object
         BranchOutput<sym> output{};
-        static_cast<BaseOutput&>(output) = base_output(true);
+        static_cast<BaseOutput&>(output) = base_output(energized(true));
         // calculate result
         output.p_from = base_power<sym> * real(branch_solver_output.s_f);
         output.q_from = base_power<sym> * imag(branch_solver_output.s_f);
@@ -130,7 +130,7 @@ class Branch : public Base {
     BranchShortCircuitOutput
     get_sc_output(BranchShortCircuitSolverOutput<asymmetric_t> const& branch_solver_output) const {
         BranchShortCircuitOutput output{};
-        static_cast<BaseOutput&>(output) = base_output(true);
+        static_cast<BaseOutput&>(output) = base_output(energized(true));
         // calculate result
         output.i_from = base_i_from() * cabs(branch_solver_output.i_f);
         output.i_to = base_i_to() * cabs(branch_solver_output.i_t);
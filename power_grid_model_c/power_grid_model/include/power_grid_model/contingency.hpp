@@ -0,0 +1,106 @@
+// SPDX-FileCopyrightText: Contributors to the Power Grid Model project <powergridmodel@lfenergy.org>
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#pragma once
+
+#include "calculation_parameters.hpp"
+
+#include "common/common.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <span>
+#include <vector>
+
+namespace power_grid_model {
+
+// outage sets of a contingency analysis
+//
+// contingency i takes the components with the ids outage_ids[indptr[i]:indptr[i + 1]] out of service,
+// i.e. all statuses of those branches, 3-way branches and sources are set to 0.
+struct ContingencyList {
+    IdxVector indptr{0};
+    std::vector<ID> outage_ids;
+
+    Idx size() const { return static_cast<Idx>(indptr.size()) - 1; }
+
+    std::span<ID const> outages(Idx contingency) const {
+        assert(0 <= contingency && contingency < size());
+        return std::span<ID const>{outage_ids}.subspan(indptr[contingency],
+                                                       indptr[contingency + 1] - indptr[contingency]);
+    }
+};
+
+// check if all buses of a math model stay connected to a source when the given branches are switched off
+//
+// in that case the outage does not change which part of the grid is energized,
+// and it can be calculated with the topology of the base case, in which the switched off branches have no admittance.
+inline bool is_connected_without_branches(MathModelTopology const& topo, std::span<Idx const> outaged_branches) {
+    Idx const n_bus = topo.n_bus();
+    std::vector<bool> is_outaged(topo.n_branch(), false);
+    for (Idx const branch : outaged_branches) {
+        assert(0 <= branch && branch < topo.n_branch());
+        is_outaged[branch] = true;
+    }
+    auto const is_edge = [&topo, &is_outaged](Idx branch) {
+        auto const [bus_from, bus_to] = topo.branch_bus_idx[branch];
+        return !is_outaged[branch] && bus_from != -1 && bus_to != -1;
+    };
+
+    // adjacency of the remaining branches in csr format
+    IdxVector adjacent_indptr(n_bus + 1, 0);
+    for (Idx branch = 0; branch != topo.n_branch(); ++branch) {
+        if (is_edge(branch)) {
+            ++adjacent_indptr[topo.branch_bus_idx[branch][0] + 1];
+            ++adjacent_indptr[topo.branch_bus_idx[branch][1] + 1];
+        }
+    }
+    for (Idx bus = 0; bus != n_bus; ++bus) {
+        adjacent_indptr[bus + 1] += adjacent_indptr[bus];
+    }
+    IdxVector adjacent_bus(adjacent_indptr.back());
+    IdxVector adjacent_position(adjacent_indptr.cbegin(), adjacent_indptr.cend() - 1);
+    for (Idx branch = 0; branch != topo.n_branch(); ++branch) {
+        if (is_edge(branch)) {
+            auto const [bus_from, bus_to] = topo.branch_bus_idx[branch];
+            adjacent_bus[adjacent_position[bus_from]++] = bus_to;
+            adjacent_bus[adjacent_position[bus_to]++] = bus_from;
+        }
+    }
+
+    // breadth first search from all buses with a source
+    std::vector<bool> is_reached(n_bus, false);
+    IdxVector queue;
+    queue.reserve(n_bus);
+    for (Idx source = 0; source != topo.n_source(); ++source) {
+        Idx const bus = topo.sources_per_bus.get_group(source);
+        if (!is_reached[bus]) {
+            is_reached[bus] = true;
+            queue.push_back(bus);
+        }
+    }
+    for (Idx front = 0; front != static_cast<Idx>(queue.size()); ++front) {
+        Idx const bus = queue[front];
+        for (Idx adjacent_idx = adjacent_indptr[bus]; adjacent_idx != adjacent_indptr[bus + 1]; ++adjacent_idx) {
+            if (Idx const adjacent = adjacent_bus[adjacent_idx]; !is_reached[adjacent]) {
+                is_reached[adjacent] = true;
+                queue.push_back(adjacent);
+            }
+        }
+    }
+    return static_cast<Idx>(queue.size()) == n_bus;
+}
+
+// check if one of the given branches of a math model is measured by a power sensor
+//
+// the state estimation ignores the measurements on a disconnected side of a branch,
+// but not the ones on a branch that is switched off with a zero admittance in the topology of the base case.
+inline bool has_branch_power_sensors(MathModelTopology const& topo, std::span<Idx const> branches) {
+    return std::ranges::any_of(branches, [&topo](Idx branch) {
+        return !topo.power_sensors_per_branch_from.get_element_range(branch).empty() ||
+               !topo.power_sensors_per_branch_to.get_element_range(branch).empty();
+    });
+}
+
+} // namespace power_grid_model
@@ -6,15 +6,23 @@
 
 #include "../common/common.hpp"
 
+#include <algorithm>
+#include <array>
+#include <string>
+
 namespace power_grid_model::main_core {
 
 inline CalculationInfo merge_calculation_info(std::vector<CalculationInfo> const& infos) {
     CalculationInfo result;
 
-    auto const key = Timer::make_key(2226, "Max number of iterations");
+    // the maximum over the scenarios is taken for these entries, the others are summed
+    std::array<std::string, 4> const max_keys{Timer::make_key(2226, "Max number of iterations"),
+                                              Timer::make_key(2230, "Max number of linear solver iterations"),
+                                              Timer::make_key(2231, "Max linear solver memory (bytes)"),
+                                              Timer::make_key(2234, "Approximate result (DC power flow)")};
     for (auto const& info : infos) {
         for (auto const& [k, v] : info) {
-            if (k == key) {
+            if (std::ranges::find(max_keys, k) != max_keys.end()) {
                 result[k] = std::max(result[k], v);
             } else {
                 result[k] += v;
@@ -23,7 +23,7 @@ inline void clear(MathState& math_state) {
 }
 
 template <symmetry_tag sym>
-inline void update_y_bus(MathState& math_state, std::vector<MathModelParam<sym>> const& math_model_params) {
+inline void update_y_bus(MathState& math_state, std::vector<MathModelParam<sym>> math_model_params) {
     auto& y_bus_vec = [&math_state]() -> auto& {
         if constexpr (is_symmetric_v<sym>) {
             return math_state.y_bus_vec_sym;
@@ -41,7 +41,7 @@ inline void update_y_bus(MathState& math_state, std::vector<MathModelParam<sym>>
 }
 
 template <symmetry_tag sym>
-inline void update_y_bus(MathState& math_state, std::vector<MathModelParam<sym>> const& math_model_params,
+inline void update_y_bus(MathState& math_state, std::vector<MathModelParam<sym>> math_model_params,
                          std::vector<MathModelParamIncrement> const& math_model_param_increments) {
     auto& y_bus_vec = [&math_state]() -> auto& {
         if constexpr (is_symmetric_v<sym>) {
@@ -0,0 +1,97 @@
+// SPDX-FileCopyrightText: Contributors to the Power Grid Model project <powergridmodel@lfenergy.org>
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#pragma once
+
+#include "../calculation_parameters.hpp"
+#include "../math_solver/y_bus.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <list>
+#include <memory>
+
+namespace power_grid_model::main_core {
+
+// math topology and the derived y bus structures of one switching state of the grid
+// all members are immutable after insertion in the cache, so that model copies in other threads can share them
+struct CachedTopology {
+    std::vector<std::shared_ptr<MathModelTopology const>> math_topology;
+    std::shared_ptr<TopologicalComponentToMathCoupling const> topo_comp_coup;
+    // one per math model, empty if the y bus is not yet built for this topology
+    std::vector<std::shared_ptr<math_solver::YBusStructure const>> y_bus_structure;
+};
+
+// hash of the switching state of all topology components
+inline size_t hash_component_connections(ComponentConnections const& comp_conn) {
+    size_t seed = 0;
+    auto const combine = [&seed]<typename T>(T const& value) {
+        seed ^= std::hash<T>{}(value) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+    };
+    for (auto const& connected : comp_conn.branch_connected) {
+        std::ranges::for_each(connected, combine);
+    }
+    for (auto const& connected : comp_conn.branch3_connected) {
+        std::ranges::for_each(connected, combine);
+    }
+    std::ranges::for_each(comp_conn.branch_phase_shift, combine);
+    for (auto const& phase_shift : comp_conn.branch3_phase_shift) {
+        std::ranges::for_each(phase_shift, combine);
+    }
+    std::ranges::for_each(comp_conn.source_connected, combine);
+    return seed;
+}
+
+// bounded least-recently-used cache of math topologies, keyed by the switching state of the grid
+//
+// the cache is only valid for one component topology; it should be cleared when the component topology changes.
+// copying the cache is cheap: the cached topologies are shared, not copied.
+class TopologyCache {
+  public:
+    static constexpr Idx default_capacity = 8;
+
+    explicit TopologyCache(Idx capacity = default_capacity) : capacity_{std::max(capacity, Idx{1})} {}
+
+    // find the cached topology of the switching state and mark it as most recently used
+    // return nullptr if not found
+    std::shared_ptr<CachedTopology const> find(ComponentConnections const& comp_conn) {
+        size_t const hash = hash_component_connections(comp_conn);
+        auto const it = std::ranges::find_if(
+            entries_, [hash, &comp_conn](Entry const& entry) { return entry.hash == hash && entry.key == comp_conn; });
+        if (it == entries_.end()) {
+            return nullptr;
+        }
+        entries_.splice(entries_.begin(), entries_, it);
+        return entries_.front().topology;
+    }
+
+    // insert or replace the cached topology of the switching state, evict the least recently used one if full
+    void insert(ComponentConnections const& comp_conn, std::shared_ptr<CachedTopology const> topology) {
+        if (find(comp_conn) != nullptr) {
+            entries_.front().topology = std::move(topology);
+            return;
+        }
+        if (static_cast<Idx>(entries_.size()) == capacity_) {
+            entries_.pop_back();
+        }
+        entries_.push_front(
+            Entry{.hash = hash_component_connections(comp_conn), .key = comp_conn, .topology = std::move(topology)});
+    }
+
+    void clear() { entries_.clear(); }
+    Idx size() const { return static_cast<Idx>(entries_.size()); }
+    Idx capacity() const { return capacity_; }
+
+  private:
+    struct Entry {
+        size_t hash;
+        ComponentConnections key;
+        std::shared_ptr<CachedTopology const> topology;
+    };
+
+    Idx capacity_;
+    std::list<Entry> entries_; // most recently used first
+};
+
+} // namespace power_grid_model::main_core
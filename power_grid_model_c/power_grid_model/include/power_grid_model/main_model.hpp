@@ -93,6 +93,25 @@ class MainModel {
                              ConstDataset const& update_data) {
         return impl().calculate(options, result_data, update_data);
     }
+    BatchParameter calculate_contingency(Options const& options, MutableDataset const& result_data,
+                                         ContingencyList const& contingencies) {
+        return impl().calculate_contingency(options, result_data, contingencies);
+    }
+
+    template <symmetry_tag sym>
+    PowerFlowSensitivity<sym> calculate_power_flow_sensitivity(std::span<ID const> injection_nodes,
+                                                               std::span<ID const> nodes,
+                                                               std::span<ID const> branches) {
+        return impl().calculate_power_flow_sensitivity<sym>(injection_nodes, nodes, branches);
+    }
+    template <symmetry_tag sym>
+    std::vector<RealTensor<sym>> calculate_lodf(std::span<ID const> branches, std::span<ID const> outage_branches) {
+        return impl().calculate_lodf<sym>(branches, outage_branches);
+    }
+    template <symmetry_tag sym>
+    std::vector<RealTensor<sym>> calculate_dc_ptdf(std::span<ID const> branches, std::span<ID const> nodes) {
+        return impl().calculate_dc_ptdf<sym>(branches, nodes);
+    }
 
     CalculationInfo calculation_info() const { return impl().calculation_info(); }
 
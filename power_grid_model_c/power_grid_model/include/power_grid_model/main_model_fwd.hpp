@@ -8,6 +8,8 @@
 
 namespace power_grid_model {
 
+class ThreadPool;
+
 struct cached_update_t : std::true_type {};
 struct permanent_update_t : std::false_type {};
 
@@ -26,8 +28,17 @@ struct MainModelOptions {
     double err_tol{1e-8};
     Idx max_iter{20};
     Idx threading{sequential};
+    ThreadPool* thread_pool{nullptr}; // optional persistent threads for parallel batch calculation
 
     ShortCircuitVoltageScaling short_circuit_voltage_scaling{ShortCircuitVoltageScaling::maximum};
+    InitializationStrategy initialization_strategy{InitializationStrategy::default_initialization};
+
+    // re-use of the factorized jacobian in the Newton-Raphson power flow, see math_solver::JacobianReuseSettings
+    bool jacobian_reuse{false};
+    double jacobian_reuse_max_mismatch_ratio{0.5};
+    // single precision factorization of the gain matrix in the iterative linear state estimation,
+    // see math_solver::SparseLUMixedPrecisionSolver
+    bool se_mixed_precision{false};
 };
 
 } // namespace power_grid_model
@@ -8,9 +8,13 @@
 
 // main include
 #include "batch_parameter.hpp"
+#include "batch_planner.hpp"
+#include "batch_scheduler.hpp"
 #include "calculation_parameters.hpp"
 #include "container.hpp"
+#include "contingency.hpp"
 #include "main_model_fwd.hpp"
+#include "thread_pool.hpp"
 #include "topology.hpp"
 
 // common
@@ -35,10 +39,13 @@
 #include "main_core/math_state.hpp"
 #include "main_core/output.hpp"
 #include "main_core/topology.hpp"
+#include "main_core/topology_cache.hpp"
 #include "main_core/update.hpp"
 
 // stl library
+#include <algorithm>
 #include <memory>
+#include <numeric>
 #include <span>
 #include <thread>
 
@@ -322,6 +329,8 @@ class MainModelImpl<ExtraRetrievableTypes<ExtraRetrievableType...>, ComponentLis
         main_core::register_topology_components<GenericPowerSensor>(state_, comp_topo);
         main_core::register_topology_components<Regulator>(state_, comp_topo);
         state_.comp_topo = std::make_shared<ComponentTopology const>(std::move(comp_topo));
+        // cached math topologies are only valid for the component topology they are built from
+        topology_cache_.clear();
     }
 
     void reset_solvers() {
@@ -334,6 +343,7 @@ class MainModelImpl<ExtraRetrievableTypes<ExtraRetrievableType...>, ComponentLis
         state_.math_topology.clear();
         state_.topo_comp_coup.reset();
         state_.comp_coup = {};
+        current_topology_.reset();
     }
 
     /*
@@ -386,7 +396,8 @@ class MainModelImpl<ExtraRetrievableTypes<ExtraRetrievableType...>, ComponentLis
                  std::same_as<std::invoke_result_t<PrepareInputFn, Idx /*n_math_solvers*/>, std::vector<InputType>> &&
                  std::same_as<std::invoke_result_t<SolveFn, MathSolverType&, YBus const&, InputType const&>,
                               SolverOutputType>
-    std::vector<SolverOutputType> calculate_(PrepareInputFn&& prepare_input, SolveFn&& solve) {
+    std::vector<SolverOutputType> calculate_(PrepareInputFn&& prepare_input, SolveFn&& solve,
+                                             math_solver::SparseLUParallelism const& lu_parallelism) {
         using sym = typename SolverOutputType::sym;
 
         assert(construction_complete_);
@@ -399,49 +410,61 @@ class MainModelImpl<ExtraRetrievableTypes<ExtraRetrievableType...>, ComponentLis
             return prepare_input(n_math_solvers_);
         }();
         // calculate
-        return [this, &input, &solve] {
+        return [this, &input, &solve, &lu_parallelism] {
             Timer const timer(calculation_info_, 2200, "Math Calculation");
             auto& solvers = get_solvers<sym>();
             auto& y_bus_vec = get_y_bus<sym>();
             std::vector<SolverOutputType> solver_output;
             solver_output.reserve(n_math_solvers_);
             for (Idx i = 0; i != n_math_solvers_; ++i) {
+                solvers[i].set_lu_parallelism(lu_parallelism);
                 solver_output.emplace_back(solve(solvers[i], y_bus_vec[i], input[i]));
             }
             return solver_output;
         }();
     }
 
-    template <symmetry_tag sym> auto calculate_power_flow_(double err_tol, Idx max_iter) {
-        return [this, err_tol, max_iter](MainModelState const& state,
-                                         CalculationMethod calculation_method) -> std::vector<SolverOutput<sym>> {
+    template <symmetry_tag sym>
+    auto calculate_power_flow_(double err_tol, Idx max_iter, InitializationStrategy initialization_strategy,
+                               math_solver::JacobianReuseSettings jacobian_reuse,
+                               math_solver::SparseLUParallelism lu_parallelism) {
+        return [this, err_tol, max_iter, initialization_strategy, jacobian_reuse, lu_parallelism](
+                   MainModelState const& state, CalculationMethod calculation_method) -> std::vector<SolverOutput<sym>> {
             return calculate_<SolverOutput<sym>, MathSolver<sym>, YBus<sym>, PowerFlowInput<sym>>(
                 [&state](Idx n_math_solvers) { return prepare_power_flow_input<sym>(state, n_math_solvers); },
-                [this, err_tol, max_iter, calculation_method](MathSolver<sym>& solver, YBus<sym> const& y_bus,
-                                                              PowerFlowInput<sym> const& input) {
+                [this, err_tol, max_iter, calculation_method, initialization_strategy, &jacobian_reuse](
+                    MathSolver<sym>& solver, YBus<sym> const& y_bus, PowerFlowInput<sym> const& input) {
+                    solver.set_jacobian_reuse_settings(jacobian_reuse);
                     return solver.run_power_flow(input, err_tol, max_iter, calculation_info_, calculation_method,
-                                                 y_bus);
-                });
+                                                 y_bus, initialization_strategy);
+                },
+                lu_parallelism);
         };
     }
 
-    template <symmetry_tag sym> auto calculate_state_estimation_(double err_tol, Idx max_iter) {
-        return [this, err_tol, max_iter](MainModelState const& state,
-                                         CalculationMethod calculation_method) -> std::vector<SolverOutput<sym>> {
+    template <symmetry_tag sym>
+    auto calculate_state_estimation_(double err_tol, Idx max_iter, bool mixed_precision,
+                                     math_solver::SparseLUParallelism lu_parallelism) {
+        return [this, err_tol, max_iter, mixed_precision, lu_parallelism](
+                   MainModelState const& state, CalculationMethod calculation_method) -> std::vector<SolverOutput<sym>> {
             return calculate_<SolverOutput<sym>, MathSolver<sym>, YBus<sym>, StateEstimationInput<sym>>(
                 [&state](Idx n_math_solvers) { return prepare_state_estimation_input<sym>(state, n_math_solvers); },
-                [this, err_tol, max_iter, calculation_method](MathSolver<sym>& solver, YBus<sym> const& y_bus,
-                                                              StateEstimationInput<sym> const& input) {
+                [this, err_tol, max_iter, mixed_precision, calculation_method](
+                    MathSolver<sym>& solver, YBus<sym> const& y_bus, StateEstimationInput<sym> const& input) {
+                    solver.set_se_mixed_precision(mixed_precision);
                     return solver.run_state_estimation(input, err_tol, max_iter, calculation_info_, calculation_method,
                                                        y_bus);
-                });
+                },
+                lu_parallelism);
         };
     }
 
-    template <symmetry_tag sym> auto calculate_short_circuit_(ShortCircuitVoltageScaling voltage_scaling) {
-        return [this,
-                voltage_scaling](MainModelState const& /*state*/,
-                                 CalculationMethod calculation_method) -> std::vector<ShortCircuitSolverOutput<sym>> {
+    template <symmetry_tag sym>
+    auto calculate_short_circuit_(ShortCircuitVoltageScaling voltage_scaling,
+                                  math_solver::SparseLUParallelism lu_parallelism) {
+        return [this, voltage_scaling, lu_parallelism](
+                   MainModelState const& /*state*/,
+                   CalculationMethod calculation_method) -> std::vector<ShortCircuitSolverOutput<sym>> {
             return calculate_<ShortCircuitSolverOutput<sym>, MathSolver<sym>, YBus<sym>, ShortCircuitInput>(
                 [this, voltage_scaling](Idx /* n_math_solvers */) {
                     assert(is_topology_up_to_date_ && is_parameter_up_to_date<sym>());
@@ -450,7 +473,8 @@ class MainModelImpl<ExtraRetrievableTypes<ExtraRetrievableType...>, ComponentLis
                 [this, calculation_method](MathSolver<sym>& solver, YBus<sym> const& y_bus,
                                            ShortCircuitInput const& input) {
                     return solver.run_short_circuit(input, calculation_info_, calculation_method, y_bus);
-                });
+                },
+                lu_parallelism);
         };
     }
 
@@ -464,12 +488,15 @@ class MainModelImpl<ExtraRetrievableTypes<ExtraRetrievableType...>, ComponentLis
         < 0 sequential
         = 0 parallel, use number of hardware threads
         > 0 specify number of parallel threads
+    thread_pool
+        if provided, the parallel calculation runs on the persistent threads of the pool instead of new threads
     raise a BatchCalculationError if any of the calculations in the batch raised an exception
     */
     template <typename Calculate>
         requires std::invocable<std::remove_cvref_t<Calculate>, MainModelImpl&, MutableDataset const&, Idx>
     BatchParameter batch_calculation_(Calculate&& calculation_fn, MutableDataset const& result_data,
-                                      ConstDataset const& update_data, Idx threading = -1) {
+                                      ConstDataset const& update_data, Idx threading = -1,
+                                      ThreadPool* thread_pool = nullptr) {
         // if the update dataset is empty without any component
         // execute one power flow in the current instance, no batch calculation is needed
         if (update_data.empty()) {
@@ -506,12 +533,15 @@ class MainModelImpl<ExtraRetrievableTypes<ExtraRetrievableType...>, ComponentLis
         std::vector<std::string> exceptions(n_scenarios, "");
         std::vector<CalculationInfo> infos(n_scenarios);
 
+        // group the scenarios by topology, results are still written to the original scenario positions
+        BatchPlan const plan = make_batch_planner(update_data).plan();
+
         // lambda for sub batch calculation
         SequenceIdx all_scenarios_sequence;
-        auto sub_batch =
-            sub_batch_calculation_(calculation_fn, result_data, update_data, all_scenarios_sequence, exceptions, infos);
+        auto sub_batch = sub_batch_calculation_(calculation_fn, result_data, update_data, plan, all_scenarios_sequence,
+                                                exceptions, infos);
 
-        batch_dispatch(sub_batch, n_scenarios, threading);
+        batch_dispatch(sub_batch, n_scenarios, threading, thread_pool);
 
         handle_batch_exceptions(exceptions);
         calculation_info_ = main_core::merge_calculation_info(infos);
@@ -522,35 +552,46 @@ class MainModelImpl<ExtraRetrievableTypes<ExtraRetrievableType...>, ComponentLis
     template <typename Calculate>
         requires std::invocable<std::remove_cvref_t<Calculate>, MainModelImpl&, MutableDataset const&, Idx>
     auto sub_batch_calculation_(Calculate&& calculation_fn, MutableDataset const& result_data,
-                                ConstDataset const& update_data, SequenceIdx& all_scenarios_sequence,
-                                std::vector<std::string>& exceptions, std::vector<CalculationInfo>& infos) {
+                                ConstDataset const& update_data, BatchPlan const& plan,
+                                SequenceIdx& all_scenarios_sequence, std::vector<std::string>& exceptions,
+                                std::vector<CalculationInfo>& infos) {
         // const ref of current instance
         MainModelImpl const& base_model = *this;
 
         // cache component update order if possible
-        bool const is_independent = MainModelImpl::is_update_independent(update_data);
+        bool const is_independent = plan.is_independent;
         if (is_independent) {
             all_scenarios_sequence = get_sequence_idx_map(update_data);
         }
 
         return [&base_model, &exceptions, &infos, &calculation_fn, &result_data, &update_data,
+                &execution_order = plan.execution_order,
                 &all_scenarios_sequence = std::as_const(all_scenarios_sequence),
-                is_independent](Idx start, Idx stride, Idx n_scenarios) {
-            assert(n_scenarios <= narrow_cast<Idx>(exceptions.size()));
-            assert(n_scenarios <= narrow_cast<Idx>(infos.size()));
+                is_independent](BatchScheduler& scheduler) {
+            assert(scheduler.n_scenarios() <= narrow_cast<Idx>(exceptions.size()));
+            assert(scheduler.n_scenarios() <= narrow_cast<Idx>(infos.size()));
+            assert(scheduler.n_scenarios() == narrow_cast<Idx>(execution_order.size()));
+
+            // do not copy the model if there is nothing left to calculate for this thread
+            ScenarioRange range = scheduler.next();
+            if (range.empty()) {
+                return;
+            }
 
-            Timer const t_total(infos[start], 0000, "Total in thread");
+            Timer const t_total(infos[execution_order[range.begin]], 0000, "Total in thread");
 
             auto const copy_model_functor = [&base_model, &infos](Idx scenario_idx) {
                 Timer const t_copy_model_functor(infos[scenario_idx], 1100, "Copy model");
                 return MainModelImpl{base_model};
             };
-            auto model = copy_model_functor(start);
+            auto model = copy_model_functor(execution_order[range.begin]);
 
             SequenceIdx cacheable_scenario_sequence = SequenceIdx{};
             auto const& scenario_sequence = is_independent ? all_scenarios_sequence : cacheable_scenario_sequence;
-            auto [setup, winddown] = scenario_update_restore(model, update_data, scenario_sequence,
-                                                             cacheable_scenario_sequence, is_independent, infos);
+            bool keeps_topology = false;
+            auto [setup, winddown] =
+                scenario_update_restore(model, base_model, update_data, scenario_sequence, cacheable_scenario_sequence,
+                                        is_independent, keeps_topology, infos);
 
             auto calculate_scenario = MainModelImpl::call_with<Idx>(
                 [&model, &calculation_fn, &result_data, &infos](Idx scenario_idx) {
@@ -560,34 +601,75 @@ class MainModelImpl<ExtraRetrievableTypes<ExtraRetrievableType...>, ComponentLis
                 std::move(setup), std::move(winddown), scenario_exception_handler(model, exceptions, infos),
                 [&model, &copy_model_functor](Idx scenario_idx) { model = copy_model_functor(scenario_idx); });
 
-            for (Idx scenario_idx = start; scenario_idx < n_scenarios; scenario_idx += stride) {
-                Timer const t_total_single(infos[scenario_idx], 0100, "Total single calculation in thread");
+            // keep pulling scenario ranges until the whole batch is handed out
+            // the ranges are positions in the execution order of the plan
+            for (; !range.empty(); range = scheduler.next()) {
+                for (Idx position = range.begin; position != range.end; ++position) {
+                    Idx const scenario_idx = execution_order[position];
+                    Timer const t_total_single(infos[scenario_idx], 0100, "Total single calculation in thread");
 
-                calculate_scenario(scenario_idx);
+                    calculate_scenario(scenario_idx);
+                }
             }
         };
     }
 
+    static bool is_parallel_threading(Idx threading) {
+        return threading > 1 || (threading == 0 && std::thread::hardware_concurrency() > 1);
+    }
+
+    // without batch, the threads are used for the factorization and the solves of the sparse matrices
+    static math_solver::SparseLUParallelism get_lu_parallelism(Options const& options) {
+        if (options.thread_pool == nullptr || !is_parallel_threading(options.threading)) {
+            return {};
+        }
+        return {.thread_pool = options.thread_pool,
+                .n_threads = options.threading == 0 ? options.thread_pool->n_threads() : options.threading};
+    }
+
+    // the thread pool of the model for the parallel factorization, if no pool is given
+    // it is created at the first calculation that needs it and re-used by the next calculations
+    ThreadPool* get_lu_thread_pool(Idx threading) {
+        Idx const n_threads =
+            threading > 0 ? threading : std::max(static_cast<Idx>(std::thread::hardware_concurrency()), Idx{1});
+        if (lu_thread_pool_ == nullptr || lu_thread_pool_->n_threads() != n_threads) {
+            lu_thread_pool_ = std::make_shared<ThreadPool>(n_threads);
+        }
+        return lu_thread_pool_.get();
+    }
+
     // run sequential if
     //    specified threading < 0
     //    use hardware threads, but it is either unknown (0) or only has one thread (1)
     //    specified threading = 1
+    // otherwise, the threads pull ranges of scenarios from a shared scheduler until the batch is exhausted
+    // if a thread pool is provided, its threads are used, capped by the number of threads in the pool
     template <typename RunSubBatchFn>
-        requires std::invocable<std::remove_cvref_t<RunSubBatchFn>, Idx /*start*/, Idx /*stride*/, Idx /*n_scenarios*/>
-    static void batch_dispatch(RunSubBatchFn sub_batch, Idx n_scenarios, Idx threading) {
+        requires std::invocable<std::remove_cvref_t<RunSubBatchFn>, BatchScheduler&>
+    static void batch_dispatch(RunSubBatchFn sub_batch, Idx n_scenarios, Idx threading,
+                               ThreadPool* thread_pool = nullptr) {
         // run batches sequential or parallel
-        auto const hardware_thread = static_cast<Idx>(std::thread::hardware_concurrency());
+        auto const hardware_thread =
+            thread_pool != nullptr ? thread_pool->n_threads() : static_cast<Idx>(std::thread::hardware_concurrency());
         if (threading < 0 || threading == 1 || (threading == 0 && hardware_thread < 2)) {
             // run all in sequential
-            sub_batch(0, 1, n_scenarios);
+            BatchScheduler scheduler{n_scenarios, 1};
+            sub_batch(scheduler);
+        } else if (thread_pool != nullptr) {
+            // use the persistent threads of the pool
+            Idx const n_thread =
+                std::min({threading == 0 ? hardware_thread : threading, thread_pool->n_threads(), n_scenarios});
+            BatchScheduler scheduler{n_scenarios, n_thread};
+            thread_pool->run(n_thread, [&sub_batch, &scheduler] { sub_batch(scheduler); });
         } else {
             // create parallel threads
             Idx const n_thread = std::min(threading == 0 ? hardware_thread : threading, n_scenarios);
+            BatchScheduler scheduler{n_scenarios, n_thread};
             std::vector<std::thread> threads;
             threads.reserve(n_thread);
             for (Idx thread_number = 0; thread_number < n_thread; ++thread_number) {
-                // compute each sub batch with stride
-                threads.emplace_back(sub_batch, thread_number, n_thread, n_scenarios);
+                // compute sub batches from the shared scheduler
+                threads.emplace_back(sub_batch, std::ref(scheduler));
             }
             for (auto& thread : threads) {
                 thread.join();
@@ -622,22 +704,40 @@ class MainModelImpl<ExtraRetrievableTypes<ExtraRetrievableType...>, ComponentLis
         };
     }
 
-    static auto scenario_update_restore(MainModelImpl& model, ConstDataset const& update_data,
-                                        SequenceIdx const& scenario_sequence, SequenceIdx& scenario_sequence_cache,
-                                        bool is_independent, std::vector<CalculationInfo>& infos) noexcept {
+    // if the updated model keeps the topology of the base model, the update and the restore are parameter changes,
+    // see keeps_topology_of
+    static auto scenario_update_restore(MainModelImpl& model, MainModelImpl const& base_model,
+                                        ConstDataset const& update_data, SequenceIdx const& scenario_sequence,
+                                        SequenceIdx& scenario_sequence_cache, bool is_independent,
+                                        bool& keeps_topology, std::vector<CalculationInfo>& infos) noexcept {
         bool const do_update_cache = !is_independent;
         return std::make_pair(
-            [&model, &update_data, &scenario_sequence, &scenario_sequence_cache, do_update_cache,
-             &infos](Idx scenario_idx) {
+            [&model, &base_model, &update_data, &scenario_sequence, &scenario_sequence_cache, do_update_cache,
+             &keeps_topology, &infos](Idx scenario_idx) {
                 Timer const t_update_model(infos[scenario_idx], 1200, "Update model");
                 if (do_update_cache) {
                     scenario_sequence_cache = model.get_sequence_idx_map(update_data, scenario_idx);
                 }
+                // between the scenarios, the topology of the model is either up to date with the base model or dirty
+                bool const has_base_topology = model.is_topology_up_to_date_;
                 model.template update_component<cached_update_t>(update_data, scenario_idx, scenario_sequence);
+                keeps_topology = model.keeps_topology_of(base_model, scenario_sequence);
+                if (keeps_topology) {
+                    if (has_base_topology) {
+                        model.is_topology_up_to_date_ = true;
+                    } else {
+                        model.use_topology_of(base_model);
+                    }
+                }
             },
-            [&model, &scenario_sequence, &scenario_sequence_cache, do_update_cache, &infos](Idx scenario_idx) {
+            [&model, &scenario_sequence, &scenario_sequence_cache, do_update_cache, &keeps_topology,
+             &infos](Idx scenario_idx) {
                 Timer const t_update_model(infos[scenario_idx], 1201, "Restore model");
                 model.restore_components(scenario_sequence);
+                if (keeps_topology) {
+                    model.is_topology_up_to_date_ = true;
+                    keeps_topology = false;
+                }
                 if (do_update_cache) {
                     std::ranges::for_each(scenario_sequence_cache, [](auto& comp_seq_idx) { comp_seq_idx.clear(); });
                 }
@@ -677,58 +777,286 @@ class MainModelImpl<ExtraRetrievableTypes<ExtraRetrievableType...>, ComponentLis
         }
     }
 
-  public:
-    template <class Component> using UpdateType = typename Component::UpdateType;
+    // the same as sub_batch_calculation_, with the outages of a contingency instead of the update of a scenario
+    template <typename Calculate>
+        requires std::invocable<std::remove_cvref_t<Calculate>, MainModelImpl&, MutableDataset const&, Idx>
+    auto sub_contingency_calculation_(Calculate&& calculation_fn, MutableDataset const& result_data,
+                                      ContingencyList const& contingencies, IdxVector const& execution_order,
+                                      std::vector<bool> const& keeps_topology, std::vector<std::string>& exceptions,
+                                      std::vector<CalculationInfo>& infos) {
+        // const ref of current instance
+        MainModelImpl const& base_model = *this;
 
-    static bool is_update_independent(ConstDataset const& update_data) {
-        // If the batch size is (0 or) 1, then the update data for this component is 'independent'
-        if (update_data.batch_size() <= 1) {
-            return true;
+        return [&base_model, &exceptions, &infos, &calculation_fn, &result_data, &contingencies, &execution_order,
+                &keeps_topology](BatchScheduler& scheduler) {
+            assert(scheduler.n_scenarios() == narrow_cast<Idx>(execution_order.size()));
+
+            // do not copy the model if there is nothing left to calculate for this thread
+            ScenarioRange range = scheduler.next();
+            if (range.empty()) {
+                return;
+            }
+
+            Timer const t_total(infos[execution_order[range.begin]], 0000, "Total in thread");
+
+            auto const copy_model_functor = [&base_model, &infos](Idx contingency_idx) {
+                Timer const t_copy_model_functor(infos[contingency_idx], 1100, "Copy model");
+                return MainModelImpl{base_model};
+            };
+            auto model = copy_model_functor(execution_order[range.begin]);
+
+            SequenceIdx outage_sequence{};
+            auto calculate_contingency = MainModelImpl::call_with<Idx>(
+                [&model, &calculation_fn, &result_data, &infos](Idx contingency_idx) {
+                    calculation_fn(model, result_data, contingency_idx);
+                    infos[contingency_idx].merge(model.calculation_info_);
+                },
+                [&model, &contingencies, &keeps_topology, &outage_sequence, &infos](Idx contingency_idx) {
+                    Timer const t_update_model(infos[contingency_idx], 1200, "Update model");
+                    model.apply_outages(contingencies.outages(contingency_idx), keeps_topology[contingency_idx],
+                                        outage_sequence);
+                },
+                [&model, &keeps_topology, &outage_sequence, &infos](Idx contingency_idx) {
+                    Timer const t_update_model(infos[contingency_idx], 1201, "Restore model");
+                    model.restore_outages(keeps_topology[contingency_idx], outage_sequence);
+                },
+                scenario_exception_handler(model, exceptions, infos),
+                [&model, &copy_model_functor](Idx contingency_idx) { model = copy_model_functor(contingency_idx); });
+
+            for (; !range.empty(); range = scheduler.next()) {
+                for (Idx position = range.begin; position != range.end; ++position) {
+                    Idx const contingency_idx = execution_order[position];
+                    Timer const t_total_single(infos[contingency_idx], 0100, "Total single calculation in thread");
+
+                    calculate_contingency(contingency_idx);
+                }
+            }
+        };
+    }
+
+    // only branches, 3-way branches and sources can be taken out of service in a contingency
+    template <class CT>
+    static constexpr bool is_outage_component =
+        std::derived_from<CT, Branch> || std::derived_from<CT, Branch3> || std::same_as<CT, Source>;
+
+    template <class CT>
+        requires is_outage_component<CT>
+    static typename CT::UpdateType outage_update(ID id) {
+        typename CT::UpdateType update{};
+        update.id = id;
+        if constexpr (std::derived_from<CT, Branch>) {
+            update.from_status = 0;
+            update.to_status = 0;
+        } else if constexpr (std::derived_from<CT, Branch3>) {
+            update.status_1 = 0;
+            update.status_2 = 0;
+            update.status_3 = 0;
+        } else {
+            update.status = 0;
         }
+        return update;
+    }
+
+    Idx2D get_outage_idx(ID id) const {
+        Idx2D const idx = main_core::get_component_idx_by_id(state_, id);
+        bool is_outage_type = false;
+        run_functor_with_all_types_return_void([&idx, &is_outage_type]<typename CT>() {
+            is_outage_type = is_outage_type || (is_outage_component<CT> &&
+                                                idx.group == static_cast<Idx>(index_of_component<CT>));
+        });
+        if (!is_outage_type) {
+            throw IDWrongType{id};
+        }
+        return idx;
+    }
 
-        auto const is_component_update_independent = [&update_data]<typename CT>() -> bool {
-            // get span of all the update data
-            auto const all_spans = update_data.get_buffer_span_all_scenarios<meta_data::update_getter_s, CT>();
-            // Remember the first batch size, then loop over the remaining batches and check if they are of the same
-            // length
-            auto const elements_per_scenario = static_cast<Idx>(all_spans.front().size());
-            bool const uniform_batch = std::ranges::all_of(all_spans, [elements_per_scenario](auto const& span) {
-                return static_cast<Idx>(span.size()) == elements_per_scenario;
+    // check if the outage can be calculated with the topology of the base case
+    // this is the case if it only switches off branches that can be switched off in the topology,
+    // see can_switch_off_in_topology,
+    // the switched off branches then have no admittance and their results are zero
+    bool keeps_base_topology(std::span<ID const> outage_ids) const {
+        bool only_branches = true;
+        std::vector<Idx2D> branch_idx;
+        for (ID const id : outage_ids) {
+            Idx2D const idx = get_outage_idx(id);
+            bool is_branch = false;
+            run_functor_with_all_types_return_void([&idx, &is_branch]<typename CT>() {
+                is_branch = is_branch || (std::derived_from<CT, Branch> &&
+                                          idx.group == static_cast<Idx>(index_of_component<CT>));
             });
-            if (!uniform_batch) {
+            only_branches = only_branches && is_branch;
+            if (is_branch) {
+                branch_idx.push_back(idx);
+            }
+        }
+        if (!only_branches || !is_topology_up_to_date_) {
+            return false;
+        }
+
+        std::vector<IdxVector> outaged_branches(n_math_solvers_);
+        for (Idx2D const& idx : branch_idx) {
+            Idx2D const math_idx =
+                state_.topo_comp_coup->branch[main_core::get_component_sequence<Branch>(state_, idx)];
+            if (math_idx.group != -1) {
+                outaged_branches[math_idx.group].push_back(math_idx.pos);
+            }
+        }
+        return can_switch_off_in_topology(outaged_branches);
+    }
+
+    // check if the branches per math model can be switched off in the current topology
+    // all buses should stay connected to a source, and the branches should not be measured by power sensors,
+    // because the state estimation does not ignore the measurements of a branch with zero admittance
+    bool can_switch_off_in_topology(std::vector<IdxVector> const& outaged_branches) const {
+        assert(is_topology_up_to_date_);
+        assert(static_cast<Idx>(outaged_branches.size()) == n_math_solvers_);
+        for (Idx math_model = 0; math_model != n_math_solvers_; ++math_model) {
+            MathModelTopology const& topo = *state_.math_topology[math_model];
+            if (!outaged_branches[math_model].empty() &&
+                (has_branch_power_sensors(topo, outaged_branches[math_model]) ||
+                 !is_connected_without_branches(topo, outaged_branches[math_model]))) {
                 return false;
             }
-            if (elements_per_scenario == 0) {
-                return true;
+        }
+        return true;
+    }
+
+    // check if the updated model can be calculated with the topology of the base model
+    // this is the case if the update only switches off branch sides that are connected in the base model,
+    // and the branches can be switched off in its topology, see can_switch_off_in_topology.
+    // the switched off branches keep their entries in the y bus and the symbolic LU factorization, with a zero
+    // admittance. switching on a branch or changing a 3-way branch or a source always rebuilds the topology.
+    bool keeps_topology_of(MainModelImpl const& base_model, SequenceIdx const& sequence_idx) const {
+        if (!base_model.is_topology_up_to_date_) {
+            return false;
+        }
+        ComponentConnections const& base_conn = base_model.current_comp_conn_;
+        std::vector<IdxVector> outaged_branches(base_model.n_math_solvers_);
+        bool only_switched_off = true;
+        run_functor_with_all_types_return_void([this, &base_model, &base_conn, &sequence_idx, &outaged_branches,
+                                                &only_switched_off]<typename CT>() {
+            for (Idx2D const& idx : sequence_idx[index_of_component<CT>]) {
+                if constexpr (std::derived_from<CT, Branch>) {
+                    Branch const& branch = main_core::get_component<Branch>(state_, idx);
+                    Idx const seq = main_core::get_component_sequence<Branch>(state_, idx);
+                    auto const [base_from, base_to] = base_conn.branch_connected[seq];
+                    bool const from_status = branch.from_status();
+                    bool const to_status = branch.to_status();
+                    only_switched_off = only_switched_off && (base_from != 0 || !from_status) &&
+                                        (base_to != 0 || !to_status);
+                    if (Idx2D const math_idx = base_model.state_.topo_comp_coup->branch[seq];
+                        math_idx.group != -1 &&
+                        (static_cast<bool>(base_from) != from_status || static_cast<bool>(base_to) != to_status)) {
+                        outaged_branches[math_idx.group].push_back(math_idx.pos);
+                    }
+                } else if constexpr (std::derived_from<CT, Branch3>) {
+                    Branch3 const& branch3 = main_core::get_component<Branch3>(state_, idx);
+                    Idx const seq = main_core::get_component_sequence<Branch3>(state_, idx);
+                    only_switched_off = only_switched_off &&
+                                        base_conn.branch3_connected[seq] ==
+                                            Branch3Connected{static_cast<IntS>(branch3.status_1()),
+                                                             static_cast<IntS>(branch3.status_2()),
+                                                             static_cast<IntS>(branch3.status_3())};
+                } else if constexpr (std::same_as<CT, Source>) {
+                    Source const& source = main_core::get_component<Source>(state_, idx);
+                    Idx const seq = main_core::get_component_sequence<Source>(state_, idx);
+                    only_switched_off =
+                        only_switched_off && base_conn.source_connected[seq] == static_cast<IntS>(source.status());
+                }
             }
-            // Remember the begin iterator of the first scenario, then loop over the remaining scenarios and check the
-            // ids
-            auto const first_span = all_spans[0];
-            // check the subsequent scenarios
-            // only return true if all scenarios match the ids of the first batch
-            return std::all_of(all_spans.cbegin() + 1, all_spans.cend(), [&first_span](auto const& current_span) {
-                return std::ranges::equal(
-                    current_span, first_span,
-                    [](UpdateType<CT> const& obj, UpdateType<CT> const& first) { return obj.id == first.id; });
+        });
+        return only_switched_off && base_model.can_switch_off_in_topology(outaged_branches);
+    }
+
+    // use the topology of the base model, after a previous scenario changed the topology of this model
+    void use_topology_of(MainModelImpl const& base_model) {
+        assert(base_model.is_topology_up_to_date_);
+        reset_solvers();
+        current_comp_conn_ = base_model.current_comp_conn_;
+        state_.math_topology = base_model.state_.math_topology;
+        state_.topo_comp_coup = base_model.state_.topo_comp_coup;
+        current_topology_ = base_model.current_topology_;
+        n_math_solvers_ = base_model.n_math_solvers_;
+        is_topology_up_to_date_ = true;
+    }
+
+    // switch off the outaged components with a cached update, restore_outages switches them on again
+    // if keep_topology, the outage is a parameter change in the topology of the base case, see keeps_base_topology
+    void apply_outages(std::span<ID const> outage_ids, bool keep_topology, SequenceIdx& outage_sequence) {
+        if (keep_topology && !is_topology_up_to_date_) {
+            // a previous contingency calculated by this model changed the topology
+            rebuild_topology();
+        }
+        OwnedUpdateDataset outage_updates{};
+        for (ID const id : outage_ids) {
+            Idx2D const idx = get_outage_idx(id);
+            run_functor_with_all_types_return_void([id, &idx, &outage_updates, &outage_sequence]<typename CT>() {
+                if constexpr (is_outage_component<CT>) {
+                    auto& sequence = outage_sequence[index_of_component<CT>];
+                    // the inverse of a duplicated outage would not restore the component
+                    if (idx.group == static_cast<Idx>(index_of_component<CT>) &&
+                        std::ranges::find(sequence, idx) == sequence.cend()) {
+                        std::get<index_of_component<CT>>(outage_updates).push_back(outage_update<CT>(id));
+                        sequence.push_back(idx);
+                    }
+                }
             });
-        };
+        }
+        run_functor_with_all_types_return_void([this, &outage_updates, &outage_sequence]<typename CT>() {
+            this->update_component<CT, cached_update_t>(std::get<index_of_component<CT>>(outage_updates),
+                                                        outage_sequence[index_of_component<CT>]);
+        });
+        if (keep_topology) {
+            is_topology_up_to_date_ = true;
+        }
+    }
+
+    void restore_outages(bool keep_topology, SequenceIdx& outage_sequence) {
+        restore_components(outage_sequence);
+        if (keep_topology) {
+            is_topology_up_to_date_ = true;
+        }
+        std::ranges::for_each(outage_sequence, [](auto& comp_seq_idx) { comp_seq_idx.clear(); });
+    }
+
+  public:
+    template <class Component> using UpdateType = typename Component::UpdateType;
 
-        // check all components
-        auto const update_independent = run_functor_with_all_types_return_array(is_component_update_independent);
-        return std::ranges::all_of(update_independent, [](bool const is_independent) { return is_independent; });
+    static bool is_update_independent(ConstDataset const& update_data) {
+        // If the batch size is (0 or) 1, then the update data for this component is 'independent'
+        if (update_data.batch_size() <= 1) {
+            return true;
+        }
+        // the topology signatures are not needed
+        return make_batch_planner(update_data, false).is_independent();
+    }
+
+    // planning pass over the update data, see BatchPlanner
+    static BatchPlanner make_batch_planner(ConstDataset const& update_data, bool plan_topology = true) {
+        BatchPlanner planner{update_data.batch_size(), plan_topology};
+        run_functor_with_all_types_return_void([&update_data, &planner]<typename CT>() {
+            planner.template add_component<CT>(
+                update_data.get_buffer_span_all_scenarios<meta_data::update_getter_s, CT>());
+        });
+        return planner;
     }
 
     template <calculation_type_tag calculation_type, symmetry_tag sym> auto calculate(Options const& options) {
         auto const calculator = [this, &options] {
+            auto const lu_parallelism = get_lu_parallelism(options);
             if constexpr (std::derived_from<calculation_type, power_flow_t>) {
-                return calculate_power_flow_<sym>(options.err_tol, options.max_iter);
+                return calculate_power_flow_<sym>(
+                    options.err_tol, options.max_iter, options.initialization_strategy,
+                    {.enabled = options.jacobian_reuse, .max_mismatch_ratio = options.jacobian_reuse_max_mismatch_ratio},
+                    lu_parallelism);
             }
             assert(options.optimizer_type == OptimizerType::no_optimization);
             if constexpr (std::derived_from<calculation_type, state_estimation_t>) {
-                return calculate_state_estimation_<sym>(options.err_tol, options.max_iter);
+                return calculate_state_estimation_<sym>(options.err_tol, options.max_iter, options.se_mixed_precision,
+                                                        lu_parallelism);
             }
             if constexpr (std::derived_from<calculation_type, short_circuit_t>) {
-                return calculate_short_circuit_<sym>(options.short_circuit_voltage_scaling);
+                return calculate_short_circuit_<sym>(options.short_circuit_voltage_scaling, lu_parallelism);
             }
             throw UnreachableHit{"MainModelImpl::calculate", "Unknown calculation type"};
         }();
@@ -756,6 +1084,12 @@ class MainModelImpl<ExtraRetrievableTypes<ExtraRetrievableType...>, ComponentLis
                 is_three_phase ? CalculationSymmetry::symmetric : CalculationSymmetry::asymmetric;
         };
 
+        // the parallel factorization of large grids needs threads, use the pool of the model if no pool is given
+        if (options.thread_pool == nullptr && is_parallel_threading(options.threading) &&
+            state_.components.template size<Node>() >= math_solver::SparseLUParallelism::default_min_size) {
+            options.thread_pool = get_lu_thread_pool(options.threading);
+        }
+
         calculation_type_symmetry_func_selector(
             options.calculation_type, options.calculation_symmetry,
             []<calculation_type_tag calculation_type, symmetry_tag sym>(
@@ -772,15 +1106,170 @@ class MainModelImpl<ExtraRetrievableTypes<ExtraRetrievableType...>, ComponentLis
     // Batch calculation, propagating the results to result_data
     BatchParameter calculate(Options const& options, MutableDataset const& result_data,
                              ConstDataset const& update_data) {
+        bool const is_batch = !update_data.empty();
         return batch_calculation_(
-            [&options](MainModelImpl& model, MutableDataset const& target_data, Idx pos) {
+            [&options, is_batch](MainModelImpl& model, MutableDataset const& target_data, Idx pos) {
                 auto sub_opt = options; // copy
                 sub_opt.err_tol = pos != ignore_output ? options.err_tol : std::numeric_limits<double>::max();
                 sub_opt.max_iter = pos != ignore_output ? options.max_iter : 1;
+                // the threads are used for the scenarios in a batch, the single calculations are sequential
+                if (is_batch) {
+                    sub_opt.threading = Options::sequential;
+                    sub_opt.thread_pool = nullptr;
+                }
 
                 model.calculate(sub_opt, target_data, pos);
             },
-            result_data, update_data, options.threading);
+            result_data, update_data, options.threading, options.thread_pool);
+    }
+
+    /*
+    Contingency calculation, propagating the results of each contingency to result_data
+
+    result_data is a batch dataset with one scenario per contingency, only the provided components are written.
+    the base case is calculated once, after which each contingency is calculated as a change of the base case:
+    the outaged components are switched off before and switched on again after the calculation of the contingency.
+        if a contingency only switches off branches and all buses stay connected to a source, the topology of the
+            base case is kept. only the admittances of the switched off branches are updated, as well as the affected
+            part of the prefactorized matrices. with the previous solution initialization strategy, the iterative
+            methods start from the solution of the base case or of a previous contingency in the same thread.
+        otherwise, the topology is rebuilt as in a batch calculation with status updates.
+    the contingencies that keep the topology are calculated first, in parallel according to the threading options.
+    raise a BatchCalculationError if any of the contingencies raised an exception
+    */
+    BatchParameter calculate_contingency(Options const& options, MutableDataset const& result_data,
+                                         ContingencyList const& contingencies) {
+        assert(construction_complete_);
+        Idx const n_contingencies = contingencies.size();
+        if (n_contingencies == 0) {
+            return BatchParameter{};
+        }
+
+        auto const calculation_fn = [&options](MainModelImpl& model, MutableDataset const& target_data, Idx pos) {
+            auto sub_opt = options; // copy
+            // the threads are used for the contingencies, the single calculations are sequential
+            sub_opt.threading = Options::sequential;
+            sub_opt.thread_pool = nullptr;
+            model.calculate(sub_opt, target_data, pos);
+        };
+
+        // calculate the base case once, all math solvers are initialized
+        try {
+            calculation_fn(*this,
+                           {
+                               false,
+                               1,
+                               "sym_output",
+                               *meta_data_,
+                           },
+                           ignore_output);
+        } catch (const SparseMatrixError&) {
+            // the contingencies are calculated and reported individually
+        } catch (const NotObservableError&) {
+            // the contingencies are calculated and reported individually
+        } catch (const IterationDiverge&) {
+            // the contingencies are calculated and reported individually
+        }
+
+        // error messages
+        std::vector<std::string> exceptions(n_contingencies, "");
+        std::vector<CalculationInfo> infos(n_contingencies);
+
+        // the contingencies that keep the topology of the base case first
+        std::vector<bool> keeps_topology(n_contingencies);
+        for (Idx contingency = 0; contingency != n_contingencies; ++contingency) {
+            keeps_topology[contingency] = keeps_base_topology(contingencies.outages(contingency));
+        }
+        IdxVector execution_order(n_contingencies);
+        std::iota(execution_order.begin(), execution_order.end(), Idx{0});
+        std::ranges::stable_partition(execution_order,
+                                      [&keeps_topology](Idx contingency) { return keeps_topology[contingency]; });
+
+        auto sub_batch = sub_contingency_calculation_(calculation_fn, result_data, contingencies, execution_order,
+                                                      keeps_topology, exceptions, infos);
+
+        batch_dispatch(sub_batch, n_contingencies, options.threading, options.thread_pool);
+
+        handle_batch_exceptions(exceptions);
+        calculation_info_ = main_core::merge_calculation_info(infos);
+
+        return BatchParameter{};
+    }
+
+    /*
+    sensitivities of the last Newton-Raphson power flow calculation of the model to the injection at the given nodes,
+    see NewtonRaphsonPFSolver::calculate_sensitivity
+    the model should not be changed after that calculation.
+    the result is in per unit and row major, with k the index of the injection node:
+        voltage[i * injection_nodes.size() + k] is the sensitivity of nodes[i]
+        branch[i * injection_nodes.size() + k] is the sensitivity of the from side of branches[i]
+    the sensitivities between components in different islands and of components that are not energized are zero.
+    */
+    template <symmetry_tag sym>
+    PowerFlowSensitivity<sym> calculate_power_flow_sensitivity(std::span<ID const> injection_nodes,
+                                                               std::span<ID const> nodes,
+                                                               std::span<ID const> branches) {
+        assert(construction_complete_);
+        calculation_info_ = CalculationInfo{};
+        prepare_solvers<sym>();
+        auto const injection_idx = get_math_idx<Node>(injection_nodes);
+        auto const node_idx = get_math_idx<Node>(nodes);
+        auto const branch_idx = get_math_idx<Branch>(branches);
+        Idx const n_injections = std::ssize(injection_idx);
+
+        PowerFlowSensitivity<sym> result{.voltage = std::vector<VoltageSensitivity<sym>>(node_idx.size() *
+                                                                                         injection_idx.size()),
+                                         .branch = std::vector<BranchFlowSensitivity<sym>>(branch_idx.size() *
+                                                                                           injection_idx.size())};
+        for (Idx math_model = 0; math_model != n_math_solvers_; ++math_model) {
+            auto const injection = select_math_model(injection_idx, math_model);
+            auto const node = select_math_model(node_idx, math_model);
+            auto const branch = select_math_model(branch_idx, math_model);
+            if (injection.math_pos.empty() || (node.math_pos.empty() && branch.math_pos.empty())) {
+                continue;
+            }
+            auto const sensitivity = get_solvers<sym>()[math_model].calculate_power_flow_sensitivity(
+                injection.math_pos, node.math_pos, branch.math_pos, calculation_info_, get_y_bus<sym>()[math_model]);
+            scatter_math_model_result(sensitivity.voltage, node, injection, n_injections, result.voltage);
+            scatter_math_model_result(sensitivity.branch, branch, injection, n_injections, result.branch);
+        }
+        return result;
+    }
+
+    /*
+    line outage distribution factors of the last Newton-Raphson power flow calculation of the model,
+    see NewtonRaphsonPFSolver::calculate_lodf
+    the model should not be changed after that calculation.
+    the result is row major, entry [i * outage_branches.size() + m] is the factor of branches[i] to outage_branches[m].
+    the factors between branches in different islands and of branches that are not energized are zero.
+    */
+    template <symmetry_tag sym>
+    std::vector<RealTensor<sym>> calculate_lodf(std::span<ID const> branches, std::span<ID const> outage_branches) {
+        assert(construction_complete_);
+        calculation_info_ = CalculationInfo{};
+        prepare_solvers<sym>();
+        return calculate_branch_factors<sym>(
+            get_math_idx<Branch>(branches), get_math_idx<Branch>(outage_branches),
+            [this](MathSolver<sym>& solver, YBus<sym> const& y_bus, IdxVector const& rows, IdxVector const& cols) {
+                return solver.calculate_lodf(rows, cols, calculation_info_, y_bus);
+            });
+    }
+
+    /*
+    power transfer distribution factors of the dc power flow of the model, see DCPFSolver::calculate_ptdf
+    the result is row major, entry [i * nodes.size() + k] is the factor of branches[i] to the injection at nodes[k].
+    the factors between components in different islands and of components that are not energized are zero.
+    */
+    template <symmetry_tag sym>
+    std::vector<RealTensor<sym>> calculate_dc_ptdf(std::span<ID const> branches, std::span<ID const> nodes) {
+        assert(construction_complete_);
+        calculation_info_ = CalculationInfo{};
+        prepare_solvers<sym>();
+        return calculate_branch_factors<sym>(
+            get_math_idx<Branch>(branches), get_math_idx<Node>(nodes),
+            [this](MathSolver<sym>& solver, YBus<sym> const& y_bus, IdxVector const& rows, IdxVector const& cols) {
+                return solver.calculate_dc_ptdf(rows, cols, calculation_info_, y_bus);
+            });
     }
 
     template <typename Component, typename MathOutputType, std::forward_iterator ResIt>
@@ -824,6 +1313,17 @@ class MainModelImpl<ExtraRetrievableTypes<ExtraRetrievableType...>, ComponentLis
     bool is_accumulated_component_updated_{true};
     bool last_updated_calculation_symmetry_mode_{false};
 
+    // math topologies of recently seen switching states, to avoid rebuilding them in batches with topology changes
+    main_core::TopologyCache topology_cache_{};
+    // symbolic factorizations of the y bus structures, shared between islands and switching states with the same
+    // sparsity pattern
+    std::shared_ptr<math_solver::SparseLUSymbolicCache> lu_symbolic_cache_{
+        std::make_shared<math_solver::SparseLUSymbolicCache>()};
+    ComponentConnections current_comp_conn_{};
+    std::shared_ptr<main_core::CachedTopology const> current_topology_{};
+    // threads for the parallel factorization of single calculations, shared with the copies of the model
+    std::shared_ptr<ThreadPool> lu_thread_pool_{};
+
     OwnedUpdateDataset cached_inverse_update_{};
     UpdateChange cached_state_changes_{};
     std::array<std::vector<Idx2D>, n_types> parameter_changed_components_{};
@@ -832,6 +1332,76 @@ class MainModelImpl<ExtraRetrievableTypes<ExtraRetrievableType...>, ComponentLis
     bool construction_complete_{false};
 #endif // !NDEBUG
 
+    // the math model and the bus or branch in that math model of the given nodes or branches
+    // the math model is -1 if the component is not energized
+    template <typename Component>
+        requires std::same_as<Component, Node> || std::same_as<Component, Branch>
+    std::vector<Idx2D> get_math_idx(std::span<ID const> ids) const {
+        assert(is_topology_up_to_date_);
+        std::vector<Idx2D> const& coupling = [this]() -> std::vector<Idx2D> const& {
+            if constexpr (std::same_as<Component, Node>) {
+                return state_.topo_comp_coup->node;
+            } else {
+                return state_.topo_comp_coup->branch;
+            }
+        }();
+        std::vector<Idx2D> result(ids.size());
+        std::ranges::transform(ids, result.begin(), [this, &coupling](ID id) {
+            Idx2D const idx = state_.components.template get_idx_by_id<Component>(id);
+            return coupling[main_core::get_component_sequence<Component>(state_, idx)];
+        });
+        return result;
+    }
+
+    // the requested components in one math model, with their position in the math model and in the request
+    struct MathModelSelection {
+        IdxVector math_pos;
+        IdxVector request_pos;
+    };
+
+    static MathModelSelection select_math_model(std::vector<Idx2D> const& math_idx, Idx math_model) {
+        MathModelSelection selection;
+        for (Idx pos = 0; pos != std::ssize(math_idx); ++pos) {
+            if (math_idx[pos].group == math_model) {
+                selection.math_pos.push_back(math_idx[pos].pos);
+                selection.request_pos.push_back(pos);
+            }
+        }
+        return selection;
+    }
+
+    // copy the row major result of one math model into the row major result of the request
+    template <typename T>
+    static void scatter_math_model_result(std::vector<T> const& math_result, MathModelSelection const& rows,
+                                          MathModelSelection const& cols, Idx n_cols, std::vector<T>& result) {
+        Idx const n_math_cols = std::ssize(cols.request_pos);
+        assert(std::ssize(math_result) == std::ssize(rows.request_pos) * n_math_cols);
+        for (Idx row = 0; row != std::ssize(rows.request_pos); ++row) {
+            for (Idx col = 0; col != n_math_cols; ++col) {
+                result[rows.request_pos[row] * n_cols + cols.request_pos[col]] = math_result[row * n_math_cols + col];
+            }
+        }
+    }
+
+    // row major factors of branches to other branches or nodes, calculated per math model
+    template <symmetry_tag sym, typename CalculateFactors>
+    std::vector<RealTensor<sym>> calculate_branch_factors(std::vector<Idx2D> const& row_idx,
+                                                          std::vector<Idx2D> const& col_idx,
+                                                          CalculateFactors&& calculate_factors) {
+        std::vector<RealTensor<sym>> result(row_idx.size() * col_idx.size());
+        for (Idx math_model = 0; math_model != n_math_solvers_; ++math_model) {
+            auto const rows = select_math_model(row_idx, math_model);
+            auto const cols = select_math_model(col_idx, math_model);
+            if (rows.math_pos.empty() || cols.math_pos.empty()) {
+                continue;
+            }
+            auto const factors = calculate_factors(get_solvers<sym>()[math_model], get_y_bus<sym>()[math_model],
+                                                   rows.math_pos, cols.math_pos);
+            scatter_math_model_result(factors, rows, cols, std::ssize(col_idx), result);
+        }
+        return result;
+    }
+
     template <symmetry_tag sym> bool& is_parameter_up_to_date() {
         if constexpr (is_symmetric_v<sym>) {
             return is_sym_parameter_up_to_date_;
@@ -856,11 +1426,7 @@ class MainModelImpl<ExtraRetrievableTypes<ExtraRetrievableType...>, ComponentLis
         }
     }
 
-    void rebuild_topology() {
-        assert(construction_complete_);
-        // clear old solvers
-        reset_solvers();
-        // get connection info
+    ComponentConnections get_component_connections() const {
         ComponentConnections comp_conn;
         comp_conn.branch_connected.resize(state_.comp_topo->branch_node_idx.size());
         comp_conn.branch_phase_shift.resize(state_.comp_topo->branch_node_idx.size());
@@ -887,9 +1453,29 @@ class MainModelImpl<ExtraRetrievableTypes<ExtraRetrievableType...>, ComponentLis
         std::transform(state_.components.template citer<Source>().begin(),
                        state_.components.template citer<Source>().end(), comp_conn.source_connected.begin(),
                        [](Source const& source) { return source.status(); });
-        // re build
-        Topology topology{*state_.comp_topo, comp_conn};
-        std::tie(state_.math_topology, state_.topo_comp_coup) = topology.build_topology();
+        return comp_conn;
+    }
+
+    void rebuild_topology() {
+        assert(construction_complete_);
+        // clear old solvers
+        reset_solvers();
+        // get connection info
+        current_comp_conn_ = get_component_connections();
+        // re build, or re use the math topology of a switching state seen before
+        if (auto cached = topology_cache_.find(current_comp_conn_); cached != nullptr) {
+            state_.math_topology = cached->math_topology;
+            state_.topo_comp_coup = cached->topo_comp_coup;
+            current_topology_ = std::move(cached);
+        } else {
+            Topology topology{*state_.comp_topo, current_comp_conn_};
+            std::tie(state_.math_topology, state_.topo_comp_coup) = topology.build_topology();
+            current_topology_ = std::make_shared<main_core::CachedTopology const>(
+                main_core::CachedTopology{.math_topology = state_.math_topology,
+                                          .topo_comp_coup = state_.topo_comp_coup,
+                                          .y_bus_structure = {}});
+            topology_cache_.insert(current_comp_conn_, current_topology_);
+        }
         n_math_solvers_ = static_cast<Idx>(state_.math_topology.size());
         is_topology_up_to_date_ = true;
         is_sym_parameter_up_to_date_ = false;
@@ -905,49 +1491,79 @@ class MainModelImpl<ExtraRetrievableTypes<ExtraRetrievableType...>, ComponentLis
         }
         // loop all branch
         for (Idx i = 0; i != static_cast<Idx>(state_.comp_topo->branch_node_idx.size()); ++i) {
-            Idx2D const math_idx = state_.topo_comp_coup->branch[i];
-            if (math_idx.group == -1) {
-                continue;
-            }
-            // assign parameters
-            math_param[math_idx.group].branch_param[math_idx.pos] =
-                state_.components.template get_item_by_seq<Branch>(i).template calc_param<sym>();
+            assign_math_param<Branch>(math_param, i);
         }
         // loop all branch3
         for (Idx i = 0; i != static_cast<Idx>(state_.comp_topo->branch3_node_idx.size()); ++i) {
-            Idx2DBranch3 const math_idx = state_.topo_comp_coup->branch3[i];
-            if (math_idx.group == -1) {
-                continue;
-            }
-            // assign parameters, branch3 param consists of three branch parameters
-            auto const branch3_param =
-                state_.components.template get_item_by_seq<Branch3>(i).template calc_param<sym>();
-            for (size_t branch2 = 0; branch2 < 3; ++branch2) {
-                math_param[math_idx.group].branch_param[math_idx.pos[branch2]] = branch3_param[branch2];
-            }
+            assign_math_param<Branch3>(math_param, i);
         }
         // loop all shunt
         for (Idx i = 0; i != static_cast<Idx>(state_.comp_topo->shunt_node_idx.size()); ++i) {
-            Idx2D const math_idx = state_.topo_comp_coup->shunt[i];
-            if (math_idx.group == -1) {
-                continue;
-            }
-            // assign parameters
-            math_param[math_idx.group].shunt_param[math_idx.pos] =
-                state_.components.template get_item_by_seq<Shunt>(i).template calc_param<sym>();
+            assign_math_param<Shunt>(math_param, i);
         }
         // loop all source
         for (Idx i = 0; i != static_cast<Idx>(state_.comp_topo->source_node_idx.size()); ++i) {
-            Idx2D const math_idx = state_.topo_comp_coup->source[i];
-            if (math_idx.group == -1) {
-                continue;
-            }
-            // assign parameters
-            math_param[math_idx.group].source_param[math_idx.pos] =
-                state_.components.template get_item_by_seq<Source>(i).template math_param<sym>();
+            assign_math_param<Source>(math_param, i);
         }
         return math_param;
     }
+
+    // math parameters after a parameter update, without recalculating the unchanged components
+    // the parameters of the current y bus are copied and only the changed components are recalculated
+    // only valid if the y bus is up to date with all components except the ones in parameter_changed_components_
+    template <symmetry_tag sym> std::vector<MathModelParam<sym>> get_updated_math_param() {
+        std::vector<MathModelParam<sym>> math_param;
+        math_param.reserve(n_math_solvers_);
+        std::ranges::transform(get_y_bus<sym>(), std::back_inserter(math_param),
+                               [](YBus<sym> const& y_bus) { return y_bus.math_model_param(); });
+
+        run_functor_with_all_types_return_void([this, &math_param]<typename CT>() {
+            using BaseComponent =
+                std::conditional_t<std::derived_from<CT, Branch>, Branch,
+                                   std::conditional_t<std::derived_from<CT, Branch3>, Branch3, CT>>;
+            if constexpr (std::same_as<BaseComponent, Branch> || std::same_as<BaseComponent, Branch3> ||
+                          std::same_as<BaseComponent, Shunt> || std::same_as<BaseComponent, Source>) {
+                for (Idx2D const& changed_component_idx :
+                     std::get<index_of_component<CT>>(parameter_changed_components_)) {
+                    assign_math_param<BaseComponent>(
+                        math_param, main_core::get_component_sequence<BaseComponent>(state_, changed_component_idx));
+                }
+            }
+        });
+        return math_param;
+    }
+
+    // assign the math parameters of one branch, branch3, shunt or source, given its sequence number
+    template <class Component, symmetry_tag sym>
+    void assign_math_param(std::vector<MathModelParam<sym>>& math_param, Idx seq) const {
+        auto const& component = state_.components.template get_item_by_seq<Component>(seq);
+        if constexpr (std::same_as<Component, Branch>) {
+            Idx2D const math_idx = state_.topo_comp_coup->branch[seq];
+            if (math_idx.group != -1) {
+                math_param[math_idx.group].branch_param[math_idx.pos] = component.template calc_param<sym>();
+            }
+        } else if constexpr (std::same_as<Component, Branch3>) {
+            Idx2DBranch3 const math_idx = state_.topo_comp_coup->branch3[seq];
+            if (math_idx.group != -1) {
+                // branch3 param consists of three branch parameters
+                auto const branch3_param = component.template calc_param<sym>();
+                for (size_t branch2 = 0; branch2 < 3; ++branch2) {
+                    math_param[math_idx.group].branch_param[math_idx.pos[branch2]] = branch3_param[branch2];
+                }
+            }
+        } else if constexpr (std::same_as<Component, Shunt>) {
+            Idx2D const math_idx = state_.topo_comp_coup->shunt[seq];
+            if (math_idx.group != -1) {
+                math_param[math_idx.group].shunt_param[math_idx.pos] = component.template calc_param<sym>();
+            }
+        } else {
+            static_assert(std::same_as<Component, Source>);
+            Idx2D const math_idx = state_.topo_comp_coup->source[seq];
+            if (math_idx.group != -1) {
+                math_param[math_idx.group].source_param[math_idx.pos] = component.template math_param<sym>();
+            }
+        }
+    }
     template <symmetry_tag sym> std::vector<MathModelParamIncrement> get_math_param_increment() {
         using AddToIncrement = void (*)(std::vector<MathModelParamIncrement>&, MainModelState const&, Idx2D const&);
 
@@ -1260,6 +1876,8 @@ class MainModelImpl<ExtraRetrievableTypes<ExtraRetrievableType...>, ComponentLis
         // If no Ybus exists, build them
         if (y_bus_vec.empty()) {
             bool const other_y_bus_exist = (!other_y_bus_vec.empty());
+            bool const cached_y_bus_exist =
+                current_topology_ != nullptr && !current_topology_->y_bus_structure.empty();
             y_bus_vec.reserve(n_math_solvers_);
             auto math_params = get_math_param<sym>();
 
@@ -1274,9 +1892,15 @@ class MainModelImpl<ExtraRetrievableTypes<ExtraRetrievableType...>, ComponentLis
                     y_bus_vec.emplace_back(state_.math_topology[i],
                                            std::make_shared<MathModelParam<sym> const>(std::move(math_params[i])),
                                            other_y_bus_vec[i].get_y_bus_structure());
+                } else if (cached_y_bus_exist) {
+                    y_bus_vec.emplace_back(state_.math_topology[i],
+                                           std::make_shared<MathModelParam<sym> const>(std::move(math_params[i])),
+                                           current_topology_->y_bus_structure[i]);
                 } else {
                     y_bus_vec.emplace_back(state_.math_topology[i],
-                                           std::make_shared<MathModelParam<sym> const>(std::move(math_params[i])));
+                                           std::make_shared<MathModelParam<sym> const>(std::move(math_params[i])),
+                                           std::make_shared<math_solver::YBusStructure const>(
+                                               *state_.math_topology[i], lu_symbolic_cache_));
                 }
 
                 y_bus_vec.back().set_branch_param_idx(
@@ -1284,6 +1908,15 @@ class MainModelImpl<ExtraRetrievableTypes<ExtraRetrievableType...>, ComponentLis
                 y_bus_vec.back().set_shunt_param_idx(
                     IdxVector{shunt_param_in_seq_map.begin(), shunt_param_in_seq_map.end()});
             }
+
+            // keep the newly built y bus structures for the next time this switching state is seen
+            if (current_topology_ != nullptr && current_topology_->y_bus_structure.empty()) {
+                main_core::CachedTopology cached{*current_topology_};
+                std::ranges::transform(y_bus_vec, std::back_inserter(cached.y_bus_structure),
+                                       [](YBus<sym> const& y_bus) { return y_bus.shared_y_bus_struct(); });
+                current_topology_ = std::make_shared<main_core::CachedTopology const>(std::move(cached));
+                topology_cache_.insert(current_comp_conn_, current_topology_);
+            }
         }
     }
 
@@ -1304,17 +1937,13 @@ class MainModelImpl<ExtraRetrievableTypes<ExtraRetrievableType...>, ComponentLis
             solvers.reserve(n_math_solvers_);
             std::ranges::transform(state_.math_topology, std::back_inserter(solvers),
                                    [](auto math_topo) { return MathSolver<sym>{std::move(math_topo)}; });
-            for (Idx idx = 0; idx < n_math_solvers_; ++idx) {
-                get_y_bus<sym>()[idx].register_parameters_changed_callback(
-                    [solver = std::ref(solvers[idx])](bool changed) { solver.get().parameters_changed(changed); });
-            }
         } else if (!is_parameter_up_to_date<sym>()) {
-            std::vector<MathModelParam<sym>> const math_params = get_math_param<sym>();
-            std::vector<MathModelParamIncrement> const math_param_increments = get_math_param_increment<sym>();
             if (last_updated_calculation_symmetry_mode_ == is_symmetric_v<sym>) {
-                main_core::update_y_bus(math_state_, math_params, math_param_increments);
+                // only the changed components need to be recalculated
+                main_core::update_y_bus(math_state_, get_updated_math_param<sym>(),
+                                        get_math_param_increment<sym>());
             } else {
-                main_core::update_y_bus(math_state_, math_params);
+                main_core::update_y_bus(math_state_, get_math_param<sym>());
             }
         }
         // else do nothing, set everything up to date
@@ -10,8 +10,30 @@
 #include "../calculation_parameters.hpp"
 #include "../common/exception.hpp"
 
+#include <algorithm>
+#include <optional>
+
 namespace power_grid_model::math_solver::detail {
 
+// unit injection in a single phase, for the columns of a sensitivity
+template <symmetry_tag sym> inline RealValue<sym> unit_value(Idx phase) {
+    if constexpr (is_symmetric_v<sym>) {
+        return 1.0;
+    } else {
+        RealValue<sym> value{0.0};
+        value(phase) = 1.0;
+        return value;
+    }
+}
+
+template <symmetry_tag sym> inline void set_column(RealTensor<sym>& tensor, Idx phase, RealValue<sym> const& column) {
+    if constexpr (is_symmetric_v<sym>) {
+        tensor = column;
+    } else {
+        tensor.col(phase) = column;
+    }
+}
+
 template <symmetry_tag sym>
 inline void add_sources(IdxRange const& sources, Idx /* bus_number */, YBus<sym> const& y_bus,
                         ComplexVector const& u_source_vector, ComplexTensor<sym>& diagonal_element,
@@ -32,12 +54,14 @@ inline void add_linear_loads(boost::iterator_range<IdxCount> const& load_gens_pe
     }
 }
 
+// mat_data on another sparsity pattern than the LU matrix, e.g. the y bus itself without fill-ins
+// bus_entry is the position of the diagonal of every bus in mat_data
 template <symmetry_tag sym>
 inline void prepare_linear_matrix_and_rhs(YBus<sym> const& y_bus, PowerFlowInput<sym> const& input,
                                           grouped_idx_vector_type auto const& load_gens_per_bus,
                                           grouped_idx_vector_type auto const& sources_per_bus,
-                                          SolverOutput<sym>& output, ComplexTensorVector<sym>& mat_data) {
-    IdxVector const& bus_entry = y_bus.lu_diag();
+                                          SolverOutput<sym>& output, ComplexTensorVector<sym>& mat_data,
+                                          IdxVector const& bus_entry) {
     for (auto const& [bus_number, load_gens, sources] : enumerated_zip_sequence(load_gens_per_bus, sources_per_bus)) {
         Idx const diagonal_position = bus_entry[bus_number];
         auto& diagonal_element = mat_data[diagonal_position];
@@ -47,6 +71,15 @@ inline void prepare_linear_matrix_and_rhs(YBus<sym> const& y_bus, PowerFlowInput
     }
 }
 
+template <symmetry_tag sym>
+inline void prepare_linear_matrix_and_rhs(YBus<sym> const& y_bus, PowerFlowInput<sym> const& input,
+                                          grouped_idx_vector_type auto const& load_gens_per_bus,
+                                          grouped_idx_vector_type auto const& sources_per_bus,
+                                          SolverOutput<sym>& output, ComplexTensorVector<sym>& mat_data) {
+    prepare_linear_matrix_and_rhs(y_bus, input, load_gens_per_bus, sources_per_bus, output, mat_data,
+                                  y_bus.lu_diag());
+}
+
 template <symmetry_tag sym> inline void copy_y_bus(YBus<sym> const& y_bus, ComplexTensorVector<sym>& mat_data) {
     ComplexTensorVector<sym> const& ydata = y_bus.admittance();
     std::transform(y_bus.map_lu_y_bus().cbegin(), y_bus.map_lu_y_bus().cend(), mat_data.begin(), [&](Idx k) {
@@ -57,6 +90,71 @@ template <symmetry_tag sym> inline void copy_y_bus(YBus<sym> const& y_bus, Compl
     });
 }
 
+// indices of the entries which are different in the two matrices, e.g. to refactorize only the changed part
+template <symmetry_tag sym>
+inline IdxVector changed_entries(ComplexTensorVector<sym> const& mat_data, ComplexTensorVector<sym> const& prev_data) {
+    assert(mat_data.size() == prev_data.size());
+    IdxVector changed;
+    for (Idx entry = 0; entry != static_cast<Idx>(mat_data.size()); ++entry) {
+        bool is_changed{};
+        if constexpr (is_symmetric_v<sym>) {
+            is_changed = mat_data[entry] != prev_data[entry];
+        } else {
+            is_changed = (mat_data[entry] != prev_data[entry]).any();
+        }
+        if (is_changed) {
+            changed.push_back(entry);
+        }
+    }
+    return changed;
+}
+
+// modification of the matrix since the last factorization, restricted to the rows and columns of a few buses
+// e.g. switching off a branch only changes the entries between the buses of that branch
+// delta[i * n_buses + j] is the change of the entry (buses[i], buses[j]), see SparseLULowRankUpdate
+template <symmetry_tag sym> struct LowRankModification {
+    IdxVector buses;
+    ComplexTensorVector<sym> delta;
+};
+
+// a low-rank update costs one solve per modified row, beyond a few buses the refactorization is cheaper
+constexpr Idx max_low_rank_modification_buses = 4;
+
+// the changed entries (on the LU pattern) as a low-rank modification, if they span at most max_buses buses
+template <symmetry_tag sym>
+inline std::optional<LowRankModification<sym>>
+low_rank_modification(YBus<sym> const& y_bus, ComplexTensorVector<sym> const& mat_data,
+                      ComplexTensorVector<sym> const& prev_data, IdxVector const& changed,
+                      Idx max_buses = max_low_rank_modification_buses) {
+    IdxVector const& row_indptr = y_bus.row_indptr_lu();
+    IdxVector const& col_indices = y_bus.col_indices_lu();
+    IdxVector buses;
+    for (Idx const entry : changed) {
+        buses.push_back(static_cast<Idx>(std::ranges::upper_bound(row_indptr, entry) - row_indptr.cbegin()) - 1);
+        buses.push_back(col_indices[entry]);
+    }
+    std::ranges::sort(buses);
+    auto const duplicates = std::ranges::unique(buses);
+    buses.erase(duplicates.begin(), duplicates.end());
+    auto const n_buses = static_cast<Idx>(buses.size());
+    if (n_buses == 0 || n_buses > max_buses) {
+        return std::nullopt;
+    }
+
+    ComplexTensorVector<sym> delta(n_buses * n_buses, ComplexTensor<sym>{0.0});
+    for (Idx i = 0; i != n_buses; ++i) {
+        auto const row_begin = col_indices.cbegin() + row_indptr[buses[i]];
+        auto const row_end = col_indices.cbegin() + row_indptr[buses[i] + 1];
+        for (Idx j = 0; j != n_buses; ++j) {
+            if (auto const it = std::lower_bound(row_begin, row_end, buses[j]); it != row_end && *it == buses[j]) {
+                auto const entry = static_cast<Idx>(it - col_indices.cbegin());
+                delta[i * n_buses + j] = mat_data[entry] - prev_data[entry];
+            }
+        }
+    }
+    return LowRankModification<sym>{.buses = std::move(buses), .delta = std::move(delta)};
+}
+
 /// @brief Calculates current and power injection of source i for multiple symmetric sources at a node.
 /// The current injection of source i to the bus in phase space is:
 ///     i_inj_i = (y_ref_i * z_ref_t) [ (u_ref_i * y_ref_t - i_ref_t) + i_inj_t]
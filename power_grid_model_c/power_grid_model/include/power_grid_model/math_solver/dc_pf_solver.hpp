@@ -0,0 +1,343 @@
+// SPDX-FileCopyrightText: Contributors to the Power Grid Model project <powergridmodel@lfenergy.org>
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#pragma once
+
+/*
+DC Power Flow
+
+Linearized power flow for fast screening of the active power flows
+    the voltage magnitudes are flat, V = average magnitude of the source voltages
+    the angle differences are small, sin(theta_ij) ~ theta_ij
+    the resistance, the shunt admittances and the reactive power are neglected
+
+The angles are relative to the flat profile u0 (magnitude 1 p.u. and the angles of the phase shifts)
+    U_i = V * u0_i .* exp(1j * theta_i)
+The susceptance matrix is the same as B' of the fast decoupled method (see fast_decoupled_pf_solver.hpp)
+    B'ij = Im((u0_i @* conj(u0_j)) .* conj(Yij))       i != j
+    B'ii = - sum{j != i} B'ij                           (only the series branch admittances)
+The sources are modelled as a Norton equivalent with the source admittance
+    B'ii += B'ref
+    P_source = V^2 * B'ref * (theta_ref - theta_i)
+
+Linear equation
+    B' * theta = P_sp / V^2 + sum{sources} (B'ref * theta_ref)
+P_sp is the active power of the load/gen at the flat voltage magnitude.
+B' only depends on the admittance and the sources, it is factorized once and re-used in all scenarios.
+
+The branch flows are lossless
+    P_f = V^2 * B'ft * (theta_t - theta_f)
+    P_t = V^2 * B'tf * (theta_f - theta_t)
+All reactive powers are zero, the currents are calculated from the active power at the DC voltages.
+The results are approximate, which is marked in the calculation info.
+
+Power transfer distribution factors (PTDF)
+    the sensitivity of the active power flow at the from side of a branch to an injection at a bus,
+    with the injection balanced by the sources
+    PTDF_branch,k = B'ft * (X_t,k - X_f,k),     X = B'^-1
+    the columns of X are solved with the sparse right hand side of a single bus
+*/
+
+#include "common_solver_functions.hpp"
+#include "sparse_lu_solver.hpp"
+#include "y_bus.hpp"
+
+#include "../calculation_parameters.hpp"
+#include "../common/common.hpp"
+#include "../common/exception.hpp"
+#include "../common/three_phase_tensor.hpp"
+#include "../common/timer.hpp"
+
+#include <algorithm>
+#include <span>
+
+namespace power_grid_model::math_solver {
+
+namespace dc_pf {
+
+template <symmetry_tag sym> class DCPFSolver {
+  public:
+    using SparseSolverType = SparseLUSolver<RealTensor<sym>, RealValue<sym>, RealValue<sym>>;
+    using BlockPermArray = typename SparseSolverType::BlockPermArray;
+
+    DCPFSolver(YBus<sym> const& y_bus, std::shared_ptr<MathModelTopology const> const& topo_ptr)
+        : n_bus_{y_bus.size()},
+          phase_shift_{topo_ptr, &topo_ptr->phase_shift},
+          branch_bus_idx_{topo_ptr, &topo_ptr->branch_bus_idx},
+          load_gens_per_bus_{topo_ptr, &topo_ptr->load_gens_per_bus},
+          sources_per_bus_{topo_ptr, &topo_ptr->sources_per_bus},
+          load_gen_type_{topo_ptr, &topo_ptr->load_gen_type},
+          u0_(y_bus.size()),
+          theta_(y_bus.size()),
+          sparse_solver_{y_bus.shared_lu_symbolic()},
+          perm_(y_bus.size()) {
+        for (Idx bus = 0; bus != n_bus_; ++bus) {
+            u0_[bus] = ComplexValue<sym>{std::exp(1.0i * (*phase_shift_)[bus])};
+        }
+    }
+
+    SolverOutput<sym> run_power_flow(YBus<sym> const& y_bus, PowerFlowInput<sym> const& input,
+                                     CalculationInfo& calculation_info) {
+        SolverOutput<sym> output;
+        output.u.resize(n_bus_);
+
+        Timer main_timer(calculation_info, 2220, "Math solver");
+
+        // prepare matrix and rhs, the matrix is only factorized again after a change of the admittance
+        Timer sub_timer(calculation_info, 2221, "Prepare matrix");
+        factorize(y_bus);
+        double const v = flat_magnitude(input);
+        prepare_rhs(y_bus, input, v);
+
+        sub_timer = Timer(calculation_info, 2222, "Solve sparse linear equation");
+        sparse_solver_.solve_with_prefactorized_matrix(b_matrix_, perm_, theta_, theta_);
+
+        sub_timer = Timer(calculation_info, 2223, "Calculate math result");
+        for (Idx bus = 0; bus != n_bus_; ++bus) {
+            output.u[bus] = v * u0_[bus] * exp(1.0i * theta_[bus]);
+        }
+        calculate_result(y_bus, input, v, output);
+        sub_timer.stop();
+        main_timer.stop();
+
+        calculation_info[Timer::make_key(2234, "Approximate result (DC power flow)")] = 1.0;
+        return output;
+    }
+
+    // PTDF of the active power at the from side of the branches to the injections at the buses
+    // the result is row major, entry [i * buses.size() + k] is the sensitivity of branches[i] to buses[k]
+    // a branch which is not connected at both sides has zero sensitivity
+    std::vector<RealTensor<sym>> calculate_ptdf(YBus<sym> const& y_bus, std::span<Idx const> branches,
+                                                std::span<Idx const> buses) {
+        factorize(y_bus);
+        std::vector<BranchIdx> const& branch_bus_idx = *branch_bus_idx_;
+        std::vector<BranchCalcParam<sym>> const& branch_param = y_bus.math_model_param().branch_param;
+
+        // only the angles at the buses of the branches are needed
+        IdxVector x_rows;
+        for (Idx const branch : branches) {
+            for (Idx const bus : branch_bus_idx[branch]) {
+                if (bus != -1) {
+                    x_rows.push_back(bus);
+                }
+            }
+        }
+        std::ranges::sort(x_rows);
+        auto const [first, last] = std::ranges::unique(x_rows);
+        x_rows.erase(first, last);
+
+        std::vector<RealTensor<sym>> ptdf(branches.size() * buses.size());
+        std::vector<RealValue<sym>> rhs(n_bus_);
+        std::vector<RealValue<sym>> x(n_bus_);
+        for (size_t k = 0; k != buses.size(); ++k) {
+            Idx const bus = buses[k];
+            IdxVector const rhs_rows{bus};
+            for (Idx phase = 0; phase != n_phase; ++phase) {
+                rhs[bus] = detail::unit_value<sym>(phase);
+                sparse_solver_.solve_sparse_with_prefactorized_matrix(b_matrix_, perm_, rhs, rhs_rows, x_rows, x);
+                for (size_t i = 0; i != branches.size(); ++i) {
+                    auto const [bus_f, bus_t] = branch_bus_idx[branches[i]];
+                    if (bus_f == -1 || bus_t == -1) {
+                        continue;
+                    }
+                    RealTensor<sym> const b_ft = calculate_b(branch_param[branches[i]].yft(), u0_[bus_f], u0_[bus_t]);
+                    detail::set_column<sym>(ptdf[i * buses.size() + k], phase, dot(b_ft, x[bus_t] - x[bus_f]));
+                }
+            }
+            rhs[bus] = RealValue<sym>{0.0};
+        }
+        return ptdf;
+    }
+
+    void set_lu_parallelism(SparseLUParallelism const& parallelism) { sparse_solver_.set_parallelism(parallelism); }
+
+  private:
+    static constexpr Idx n_phase = is_symmetric_v<sym> ? 1 : 3;
+
+    Idx n_bus_;
+    // shared topo data
+    std::shared_ptr<DoubleVector const> phase_shift_;
+    std::shared_ptr<std::vector<BranchIdx> const> branch_bus_idx_;
+    std::shared_ptr<SparseGroupedIdxVector const> load_gens_per_bus_;
+    std::shared_ptr<DenseGroupedIdxVector const> sources_per_bus_;
+    std::shared_ptr<std::vector<LoadGenType> const> load_gen_type_;
+    // flat voltage profile
+    ComplexValueVector<sym> u0_;
+    // rhs, solved in place into the angles
+    std::vector<RealValue<sym>> theta_;
+
+    // factorized B'
+    std::vector<RealTensor<sym>> b_matrix_;
+    SparseSolverType sparse_solver_;
+    BlockPermArray perm_;
+    bool is_factorized_{false};
+    uint64_t factorized_admittance_id_{};
+
+    // B'ij = Im((u0_i @* conj(u0_j)) .* conj(Yij))
+    static RealTensor<sym> calculate_b(ComplexTensor<sym> const& yij, ComplexValue<sym> const& u0_i,
+                                       ComplexValue<sym> const& u0_j) {
+        return imag(vector_outer_product(u0_i, conj(u0_j)) * conj(yij));
+    }
+
+    RealTensor<sym> calculate_source_b(YBus<sym> const& y_bus, Idx source_number, Idx bus_number) const {
+        return calculate_b(y_bus.math_model_param().source_param[source_number].template y_ref<sym>(), u0_[bus_number],
+                           u0_[bus_number]);
+    }
+
+    // the active power of the sources, V^2 * B'ref * (theta_ref - theta_i)
+    RealValue<sym> calculate_source_power(YBus<sym> const& y_bus, PowerFlowInput<sym> const& input, double v,
+                                          Idx source_number, Idx bus_number) const {
+        RealTensor<sym> const b_ref = calculate_source_b(y_bus, source_number, bus_number);
+        return v * v * dot(b_ref, source_angle(input, source_number, bus_number) - theta_[bus_number]);
+    }
+
+    // angle of the source voltage relative to the flat profile
+    RealValue<sym> source_angle(PowerFlowInput<sym> const& input, Idx source_number, Idx bus_number) const {
+        return arg(ComplexValue<sym>{input.source[source_number]} * conj(u0_[bus_number]));
+    }
+
+    // magnitude of the flat start, the average of the source voltages
+    static double flat_magnitude(PowerFlowInput<sym> const& input) {
+        DoubleComplex sum_u_ref{};
+        for (DoubleComplex const& u_ref : input.source) {
+            sum_u_ref += u_ref;
+        }
+        return input.source.empty() ? 1.0 : cabs(sum_u_ref / static_cast<double>(input.source.size()));
+    }
+
+    // active power of the load/gen at the flat voltage magnitude
+    RealValue<sym> calculate_load_gen_power(PowerFlowInput<sym> const& input, double v, Idx load_number) const {
+        using enum LoadGenType;
+        RealValue<sym> const p_base = real(input.s_injection[load_number]);
+        LoadGenType const type = (*load_gen_type_)[load_number];
+        switch (type) {
+        case const_pq:
+            return p_base;
+        case const_y:
+            return p_base * v * v;
+        case const_i:
+            return p_base * v;
+        default:
+            throw MissingCaseForEnumError("DC power flow", type);
+        }
+    }
+
+    void factorize(YBus<sym> const& y_bus) {
+        // the admittance id also detects changes in copies of the y bus
+        if (is_factorized_ && y_bus.admittance_id() == factorized_admittance_id_) {
+            return;
+        }
+        is_factorized_ = false;
+        prepare_b_matrix(y_bus);
+        sparse_solver_.prefactorize(b_matrix_, perm_);
+        factorized_admittance_id_ = y_bus.admittance_id();
+        is_factorized_ = true;
+    }
+
+    void prepare_b_matrix(YBus<sym> const& y_bus) {
+        IdxVector const& indptr = y_bus.row_indptr_lu();
+        IdxVector const& indices = y_bus.col_indices_lu();
+        IdxVector const& map_lu_y_bus = y_bus.map_lu_y_bus();
+        IdxVector const& bus_entry = y_bus.lu_diag();
+        ComplexTensorVector<sym> const& ydata = y_bus.admittance();
+
+        b_matrix_.resize(y_bus.nnz_lu());
+        for (Idx row = 0; row != n_bus_; ++row) {
+            RealTensor<sym>& diagonal = b_matrix_[bus_entry[row]];
+            diagonal = RealTensor<sym>{};
+            for (Idx k = indptr[row]; k != indptr[row + 1]; ++k) {
+                if (k == bus_entry[row]) {
+                    continue;
+                }
+                // set to zero if it is a fill-in
+                Idx const k_y_bus = map_lu_y_bus[k];
+                b_matrix_[k] =
+                    k_y_bus == -1 ? RealTensor<sym>{} : calculate_b(ydata[k_y_bus], u0_[row], u0_[indices[k]]);
+                diagonal -= b_matrix_[k];
+            }
+        }
+        for (auto const& [bus_number, sources] : enumerated_zip_sequence(*sources_per_bus_)) {
+            for (Idx const source_number : sources) {
+                b_matrix_[bus_entry[bus_number]] += calculate_source_b(y_bus, source_number, bus_number);
+            }
+        }
+    }
+
+    // P_sp / V^2 + sum{sources} (B'ref * theta_ref)
+    void prepare_rhs(YBus<sym> const& y_bus, PowerFlowInput<sym> const& input, double v) {
+        for (auto const& [bus_number, load_gens, sources] :
+             enumerated_zip_sequence(*load_gens_per_bus_, *sources_per_bus_)) {
+            RealValue<sym> p_sp{0.0};
+            for (Idx const load_number : load_gens) {
+                p_sp += calculate_load_gen_power(input, v, load_number);
+            }
+            theta_[bus_number] = p_sp / (v * v);
+            for (Idx const source_number : sources) {
+                RealTensor<sym> const b_ref = calculate_source_b(y_bus, source_number, bus_number);
+                theta_[bus_number] += dot(b_ref, source_angle(input, source_number, bus_number));
+            }
+        }
+    }
+
+    // lossless active power flows, without reactive power
+    void calculate_result(YBus<sym> const& y_bus, PowerFlowInput<sym> const& input, double v,
+                          SolverOutput<sym>& output) const {
+        std::vector<BranchIdx> const& branch_bus_idx = *branch_bus_idx_;
+        std::vector<BranchCalcParam<sym>> const& branch_param = y_bus.math_model_param().branch_param;
+        auto const appliance_output = [](RealValue<sym> const& p, ComplexValue<sym> const& u) {
+            ApplianceSolverOutput<sym> result;
+            result.s = ComplexValue<sym>{p, RealValue<sym>{0.0}};
+            result.i = conj(result.s / u);
+            return result;
+        };
+
+        output.branch.resize(branch_param.size());
+        for (size_t branch = 0; branch != branch_param.size(); ++branch) {
+            auto const [bus_f, bus_t] = branch_bus_idx[branch];
+            BranchSolverOutput<sym>& branch_output = output.branch[branch];
+            if (bus_f == -1 || bus_t == -1) {
+                branch_output = BranchSolverOutput<sym>{};
+                continue;
+            }
+            RealTensor<sym> const b_ft = calculate_b(branch_param[branch].yft(), u0_[bus_f], u0_[bus_t]);
+            RealTensor<sym> const b_tf = calculate_b(branch_param[branch].ytf(), u0_[bus_t], u0_[bus_f]);
+            RealValue<sym> const p_f = v * v * dot(b_ft, theta_[bus_t] - theta_[bus_f]);
+            RealValue<sym> const p_t = v * v * dot(b_tf, theta_[bus_f] - theta_[bus_t]);
+            branch_output.s_f = ComplexValue<sym>{p_f, RealValue<sym>{0.0}};
+            branch_output.s_t = ComplexValue<sym>{p_t, RealValue<sym>{0.0}};
+            branch_output.i_f = conj(branch_output.s_f / output.u[bus_f]);
+            branch_output.i_t = conj(branch_output.s_t / output.u[bus_t]);
+        }
+
+        // the shunts only have reactive power in the dc approximation
+        output.shunt.assign(y_bus.math_model_param().shunt_param.size(), ApplianceSolverOutput<sym>{});
+
+        output.source.resize(sources_per_bus_->element_size());
+        output.load_gen.resize(load_gens_per_bus_->element_size());
+        output.bus_injection.resize(n_bus_);
+        for (auto const& [bus_number, load_gens, sources] :
+             enumerated_zip_sequence(*load_gens_per_bus_, *sources_per_bus_)) {
+            ComplexValue<sym> const& u = output.u[bus_number];
+            output.bus_injection[bus_number] = ComplexValue<sym>{0.0};
+            for (Idx const load_number : load_gens) {
+                output.load_gen[load_number] = appliance_output(calculate_load_gen_power(input, v, load_number), u);
+                output.bus_injection[bus_number] += output.load_gen[load_number].s;
+            }
+            for (Idx const source_number : sources) {
+                output.source[source_number] =
+                    appliance_output(calculate_source_power(y_bus, input, v, source_number, bus_number), u);
+                output.bus_injection[bus_number] += output.source[source_number].s;
+            }
+        }
+    }
+};
+
+template class DCPFSolver<symmetric_t>;
+template class DCPFSolver<asymmetric_t>;
+
+} // namespace dc_pf
+
+using dc_pf::DCPFSolver;
+
+} // namespace power_grid_model::math_solver
@@ -0,0 +1,262 @@
+// SPDX-FileCopyrightText: Contributors to the Power Grid Model project <powergridmodel@lfenergy.org>
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#pragma once
+
+/*
+Fast Decoupled Power Flow
+
+The Newton-Raphson iteration (see newton_raphson_pf_solver.hpp) solves
+    [[H, N],  * [del_theta, del_V/V]^T = [del_P, del_Q]^T
+     [M, L]]
+
+For networks with a high X/R ratio and voltages close to the flat profile
+    N and M are small compared to H and L, and are neglected (decoupling)
+    Hij ~ Lij ~ diag(Vi) * B'ij * diag(Vj)
+    B'ij = Im((u0_i @* conj(u0_j)) .* conj(Yij))
+u0 is the flat profile with a magnitude of 1 p.u. and the angles of the phase shifts (and the phase rotation).
+For symmetric calculations without phase shift, B' is the negative susceptance matrix -B.
+The source admittances are added to the diagonal of Y, the correction of the diagonal with the injection is neglected.
+
+With Vj ~ 1 p.u. the iteration is split in two half iterations
+    del_theta = B'^-1 * (del_P / V)         (with the mismatch at the voltage of the previous iteration)
+    theta += del_theta
+    del_V = B'^-1 * (del_Q / V)             (with the mismatch at the updated angles)
+    V += del_V
+The power mismatch del_PQ = PQ_sp - PQ_cal is calculated in the same way as in the Newton-Raphson method.
+
+B' is real and only depends on the admittance of the network and the sources.
+It is factorized once and the factorization is re-used in all iterations and all scenarios with the same parameters.
+B' and B'' of the classical XB/BX methods are both the same matrix B' here,
+    because the series reactance cannot be separated from the three-phase branch admittances in general.
+
+The iteration converges linearly instead of quadratically, and may not converge for a low X/R ratio.
+The iteration stops early if the deviation is not reduced enough in an iteration (the iteration stalls).
+The math solver falls back to the Newton-Raphson method if the iteration did not converge.
+*/
+
+#include "common_solver_functions.hpp"
+#include "iterative_pf_solver.hpp"
+#include "sparse_lu_solver.hpp"
+#include "y_bus.hpp"
+
+#include "../calculation_parameters.hpp"
+#include "../common/common.hpp"
+#include "../common/exception.hpp"
+#include "../common/three_phase_tensor.hpp"
+#include "../common/timer.hpp"
+
+#include <cmath>
+#include <limits>
+#include <span>
+
+namespace power_grid_model::math_solver {
+
+// hide implementation in inside namespace
+namespace fast_decoupled_pf {
+
+// solver
+template <symmetry_tag sym> class FastDecoupledPFSolver : public IterativePFSolver<sym, FastDecoupledPFSolver<sym>> {
+  public:
+    using SparseSolverType = SparseLUSolver<RealTensor<sym>, RealValue<sym>, RealValue<sym>>;
+    using BlockPermArray = typename SparseSolverType::BlockPermArray;
+
+    // the deviation should at least be reduced by this ratio in every iteration
+    static constexpr double max_contraction = 0.9;
+
+    FastDecoupledPFSolver(YBus<sym> const& y_bus, std::shared_ptr<MathModelTopology const> const& topo_ptr)
+        : IterativePFSolver<sym, FastDecoupledPFSolver>{y_bus, topo_ptr},
+          theta_(y_bus.size()),
+          v_(y_bus.size()),
+          u_half_(y_bus.size()),
+          del_p_(y_bus.size()),
+          del_q_(y_bus.size()),
+          sparse_solver_{y_bus.shared_lu_symbolic()},
+          perm_(y_bus.size()) {}
+
+    SolverOutput<sym> run_power_flow(YBus<sym> const& y_bus, PowerFlowInput<sym> const& input, double err_tol,
+                                     Idx max_iter, CalculationInfo& calculation_info,
+                                     std::span<ComplexValue<sym> const> initial_u = {}) {
+        err_tol_ = err_tol;
+        return IterativePFSolver<sym, FastDecoupledPFSolver>::run_power_flow(y_bus, input, err_tol, max_iter,
+                                                                             calculation_info, initial_u);
+    }
+
+    // Factorize B' if the admittance changed
+    // with a warm start, output.u already contains the start voltage; otherwise use a flat start
+    void initialize_derived_solver(YBus<sym> const& y_bus, PowerFlowInput<sym> const& input, SolverOutput<sym>& output,
+                                   bool warm_start) {
+        if (!warm_start) {
+            this->make_flat_start(input, output.u);
+        }
+
+        // the admittance id also detects changes in copies of the y bus
+        if (!is_factorized_ || y_bus.admittance_id() != factorized_admittance_id_) {
+            is_factorized_ = false;
+            prepare_b_matrix(y_bus);
+            sparse_solver_.prefactorize(b_matrix_, perm_);
+            factorized_admittance_id_ = y_bus.admittance_id();
+            is_factorized_ = true;
+        }
+
+        for (Idx bus = 0; bus != this->n_bus_; ++bus) {
+            theta_[bus] = arg(output.u[bus]);
+            v_[bus] = cabs(output.u[bus]);
+        }
+        num_iter_ = 0;
+        previous_max_dev_ = std::numeric_limits<double>::infinity();
+    }
+
+    // Angle half iteration, and the mismatch for the magnitude half iteration at the updated angles
+    void prepare_matrix_and_rhs(YBus<sym> const& y_bus, PowerFlowInput<sym> const& input,
+                                ComplexValueVector<sym> const& u) {
+        calculate_mismatch(y_bus, input, u);
+        sparse_solver_.solve_with_prefactorized_matrix(b_matrix_, perm_, del_p_, del_p_);
+        for (Idx bus = 0; bus != this->n_bus_; ++bus) {
+            theta_[bus] += del_p_[bus];
+            u_half_[bus] = v_[bus] * exp(1.0i * theta_[bus]);
+        }
+        calculate_mismatch(y_bus, input, u_half_);
+    }
+
+    // Solve the magnitude increment, with the same factorization
+    void solve_matrix() { sparse_solver_.solve_with_prefactorized_matrix(b_matrix_, perm_, del_q_, del_q_); }
+
+    // Get maximum deviation among all bus voltages
+    double iterate_unknown(ComplexValueVector<sym>& u) {
+        double max_dev = 0.0;
+        for (Idx bus = 0; bus != this->n_bus_; ++bus) {
+            v_[bus] += del_q_[bus];
+            // U = V * exp(1i*theta)
+            ComplexValue<sym> const u_tmp = v_[bus] * exp(1.0i * theta_[bus]);
+            double const dev = max_val(cabs(u_tmp - u[bus]));
+            // a diverged (nan) voltage stalls the iteration
+            max_dev = std::isfinite(dev) ? std::max(dev, max_dev) : std::numeric_limits<double>::infinity();
+            u[bus] = u_tmp;
+        }
+        ++num_iter_;
+        // stalled iteration, the math solver falls back to Newton-Raphson
+        if (max_dev > err_tol_ && !(max_dev < max_contraction * previous_max_dev_)) {
+            throw IterationDiverge{num_iter_, max_dev, err_tol_};
+        }
+        previous_max_dev_ = max_dev;
+        return max_dev;
+    }
+
+    void set_lu_parallelism(SparseLUParallelism const& parallelism) { sparse_solver_.set_parallelism(parallelism); }
+
+  private:
+    // unknown in polar form
+    std::vector<RealValue<sym>> theta_;
+    std::vector<RealValue<sym>> v_;
+    // voltage after the angle half iteration
+    ComplexValueVector<sym> u_half_;
+    // power mismatch divided by the voltage magnitude, solved in place into the increments of theta and V
+    std::vector<RealValue<sym>> del_p_;
+    std::vector<RealValue<sym>> del_q_;
+
+    // factorized B'
+    std::vector<RealTensor<sym>> b_matrix_;
+    SparseSolverType sparse_solver_;
+    BlockPermArray perm_;
+    bool is_factorized_{false};
+    uint64_t factorized_admittance_id_{};
+    // detection of a stalled iteration
+    double err_tol_{};
+    Idx num_iter_{};
+    double previous_max_dev_{};
+
+    // B'ij = Im((u0_i @* conj(u0_j)) .* conj(Yij))
+    static RealTensor<sym> calculate_b(ComplexTensor<sym> const& yij, ComplexValue<sym> const& u0_i,
+                                       ComplexValue<sym> const& u0_j) {
+        return imag(vector_outer_product(u0_i, conj(u0_j)) * conj(yij));
+    }
+
+    void prepare_b_matrix(YBus<sym> const& y_bus) {
+        IdxVector const& indptr = y_bus.row_indptr_lu();
+        IdxVector const& indices = y_bus.col_indices_lu();
+        IdxVector const& map_lu_y_bus = y_bus.map_lu_y_bus();
+        IdxVector const& bus_entry = y_bus.lu_diag();
+        ComplexTensorVector<sym> const& ydata = y_bus.admittance();
+        DoubleVector const& phase_shift = *this->phase_shift_;
+
+        ComplexValueVector<sym> u0(this->n_bus_);
+        for (Idx bus = 0; bus != this->n_bus_; ++bus) {
+            u0[bus] = ComplexValue<sym>{std::exp(1.0i * phase_shift[bus])};
+        }
+
+        b_matrix_.resize(y_bus.nnz_lu());
+        for (Idx row = 0; row != this->n_bus_; ++row) {
+            for (Idx k = indptr[row]; k != indptr[row + 1]; ++k) {
+                // set to zero if it is a fill-in
+                Idx const k_y_bus = map_lu_y_bus[k];
+                b_matrix_[k] = k_y_bus == -1 ? RealTensor<sym>{} : calculate_b(ydata[k_y_bus], u0[row], u0[indices[k]]);
+            }
+        }
+        for (auto const& [bus_number, sources] : enumerated_zip_sequence(*this->sources_per_bus_)) {
+            for (Idx const source_number : sources) {
+                b_matrix_[bus_entry[bus_number]] +=
+                    calculate_b(y_bus.math_model_param().source_param[source_number].template y_ref<sym>(),
+                                u0[bus_number], u0[bus_number]);
+            }
+        }
+    }
+
+    // del_PQ = PQ_sp - PQ_cal, divided by the voltage magnitude
+    void calculate_mismatch(YBus<sym> const& y_bus, PowerFlowInput<sym> const& input,
+                            ComplexValueVector<sym> const& u) {
+        std::vector<LoadGenType> const& load_gen_type = *this->load_gen_type_;
+        for (auto const& [bus_number, load_gens, sources] :
+             enumerated_zip_sequence(*this->load_gens_per_bus_, *this->sources_per_bus_)) {
+            ComplexValue<sym> del_s = -y_bus.calculate_injection(u, bus_number);
+            add_loads(del_s, load_gens, bus_number, input, load_gen_type);
+            add_sources(del_s, sources, bus_number, y_bus, input, u);
+            del_p_[bus_number] = real(del_s) / v_[bus_number];
+            del_q_[bus_number] = imag(del_s) / v_[bus_number];
+        }
+    }
+
+    void add_loads(ComplexValue<sym>& del_s, IdxRange const& load_gens, Idx bus_number,
+                   PowerFlowInput<sym> const& input, std::vector<LoadGenType> const& load_gen_type) const {
+        using enum LoadGenType;
+        for (Idx const load_number : load_gens) {
+            LoadGenType const type = load_gen_type[load_number];
+            switch (type) {
+            case const_pq:
+                // S_sp = S_base
+                del_s += input.s_injection[load_number];
+                break;
+            case const_y:
+                // S_sp = S_base * V^2
+                del_s += input.s_injection[load_number] * v_[bus_number] * v_[bus_number];
+                break;
+            case const_i:
+                // S_sp = S_base * V
+                del_s += input.s_injection[load_number] * v_[bus_number];
+                break;
+            default:
+                throw MissingCaseForEnumError("Power mismatch calculation", type);
+            }
+        }
+    }
+
+    // the source injects S = U * conj(Y_ref * (U_ref - U))
+    static void add_sources(ComplexValue<sym>& del_s, IdxRange const& sources, Idx bus_number, YBus<sym> const& y_bus,
+                            PowerFlowInput<sym> const& input, ComplexValueVector<sym> const& u) {
+        for (Idx const source_number : sources) {
+            ComplexTensor<sym> const y_ref = y_bus.math_model_param().source_param[source_number].template y_ref<sym>();
+            ComplexValue<sym> const u_ref{input.source[source_number]};
+            del_s += u[bus_number] * conj(dot(y_ref, u_ref - u[bus_number]));
+        }
+    }
+};
+
+template class FastDecoupledPFSolver<symmetric_t>;
+template class FastDecoupledPFSolver<asymmetric_t>;
+
+} // namespace fast_decoupled_pf
+
+using fast_decoupled_pf::FastDecoupledPFSolver;
+
+} // namespace power_grid_model::math_solver
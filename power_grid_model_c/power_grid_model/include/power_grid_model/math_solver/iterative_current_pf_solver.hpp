@@ -17,6 +17,10 @@ Prefactorization:
     If the Y bus matrix does not change, then there is no need for factorizing it again to solve linear equations.
     Hence it is done only once in the first iteration and same result is used in subsequent iterations.
     Same factorization is also used in subsequent batches
+    If the parameters change, only the rows of the factorization which depend on the changed entries are factorized again
+    If the changed entries only span a few buses, e.g. a branch outage of a contingency that keeps the base topology,
+    and that is cheaper than the refactorization, the factorization is kept and the iterations are solved with a
+    low-rank update of it
 
 Steps:
     Initialize U with averaged u_ref, ie source voltage and phase shifts accounted
@@ -55,6 +59,7 @@ Nomenclature:
 #include "block_matrix.hpp"
 #include "common_solver_functions.hpp"
 #include "iterative_pf_solver.hpp"
+#include "sparse_lu_low_rank_update.hpp"
 #include "sparse_lu_solver.hpp"
 #include "y_bus.hpp"
 
@@ -64,6 +69,8 @@ Nomenclature:
 #include "../common/three_phase_tensor.hpp"
 #include "../common/timer.hpp"
 
+#include <utility>
+
 namespace power_grid_model::math_solver {
 
 // hide implementation in inside namespace
@@ -75,22 +82,47 @@ class IterativeCurrentPFSolver : public IterativePFSolver<sym, IterativeCurrentP
   public:
     using SparseSolverType = SparseLUSolver<ComplexTensor<sym>, ComplexValue<sym>, ComplexValue<sym>>;
     using BlockPermArray = typename SparseSolverType::BlockPermArray;
+    using LowRankUpdateType = SparseLULowRankUpdate<ComplexTensor<sym>, ComplexValue<sym>, ComplexValue<sym>>;
 
     IterativeCurrentPFSolver(YBus<sym> const& y_bus, std::shared_ptr<MathModelTopology const> const& topo_ptr)
         : IterativePFSolver<sym, IterativeCurrentPFSolver>{y_bus, topo_ptr},
           rhs_u_(y_bus.size()),
-          sparse_solver_{y_bus.shared_indptr_lu(), y_bus.shared_indices_lu(), y_bus.shared_diag_lu()} {}
+          sparse_solver_{y_bus.shared_lu_symbolic()} {}
+
+    SolverOutput<sym> run_power_flow(YBus<sym> const& y_bus, PowerFlowInput<sym> const& input, double err_tol,
+                                     Idx max_iter, CalculationInfo& calculation_info,
+                                     std::span<ComplexValue<sym> const> initial_u = {}) {
+        n_partial_refactorizations_ = 0;
+        n_low_rank_updates_ = 0;
+        // the number of solves of the previous calculation is the estimate for the cost of a low-rank update
+        n_previous_solves_ = std::exchange(n_solves_, 0);
+        SolverOutput<sym> output = IterativePFSolver<sym, IterativeCurrentPFSolver>::run_power_flow(
+            y_bus, input, err_tol, max_iter, calculation_info, initial_u);
+        if (n_partial_refactorizations_ != 0) {
+            calculation_info[Timer::make_key(2229, "Number of partial refactorizations")] +=
+                static_cast<double>(n_partial_refactorizations_);
+        }
+        if (n_low_rank_updates_ != 0) {
+            calculation_info[Timer::make_key(2235, "Number of low-rank updates")] +=
+                static_cast<double>(n_low_rank_updates_);
+        }
+        return output;
+    }
 
     // Add source admittance to Y bus and set variable for prepared y bus to true
-    void initialize_derived_solver(YBus<sym> const& y_bus, PowerFlowInput<sym> const& input,
-                                   SolverOutput<sym>& output) {
-        make_flat_start(input, output.u);
+    // with a warm start, output.u already contains the start voltage; otherwise use a flat start
+    void initialize_derived_solver(YBus<sym> const& y_bus, PowerFlowInput<sym> const& input, SolverOutput<sym>& output,
+                                   bool warm_start) {
+        if (!warm_start) {
+            this->make_flat_start(input, output.u);
+        }
 
         auto const& sources_per_bus = *this->sources_per_bus_;
         IdxVector const& bus_entry = y_bus.lu_diag();
         // if Y bus is not up to date
         // re-build matrix and prefactorize Build y bus data with source admittance
-        if (parameters_changed_) {
+        // the admittance id also detects changes in copies of the y bus
+        if (mat_data_ == nullptr || y_bus.admittance_id() != factorized_admittance_id_) {
             ComplexTensorVector<sym> mat_data(y_bus.nnz_lu());
             detail::copy_y_bus<sym>(y_bus, mat_data);
 
@@ -103,13 +135,34 @@ class IterativeCurrentPFSolver : public IterativePFSolver<sym, IterativeCurrentP
                 }
             }
             // prefactorize
-            BlockPermArray perm(this->n_bus_);
-            sparse_solver_.prefactorize(mat_data, perm);
+            // or, if there is a previous factorization, use a low-rank update of it if only a few buses changed
+            // otherwise only refactorize the rows depending on the changed entries
+            low_rank_update_.reset();
+            ComplexTensorVector<sym> lu_data;
+            BlockPermArray perm{};
+            if (mat_data_ == nullptr) {
+                lu_data = mat_data;
+                perm = BlockPermArray(this->n_bus_);
+                sparse_solver_.prefactorize(lu_data, perm);
+            } else {
+                // the factorized matrix itself is kept if it did not change, e.g. the base case after a contingency
+                IdxVector const changed = detail::changed_entries<sym>(mat_data, factorized_mat_data_);
+                if (changed.empty() || set_low_rank_update(y_bus, mat_data, changed)) {
+                    factorized_admittance_id_ = y_bus.admittance_id();
+                    return;
+                }
+                lu_data = *mat_data_;
+                perm = *perm_;
+                if (sparse_solver_.refactorize(mat_data, lu_data, perm, changed)) {
+                    ++n_partial_refactorizations_;
+                }
+            }
             // move pre-factorized version into shared ptr
-            mat_data_ = std::make_shared<ComplexTensorVector<sym> const>(std::move(mat_data));
+            factorized_mat_data_ = std::move(mat_data);
+            mat_data_ = std::make_shared<ComplexTensorVector<sym> const>(std::move(lu_data));
             perm_ = std::make_shared<BlockPermArray const>(std::move(perm));
+            factorized_admittance_id_ = y_bus.admittance_id();
         }
-        parameters_changed_ = false;
     }
 
     // Prepare matrix calculates injected current ie. RHS of solver for each iteration.
@@ -130,7 +183,14 @@ class IterativeCurrentPFSolver : public IterativePFSolver<sym, IterativeCurrentP
 
     // Solve the linear equations I_inj = YU
     // inplace
-    void solve_matrix() { sparse_solver_.solve_with_prefactorized_matrix(*mat_data_, *perm_, rhs_u_, rhs_u_); }
+    void solve_matrix() {
+        ++n_solves_;
+        if (low_rank_update_) {
+            low_rank_update_->solve(sparse_solver_, *mat_data_, *perm_, rhs_u_, rhs_u_);
+        } else {
+            sparse_solver_.solve_with_prefactorized_matrix(*mat_data_, *perm_, rhs_u_, rhs_u_);
+        }
+    }
 
     // Find maximum deviation in voltage among all buses
     double iterate_unknown(ComplexValueVector<sym>& u) {
@@ -147,15 +207,41 @@ class IterativeCurrentPFSolver : public IterativePFSolver<sym, IterativeCurrentP
         return max_dev;
     }
 
-    void parameters_changed(bool changed) { parameters_changed_ = parameters_changed_ || changed; }
+    void set_lu_parallelism(SparseLUParallelism const& parallelism) { sparse_solver_.set_parallelism(parallelism); }
 
   private:
     ComplexValueVector<sym> rhs_u_;
     std::shared_ptr<ComplexTensorVector<sym> const> mat_data_;
+    // matrix of the last factorization, before factorization
+    ComplexTensorVector<sym> factorized_mat_data_;
+    Idx n_partial_refactorizations_{};
+    Idx n_low_rank_updates_{};
+    Idx n_solves_{};
+    Idx n_previous_solves_{};
+    uint64_t factorized_admittance_id_{};
     // sparse solver
     SparseSolverType sparse_solver_;
     std::shared_ptr<BlockPermArray const> perm_;
-    bool parameters_changed_ = true;
+    // modification of the factorized matrix, if the matrix only changed for a few buses since the factorization
+    std::optional<LowRankUpdateType> low_rank_update_;
+
+    bool set_low_rank_update(YBus<sym> const& y_bus, ComplexTensorVector<sym> const& mat_data,
+                             IdxVector const& changed) {
+        auto const modification = detail::low_rank_modification<sym>(y_bus, mat_data, factorized_mat_data_, changed);
+        if (!modification ||
+            !LowRankUpdateType::is_cheaper_than_refactorization(sparse_solver_, changed,
+                                                                static_cast<Idx>(modification->buses.size()),
+                                                                std::max(n_previous_solves_, Idx{1}))) {
+            return false;
+        }
+        low_rank_update_.emplace(sparse_solver_, *mat_data_, *perm_, modification->buses, modification->delta);
+        if (low_rank_update_->is_singular()) {
+            low_rank_update_.reset();
+            return false;
+        }
+        ++n_low_rank_updates_;
+        return true;
+    }
 
     void add_loads(boost::iterator_range<IdxCount> const& load_gens, Idx bus_number, PowerFlowInput<sym> const& input,
                    std::vector<LoadGenType> const& load_gen_type, ComplexValueVector<sym> const& u) {
@@ -191,26 +277,6 @@ class IterativeCurrentPFSolver : public IterativePFSolver<sym, IterativeCurrentP
                                       ComplexValue<sym>{input.source[source_number]});
         }
     }
-
-    void make_flat_start(PowerFlowInput<sym> const& input, ComplexValueVector<sym>& output_u) {
-        std::vector<double> const& phase_shift = *this->phase_shift_;
-        // average u_ref of all sources
-        DoubleComplex const u_ref = [&]() {
-            DoubleComplex sum_u_ref = 0.0;
-            for (auto const& [bus, sources] : enumerated_zip_sequence(*this->sources_per_bus_)) {
-                for (Idx const source : sources) {
-                    sum_u_ref += input.source[source] * std::exp(1.0i * -phase_shift[bus]); // offset phase shift
-                }
-            }
-            return sum_u_ref / static_cast<double>(input.source.size());
-        }();
-
-        // assign u_ref as flat start
-        for (Idx i = 0; i != this->n_bus_; ++i) {
-            // consider phase shift
-            output_u[i] = ComplexValue<sym>{u_ref * std::exp(1.0i * phase_shift[i])};
-        }
-    }
 };
 
 template class IterativeCurrentPFSolver<symmetric_t>;
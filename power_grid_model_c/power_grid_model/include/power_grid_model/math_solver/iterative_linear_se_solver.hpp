@@ -10,6 +10,7 @@
 #include "common_solver_functions.hpp"
 #include "measured_values.hpp"
 #include "observability.hpp"
+#include "sparse_lu_mixed_precision.hpp"
 #include "sparse_lu_solver.hpp"
 #include "y_bus.hpp"
 
@@ -19,6 +20,9 @@
 #include "../common/three_phase_tensor.hpp"
 #include "../common/timer.hpp"
 
+#include <optional>
+#include <utility>
+
 namespace power_grid_model::math_solver {
 
 // hide implementation in inside namespace
@@ -66,13 +70,23 @@ template <symmetry_tag sym> class IterativeLinearSESolver {
     static constexpr Idx bsr_block_size_ = is_symmetric_v<sym> ? 2 : 6;
 
   public:
-    IterativeLinearSESolver(YBus<sym> const& y_bus, std::shared_ptr<MathModelTopology const> topo_ptr)
+    using MixedPrecisionSolverType = SparseLUMixedPrecisionSolver<ILSEGainBlock<sym>, ILSERhs<sym>, ILSEUnknown<sym>>;
+
+    // with mixed_precision, the gain matrix is factorized in single precision, see SparseLUMixedPrecisionSolver
+    // the gain matrix is factorized once per calculation and solved in every iteration
+    IterativeLinearSESolver(YBus<sym> const& y_bus, std::shared_ptr<MathModelTopology const> topo_ptr,
+                            bool mixed_precision = false)
         : n_bus_{y_bus.size()},
           math_topo_{std::move(topo_ptr)},
           data_gain_(y_bus.nnz_lu()),
           x_rhs_(y_bus.size()),
-          sparse_solver_{y_bus.shared_indptr_lu(), y_bus.shared_indices_lu(), y_bus.shared_diag_lu()},
-          perm_(y_bus.size()) {}
+          sparse_solver_{y_bus.shared_lu_symbolic()},
+          perm_(y_bus.size()) {
+        if (mixed_precision) {
+            mixed_precision_solver_.emplace(y_bus.shared_lu_symbolic());
+            x_mixed_precision_.resize(y_bus.size());
+        }
+    }
 
     SolverOutput<sym> run_state_estimation(YBus<sym> const& y_bus, StateEstimationInput<sym> const& input,
                                            double err_tol, Idx max_iter, CalculationInfo& calculation_info) {
@@ -112,7 +126,7 @@ template <symmetry_tag sym> class IterativeLinearSESolver {
             prepare_rhs(y_bus, measured_values, output.u);
             // solve with prefactorization
             sub_timer = Timer(calculation_info, 2225, "Solve sparse linear equation (pre-factorized)");
-            sparse_solver_.solve_with_prefactorized_matrix(data_gain_, perm_, x_rhs_, x_rhs_);
+            solve_matrix();
             sub_timer = Timer(calculation_info, 2226, "Iterate unknown");
             max_dev = iterate_unknown(output.u, measured_values.has_angle());
         };
@@ -127,10 +141,20 @@ template <symmetry_tag sym> class IterativeLinearSESolver {
 
         auto const key = Timer::make_key(2228, "Max number of iterations");
         calculation_info[key] = std::max(calculation_info[key], static_cast<double>(num_iter));
+        if (mixed_precision_solver_.has_value() && mixed_precision_solver_->is_double_precision()) {
+            calculation_info[Timer::make_key(2236, "Number of fallbacks to double precision")] += 1.0;
+        }
 
         return output;
     }
 
+    void set_lu_parallelism(SparseLUParallelism const& parallelism) {
+        sparse_solver_.set_parallelism(parallelism);
+        if (mixed_precision_solver_.has_value()) {
+            mixed_precision_solver_->set_parallelism(parallelism);
+        }
+    }
+
   private:
     // array selection function pointer
     static constexpr std::array has_branch_{&MeasuredValues<sym>::has_branch_from, &MeasuredValues<sym>::has_branch_to};
@@ -148,6 +172,9 @@ template <symmetry_tag sym> class IterativeLinearSESolver {
     // solver
     SparseLUSolver<ILSEGainBlock<sym>, ILSERhs<sym>, ILSEUnknown<sym>> sparse_solver_;
     typename SparseLUSolver<ILSEGainBlock<sym>, ILSERhs<sym>, ILSEUnknown<sym>>::BlockPermArray perm_;
+    // mixed precision solver, the gain matrix is not changed by its factorization
+    std::optional<MixedPrecisionSolverType> mixed_precision_solver_;
+    std::vector<ILSEUnknown<sym>> x_mixed_precision_;
 
     static auto diagonal_inverse(RealValue<sym> const& value) {
         return ComplexDiagonalTensor<sym>{static_cast<ComplexValue<sym>>(RealValue<sym>{1.0} / value)};
@@ -247,7 +274,21 @@ template <symmetry_tag sym> class IterativeLinearSESolver {
             data_gain_[data_idx_lu].qh() = hermitian_transpose(data_gain_[data_idx_tranpose].q());
         }
         // prefactorize
-        sparse_solver_.prefactorize(data_gain_, perm_);
+        if (mixed_precision_solver_.has_value()) {
+            mixed_precision_solver_->prefactorize(data_gain_);
+        } else {
+            sparse_solver_.prefactorize(data_gain_, perm_);
+        }
+    }
+
+    // solve the rhs in place
+    void solve_matrix() {
+        if (mixed_precision_solver_.has_value()) {
+            mixed_precision_solver_->solve_with_prefactorized_matrix(x_rhs_, x_mixed_precision_);
+            std::swap(x_rhs_, x_mixed_precision_);
+        } else {
+            sparse_solver_.solve_with_prefactorized_matrix(data_gain_, perm_, x_rhs_, x_rhs_);
+        }
     }
 
     void prepare_rhs(YBus<sym> const& y_bus, MeasuredValues<sym> const& measured_value,
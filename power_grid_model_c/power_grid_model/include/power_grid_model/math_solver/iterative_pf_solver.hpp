@@ -18,16 +18,22 @@
 #include "../common/three_phase_tensor.hpp"
 #include "../common/timer.hpp"
 
+#include <algorithm>
+#include <span>
+
 namespace power_grid_model::math_solver {
 
 // solver
 template <symmetry_tag sym, typename DerivedSolver> class IterativePFSolver {
   public:
     friend DerivedSolver;
+    // initial_u: start voltage of the iteration, e.g. the solution of a previous calculation
+    //     if it is empty or does not match the number of buses, the solver uses its own initialization
     SolverOutput<sym> run_power_flow(YBus<sym> const& y_bus, PowerFlowInput<sym> const& input, double err_tol,
-                                     Idx max_iter, CalculationInfo& calculation_info) {
-        // get derived reference for derived solver class
-        auto derived_solver = static_cast<DerivedSolver&>(*this);
+                                     Idx max_iter, CalculationInfo& calculation_info,
+                                     std::span<ComplexValue<sym> const> initial_u = {}) {
+        // get derived reference for derived solver class, the derived solver keeps its cached data between runs
+        auto& derived_solver = static_cast<DerivedSolver&>(*this);
 
         // prepare
         SolverOutput<sym> output;
@@ -39,8 +45,12 @@ template <symmetry_tag sym, typename DerivedSolver> class IterativePFSolver {
         // initialize
         {
             Timer const sub_timer{calculation_info, 2221, "Initialize calculation"};
+            bool const warm_start = static_cast<Idx>(initial_u.size()) == n_bus_;
+            if (warm_start) {
+                std::ranges::copy(initial_u, output.u.begin());
+            }
             // Further initialization specific to the derived solver
-            derived_solver.initialize_derived_solver(y_bus, input, output);
+            derived_solver.initialize_derived_solver(y_bus, input, output, warm_start);
         }
 
         // start calculation
@@ -98,6 +108,27 @@ template <symmetry_tag sym, typename DerivedSolver> class IterativePFSolver {
           load_gens_per_bus_{topo_ptr, &topo_ptr->load_gens_per_bus},
           sources_per_bus_{topo_ptr, &topo_ptr->sources_per_bus},
           load_gen_type_{topo_ptr, &topo_ptr->load_gen_type} {}
+
+    // flat start for the derived solvers, used without a warm start
+    void make_flat_start(PowerFlowInput<sym> const& input, ComplexValueVector<sym>& output_u) {
+        DoubleVector const& phase_shift = *this->phase_shift_;
+        // average u_ref of all sources
+        DoubleComplex const u_ref = [&]() {
+            DoubleComplex sum_u_ref = 0.0;
+            for (auto const& [bus, sources] : enumerated_zip_sequence(*this->sources_per_bus_)) {
+                for (Idx const source : sources) {
+                    sum_u_ref += input.source[source] * std::exp(1.0i * -phase_shift[bus]); // offset phase shift
+                }
+            }
+            return sum_u_ref / static_cast<double>(input.source.size());
+        }();
+
+        // assign u_ref as flat start
+        for (Idx i = 0; i != this->n_bus_; ++i) {
+            // consider phase shift
+            output_u[i] = ComplexValue<sym>{u_ref * std::exp(1.0i * phase_shift[i])};
+        }
+    }
 };
 
 } // namespace power_grid_model::math_solver
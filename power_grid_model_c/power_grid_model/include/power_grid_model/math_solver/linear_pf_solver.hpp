@@ -26,9 +26,28 @@ if there are sources
     YBus_diag_i += sum{j as source} (Y_source_j)
     rhs_i +=  sum{j as source} (Y_source_j * U_ref_j)
 
+Factorization re-use
+    the matrix only depends on the parameters, the load/gen injections and the source admittances
+    if the matrix is the same as in the previous calculation, e.g. consecutive batch scenarios that only change the
+    source voltage, the previous factorization is re-used and only the forward/backward substitution is done
+    if only some entries changed, e.g. a single load or tap position, only the rows of the factorization that depend
+    on the changed entries are factorized again
+    if the changed entries only span the rows and columns of a few buses, e.g. a branch outage of a contingency that
+    keeps the base topology, and the refactorization is expensive, e.g. for rows close to the root of the
+    elimination tree, the system is solved with a low-rank update of the previous factorization instead
+    the previous factorization is then kept, so restoring the base case does not need a refactorization either
+
+Krylov solver for very large math models
+    the fill-ins of the LU factorization get prohibitive in memory for very large grids
+    math models with at least SparseKrylovSettings::min_size buses are solved iteratively with SparseKrylovSolver,
+    on the sparsity pattern of the y bus without fill-ins
+    the number of iterations and the memory of the linear solver are reported in the calculation info
+
 */
 
 #include "common_solver_functions.hpp"
+#include "sparse_krylov_solver.hpp"
+#include "sparse_lu_low_rank_update.hpp"
 #include "sparse_lu_solver.hpp"
 #include "y_bus.hpp"
 
@@ -38,6 +57,10 @@ if there are sources
 #include "../common/three_phase_tensor.hpp"
 #include "../common/timer.hpp"
 
+#include <algorithm>
+#include <optional>
+
+
 namespace power_grid_model::math_solver {
 
 namespace linear_pf {
@@ -48,14 +71,28 @@ template <symmetry_tag sym> class LinearPFSolver {
     using SparseSolverType = SparseLUSolver<ComplexTensor<sym>, ComplexValue<sym>, ComplexValue<sym>>;
     using BlockPermArray =
         typename SparseLUSolver<ComplexTensor<sym>, ComplexValue<sym>, ComplexValue<sym>>::BlockPermArray;
+    using KrylovSolverType = SparseKrylovSolver<ComplexTensor<sym>, ComplexValue<sym>, ComplexValue<sym>>;
+    using LowRankUpdateType = SparseLULowRankUpdate<ComplexTensor<sym>, ComplexValue<sym>, ComplexValue<sym>>;
 
-    LinearPFSolver(YBus<sym> const& y_bus, std::shared_ptr<MathModelTopology const> const& topo_ptr)
+    LinearPFSolver(YBus<sym> const& y_bus, std::shared_ptr<MathModelTopology const> const& topo_ptr,
+                   SparseKrylovSettings const& krylov_settings = {})
         : n_bus_{y_bus.size()},
           load_gens_per_bus_{topo_ptr, &topo_ptr->load_gens_per_bus},
           sources_per_bus_{topo_ptr, &topo_ptr->sources_per_bus},
-          mat_data_(y_bus.nnz_lu()),
-          sparse_solver_{y_bus.shared_indptr_lu(), y_bus.shared_indices_lu(), y_bus.shared_diag_lu()},
-          perm_(n_bus_) {}
+          use_krylov_{n_bus_ >= krylov_settings.min_size},
+          mat_data_(use_krylov_ ? y_bus.nnz() : y_bus.nnz_lu()),
+          factorized_mat_data_(mat_data_.size()),
+          lu_mat_data_(use_krylov_ ? 0 : y_bus.nnz_lu()),
+          perm_(use_krylov_ ? 0 : n_bus_) {
+        // the symbolic LU factorization of the y bus is only calculated for the LU solver
+        if (use_krylov_) {
+            krylov_solver_.emplace(y_bus.shared_indptr(), y_bus.shared_indices(),
+                                   std::shared_ptr<IdxVector const>{y_bus.shared_y_bus_struct(), &y_bus.bus_entry()},
+                                   krylov_settings);
+        } else {
+            sparse_solver_.emplace(y_bus.shared_lu_symbolic());
+        }
+    }
 
     SolverOutput<sym> run_power_flow(YBus<sym> const& y_bus, PowerFlowInput<sym> const& input,
                                      CalculationInfo& calculation_info) {
@@ -65,6 +102,10 @@ template <symmetry_tag sym> class LinearPFSolver {
 
         Timer const main_timer(calculation_info, 2220, "Math solver");
 
+        if (use_krylov_) {
+            return run_power_flow_krylov(y_bus, input, calculation_info);
+        }
+
         // prepare matrix
         Timer sub_timer(calculation_info, 2221, "Prepare matrix");
         detail::copy_y_bus<sym>(y_bus, mat_data_);
@@ -73,7 +114,25 @@ template <symmetry_tag sym> class LinearPFSolver {
         // solve
         // u vector will have I_injection for slack bus for now
         sub_timer = Timer(calculation_info, 2222, "Solve sparse linear equation");
-        sparse_solver_.prefactorize_and_solve(mat_data_, perm_, output.u, output.u);
+        bool is_solved = false;
+        if (!is_factorized_) {
+            factorized_mat_data_ = mat_data_;
+            lu_mat_data_ = mat_data_;
+            sparse_solver_->prefactorize(lu_mat_data_, perm_);
+            is_factorized_ = true;
+        } else if (IdxVector const changed = detail::changed_entries<sym>(mat_data_, factorized_mat_data_);
+                   !changed.empty()) {
+            is_solved = solve_with_low_rank_update(y_bus, changed, output, calculation_info);
+            if (!is_solved) {
+                is_factorized_ = false;
+                sparse_solver_->refactorize(mat_data_, lu_mat_data_, perm_, changed);
+                factorized_mat_data_ = mat_data_;
+                is_factorized_ = true;
+            }
+        }
+        if (!is_solved) {
+            sparse_solver_->solve_with_prefactorized_matrix(lu_mat_data_, perm_, output.u, output.u);
+        }
 
         // calculate math result
         sub_timer = Timer(calculation_info, 2223, "Calculate math result");
@@ -83,16 +142,85 @@ template <symmetry_tag sym> class LinearPFSolver {
         return output;
     }
 
+    void set_lu_parallelism(SparseLUParallelism const& parallelism) {
+        if (sparse_solver_) {
+            sparse_solver_->set_parallelism(parallelism);
+        }
+    }
+
+    bool use_krylov() const { return use_krylov_; }
+
   private:
     Idx n_bus_;
     // shared topo data
     std::shared_ptr<SparseGroupedIdxVector const> load_gens_per_bus_;
     std::shared_ptr<DenseGroupedIdxVector const> sources_per_bus_;
-    // sparse linear equation
+    // solve with the Krylov solver on the y bus pattern, instead of the LU factorization
+    bool use_krylov_;
+    // sparse linear equation, on the LU pattern or on the y bus pattern for the Krylov solver
     ComplexTensorVector<sym> mat_data_;
-    // sparse solver
-    SparseSolverType sparse_solver_;
+    // matrix of the last factorization, before and after factorization
+    ComplexTensorVector<sym> factorized_mat_data_;
+    ComplexTensorVector<sym> lu_mat_data_;
+    bool is_factorized_{false};
+    // sparse solver, only for the LU factorization
+    std::optional<SparseSolverType> sparse_solver_;
     BlockPermArray perm_;
+    std::optional<KrylovSolverType> krylov_solver_;
+
+    SolverOutput<sym> run_power_flow_krylov(YBus<sym> const& y_bus, PowerFlowInput<sym> const& input,
+                                            CalculationInfo& calculation_info) {
+        SolverOutput<sym> output;
+        output.u.resize(n_bus_);
+
+        // prepare matrix on the y bus pattern
+        Timer sub_timer(calculation_info, 2221, "Prepare matrix");
+        mat_data_ = y_bus.admittance();
+        detail::prepare_linear_matrix_and_rhs(y_bus, input, *load_gens_per_bus_, *sources_per_bus_, output, mat_data_,
+                                              y_bus.bus_entry());
+
+        // the preconditioner is only calculated again if the matrix changed
+        sub_timer = Timer(calculation_info, 2222, "Solve sparse linear equation");
+        if (!is_factorized_ || !detail::changed_entries<sym>(mat_data_, factorized_mat_data_).empty()) {
+            is_factorized_ = false;
+            krylov_solver_->prefactorize(mat_data_);
+            factorized_mat_data_ = mat_data_;
+            is_factorized_ = true;
+        }
+        Idx const n_iter = krylov_solver_->solve_with_prefactorized_matrix(mat_data_, output.u, output.u);
+
+        sub_timer = Timer(calculation_info, 2223, "Calculate math result");
+        calculate_result(y_bus, input, output);
+        sub_timer.stop();
+
+        // the matrix and the matrix of the last factorization are included in the memory
+        auto const memory = static_cast<double>(krylov_solver_->memory_usage() +
+                                                (mat_data_.capacity() + factorized_mat_data_.capacity()) *
+                                                    sizeof(ComplexTensor<sym>));
+        auto const iter_key = Timer::make_key(2230, "Max number of linear solver iterations");
+        calculation_info[iter_key] = std::max(calculation_info[iter_key], static_cast<double>(n_iter));
+        auto const memory_key = Timer::make_key(2231, "Max linear solver memory (bytes)");
+        calculation_info[memory_key] = std::max(calculation_info[memory_key], memory);
+        return output;
+    }
+
+    // solve the modified matrix with the factorization of the previous matrix, if it only changed for a few buses
+    bool solve_with_low_rank_update(YBus<sym> const& y_bus, IdxVector const& changed, SolverOutput<sym>& output,
+                                    CalculationInfo& calculation_info) {
+        auto const modification = detail::low_rank_modification<sym>(y_bus, mat_data_, factorized_mat_data_, changed);
+        if (!modification || !LowRankUpdateType::is_cheaper_than_refactorization(
+                                 *sparse_solver_, changed, static_cast<Idx>(modification->buses.size()), 1)) {
+            return false;
+        }
+        LowRankUpdateType const update{*sparse_solver_, lu_mat_data_, perm_, modification->buses,
+                                       modification->delta};
+        if (update.is_singular()) {
+            return false;
+        }
+        update.solve(*sparse_solver_, lu_mat_data_, perm_, output.u, output.u);
+        calculation_info[Timer::make_key(2235, "Number of low-rank updates")] += 1.0;
+        return true;
+    }
 
     void prepare_matrix_and_rhs(YBus<sym> const& y_bus, PowerFlowInput<sym> const& input, SolverOutput<sym>& output) {
         detail::prepare_linear_matrix_and_rhs(y_bus, input, *load_gens_per_bus_, *sources_per_bus_, output, mat_data_);
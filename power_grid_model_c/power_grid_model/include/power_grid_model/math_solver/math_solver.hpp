@@ -4,11 +4,14 @@
 
 #pragma once
 
+#include "dc_pf_solver.hpp"
+#include "fast_decoupled_pf_solver.hpp"
 #include "iterative_current_pf_solver.hpp"
 #include "iterative_linear_se_solver.hpp"
 #include "linear_pf_solver.hpp"
 #include "newton_raphson_pf_solver.hpp"
 #include "newton_raphson_se_solver.hpp"
+#include "radial_sweep_pf_solver.hpp"
 #include "short_circuit_solver.hpp"
 #include "y_bus.hpp"
 
@@ -19,6 +22,7 @@
 #include "../common/timer.hpp"
 
 #include <optional>
+#include <span>
 
 namespace power_grid_model {
 
@@ -29,30 +33,50 @@ template <symmetry_tag sym> class MathSolver {
     explicit MathSolver(std::shared_ptr<MathModelTopology const> const& topo_ptr)
         : topo_ptr_{topo_ptr},
           all_const_y_{std::all_of(topo_ptr->load_gen_type.cbegin(), topo_ptr->load_gen_type.cend(),
-                                   [](LoadGenType x) { return x == LoadGenType::const_y; })} {}
+                                   [](LoadGenType x) { return x == LoadGenType::const_y; })},
+          radial_{RadialSweepPFSolver<sym>::is_radial(*topo_ptr)} {}
 
     SolverOutput<sym> run_power_flow(PowerFlowInput<sym> const& input, double err_tol, Idx max_iter,
                                      CalculationInfo& calculation_info, CalculationMethod calculation_method,
-                                     YBus<sym> const& y_bus) {
+                                     YBus<sym> const& y_bus,
+                                     InitializationStrategy initialization_strategy =
+                                         InitializationStrategy::default_initialization) {
         using enum CalculationMethod;
 
-        // set method to always linear if all load_gens have const_y
-        calculation_method = all_const_y_ ? linear : calculation_method;
+        // set method to always linear if all load_gens have const_y, except for the approximate dc method
+        calculation_method = all_const_y_ && calculation_method != dc ? linear : calculation_method;
 
-        switch (calculation_method) {
-        case default_method:
-            [[fallthrough]]; // use Newton-Raphson by default
-        case newton_raphson:
-            return run_power_flow_newton_raphson(input, err_tol, max_iter, calculation_info, y_bus);
-        case linear:
-            return run_power_flow_linear(input, err_tol, max_iter, calculation_info, y_bus);
-        case linear_current:
-            return run_power_flow_linear_current(input, err_tol, max_iter, calculation_info, y_bus);
-        case iterative_current:
-            return run_power_flow_iterative_current(input, err_tol, max_iter, calculation_info, y_bus);
-        default:
-            throw InvalidCalculationMethod{};
+        // the solvers are re-created when the topology changes, so the previous solution always matches the buses
+        bool const use_previous_solution = initialization_strategy == InitializationStrategy::previous_solution;
+        std::span<ComplexValue<sym> const> const initial_u =
+            use_previous_solution ? std::span<ComplexValue<sym> const>{previous_u_} : std::span<ComplexValue<sym> const>{};
+
+        SolverOutput<sym> output = [&] {
+            switch (calculation_method) {
+            case default_method:
+                [[fallthrough]]; // use Newton-Raphson by default
+            case newton_raphson:
+                return run_power_flow_newton_raphson(input, err_tol, max_iter, calculation_info, y_bus, initial_u);
+            case linear:
+                return run_power_flow_linear(input, err_tol, max_iter, calculation_info, y_bus);
+            case linear_current:
+                return run_power_flow_linear_current(input, err_tol, max_iter, calculation_info, y_bus);
+            case iterative_current:
+                return run_power_flow_iterative_current(input, err_tol, max_iter, calculation_info, y_bus, initial_u);
+            case fast_decoupled:
+                return run_power_flow_fast_decoupled(input, err_tol, max_iter, calculation_info, y_bus, initial_u);
+            case dc:
+                return run_power_flow_dc(input, calculation_info, y_bus);
+            default:
+                throw InvalidCalculationMethod{};
+            }
+        }();
+
+        // only keep the converged solution
+        if (use_previous_solution) {
+            previous_u_ = output.u;
         }
+        return output;
     }
 
     SolverOutput<sym> run_state_estimation(StateEstimationInput<sym> const& input, double err_tol, Idx max_iter,
@@ -83,6 +107,7 @@ template <symmetry_tag sym> class MathSolver {
         if (!iec60909_sc_solver_.has_value()) {
             Timer const timer(calculation_info, 2210, "Create math solver");
             iec60909_sc_solver_.emplace(y_bus, topo_ptr_);
+            iec60909_sc_solver_->set_lu_parallelism(lu_parallelism_);
         }
 
         // call calculation
@@ -93,50 +118,185 @@ template <symmetry_tag sym> class MathSolver {
         newton_raphson_pf_solver_.reset();
         linear_pf_solver_.reset();
         iterative_current_pf_solver_.reset();
+        radial_sweep_pf_solver_.reset();
+        fast_decoupled_pf_solver_.reset();
+        dc_pf_solver_.reset();
         iterative_linear_se_solver_.reset();
+        previous_u_.clear();
+    }
+
+    // threads for the sparse LU factorization and solves of the solvers, see SparseLUParallelism
+    void set_lu_parallelism(SparseLUParallelism const& parallelism) {
+        lu_parallelism_ = parallelism;
+        auto const set_parallelism = [&parallelism](auto& solver) {
+            if (solver.has_value()) {
+                solver->set_lu_parallelism(parallelism);
+            }
+        };
+        set_parallelism(newton_raphson_pf_solver_);
+        set_parallelism(linear_pf_solver_);
+        set_parallelism(iterative_current_pf_solver_);
+        set_parallelism(fast_decoupled_pf_solver_);
+        set_parallelism(dc_pf_solver_);
+        set_parallelism(iterative_linear_se_solver_);
+        set_parallelism(newton_raphson_se_solver_);
+        set_parallelism(iec60909_sc_solver_);
+    }
+
+    // PTDF of the dc power flow, see DCPFSolver::calculate_ptdf
+    std::vector<RealTensor<sym>> calculate_dc_ptdf(std::span<Idx const> branches, std::span<Idx const> buses,
+                                                   CalculationInfo& calculation_info, YBus<sym> const& y_bus) {
+        auto& solver = get_dc_pf_solver(calculation_info, y_bus);
+        Timer const timer(calculation_info, 2220, "Math solver");
+        return solver.calculate_ptdf(y_bus, branches, buses);
+    }
+
+    // sensitivities of the last converged Newton-Raphson power flow, see NewtonRaphsonPFSolver::calculate_sensitivity
+    PowerFlowSensitivity<sym> calculate_power_flow_sensitivity(std::span<Idx const> injection_buses,
+                                                               std::span<Idx const> buses,
+                                                               std::span<Idx const> branches,
+                                                               CalculationInfo& calculation_info,
+                                                               YBus<sym> const& y_bus) {
+        auto& solver = get_calculated_newton_raphson_pf_solver();
+        Timer const timer(calculation_info, 2220, "Math solver");
+        return solver.calculate_sensitivity(y_bus, injection_buses, buses, branches);
+    }
+
+    // line outage distribution factors of the last converged Newton-Raphson power flow,
+    // see NewtonRaphsonPFSolver::calculate_lodf
+    std::vector<RealTensor<sym>> calculate_lodf(std::span<Idx const> branches, std::span<Idx const> outage_branches,
+                                                CalculationInfo& calculation_info, YBus<sym> const& y_bus) {
+        auto& solver = get_calculated_newton_raphson_pf_solver();
+        Timer const timer(calculation_info, 2220, "Math solver");
+        return solver.calculate_lodf(y_bus, branches, outage_branches);
     }
 
-    void parameters_changed(bool changed) {
-        if (iterative_current_pf_solver_.has_value()) {
-            iterative_current_pf_solver_->parameters_changed(changed);
+    // selection of the Krylov solver for very large math models, see SparseKrylovSettings
+    void set_krylov_settings(SparseKrylovSettings const& settings) {
+        krylov_settings_ = settings;
+        linear_pf_solver_.reset();
+    }
+
+    // single precision factorization of the gain matrix in the iterative linear state estimation,
+    // see IterativeLinearSESolver
+    void set_se_mixed_precision(bool se_mixed_precision) {
+        if (se_mixed_precision == se_mixed_precision_) {
+            return;
         }
+        se_mixed_precision_ = se_mixed_precision;
+        iterative_linear_se_solver_.reset();
+    }
+
+    // re-use of the factorized jacobian in the Newton-Raphson power flow, see JacobianReuseSettings
+    // the factorization of the solver is kept if the settings do not change
+    void set_jacobian_reuse_settings(JacobianReuseSettings const& settings) {
+        if (settings == jacobian_reuse_settings_) {
+            return;
+        }
+        jacobian_reuse_settings_ = settings;
+        newton_raphson_pf_solver_.reset();
     }
 
   private:
     std::shared_ptr<MathModelTopology const> topo_ptr_;
     bool all_const_y_; // if all the load_gen is const element_admittance (impedance) type
+    bool radial_;      // if the math model is radial, see RadialSweepPFSolver
     std::optional<NewtonRaphsonPFSolver<sym>> newton_raphson_pf_solver_;
     std::optional<LinearPFSolver<sym>> linear_pf_solver_;
     std::optional<IterativeCurrentPFSolver<sym>> iterative_current_pf_solver_;
+    std::optional<RadialSweepPFSolver<sym>> radial_sweep_pf_solver_;
+    std::optional<FastDecoupledPFSolver<sym>> fast_decoupled_pf_solver_;
+    std::optional<DCPFSolver<sym>> dc_pf_solver_;
     std::optional<IterativeLinearSESolver<sym>> iterative_linear_se_solver_;
     std::optional<NewtonRaphsonSESolver<sym>> newton_raphson_se_solver_;
     std::optional<ShortCircuitSolver<sym>> iec60909_sc_solver_;
+    ComplexValueVector<sym> previous_u_; // last converged power flow solution, used for warm start
+    SparseLUParallelism lu_parallelism_{};
+    SparseKrylovSettings krylov_settings_{};
+    JacobianReuseSettings jacobian_reuse_settings_{};
+    bool se_mixed_precision_{false};
 
     SolverOutput<sym> run_power_flow_newton_raphson(PowerFlowInput<sym> const& input, double err_tol, Idx max_iter,
-                                                    CalculationInfo& calculation_info, YBus<sym> const& y_bus) {
+                                                    CalculationInfo& calculation_info, YBus<sym> const& y_bus,
+                                                    std::span<ComplexValue<sym> const> initial_u) {
         if (!newton_raphson_pf_solver_.has_value()) {
             Timer const timer(calculation_info, 2210, "Create math solver");
-            newton_raphson_pf_solver_.emplace(y_bus, topo_ptr_);
+            newton_raphson_pf_solver_.emplace(y_bus, topo_ptr_, jacobian_reuse_settings_);
+            newton_raphson_pf_solver_->set_lu_parallelism(lu_parallelism_);
         }
-        return newton_raphson_pf_solver_.value().run_power_flow(y_bus, input, err_tol, max_iter, calculation_info);
+        return newton_raphson_pf_solver_.value().run_power_flow(y_bus, input, err_tol, max_iter, calculation_info,
+                                                                initial_u);
     }
 
     SolverOutput<sym> run_power_flow_linear(PowerFlowInput<sym> const& input, double /* err_tol */, Idx /* max_iter */,
                                             CalculationInfo& calculation_info, YBus<sym> const& y_bus) {
         if (!linear_pf_solver_.has_value()) {
             Timer const timer(calculation_info, 2210, "Create math solver");
-            linear_pf_solver_.emplace(y_bus, topo_ptr_);
+            linear_pf_solver_.emplace(y_bus, topo_ptr_, krylov_settings_);
+            linear_pf_solver_->set_lu_parallelism(lu_parallelism_);
         }
         return linear_pf_solver_.value().run_power_flow(y_bus, input, calculation_info);
     }
 
     SolverOutput<sym> run_power_flow_iterative_current(PowerFlowInput<sym> const& input, double err_tol, Idx max_iter,
-                                                       CalculationInfo& calculation_info, YBus<sym> const& y_bus) {
+                                                       CalculationInfo& calculation_info, YBus<sym> const& y_bus,
+                                                       std::span<ComplexValue<sym> const> initial_u = {}) {
+        // the same iteration with backward/forward sweeps over the tree, without the sparse LU solver
+        if (radial_) {
+            if (!radial_sweep_pf_solver_.has_value()) {
+                Timer const timer(calculation_info, 2210, "Create math solver");
+                radial_sweep_pf_solver_.emplace(y_bus, topo_ptr_);
+            }
+            return radial_sweep_pf_solver_.value().run_power_flow(y_bus, input, err_tol, max_iter, calculation_info,
+                                                                  initial_u);
+        }
         if (!iterative_current_pf_solver_.has_value()) {
             Timer const timer(calculation_info, 2210, "Create math solver");
             iterative_current_pf_solver_.emplace(y_bus, topo_ptr_);
+            iterative_current_pf_solver_->set_lu_parallelism(lu_parallelism_);
+        }
+        return iterative_current_pf_solver_.value().run_power_flow(y_bus, input, err_tol, max_iter, calculation_info,
+                                                                   initial_u);
+    }
+
+    // fall back to Newton-Raphson if the fast decoupled iteration did not converge, or if B' is singular
+    SolverOutput<sym> run_power_flow_fast_decoupled(PowerFlowInput<sym> const& input, double err_tol, Idx max_iter,
+                                                    CalculationInfo& calculation_info, YBus<sym> const& y_bus,
+                                                    std::span<ComplexValue<sym> const> initial_u) {
+        if (!fast_decoupled_pf_solver_.has_value()) {
+            Timer const timer(calculation_info, 2210, "Create math solver");
+            fast_decoupled_pf_solver_.emplace(y_bus, topo_ptr_);
+            fast_decoupled_pf_solver_->set_lu_parallelism(lu_parallelism_);
+        }
+        try {
+            return fast_decoupled_pf_solver_.value().run_power_flow(y_bus, input, err_tol, max_iter,
+                                                                    calculation_info, initial_u);
+        } catch (IterationDiverge const&) {
+        } catch (SparseMatrixError const&) {
+        }
+        calculation_info[Timer::make_key(2232, "Number of fallbacks to Newton-Raphson")] += 1.0;
+        return run_power_flow_newton_raphson(input, err_tol, max_iter, calculation_info, y_bus, initial_u);
+    }
+
+    SolverOutput<sym> run_power_flow_dc(PowerFlowInput<sym> const& input, CalculationInfo& calculation_info,
+                                        YBus<sym> const& y_bus) {
+        return get_dc_pf_solver(calculation_info, y_bus).run_power_flow(y_bus, input, calculation_info);
+    }
+
+    DCPFSolver<sym>& get_dc_pf_solver(CalculationInfo& calculation_info, YBus<sym> const& y_bus) {
+        if (!dc_pf_solver_.has_value()) {
+            Timer const timer(calculation_info, 2210, "Create math solver");
+            dc_pf_solver_.emplace(y_bus, topo_ptr_);
+            dc_pf_solver_->set_lu_parallelism(lu_parallelism_);
+        }
+        return dc_pf_solver_.value();
+    }
+
+    NewtonRaphsonPFSolver<sym>& get_calculated_newton_raphson_pf_solver() {
+        if (!newton_raphson_pf_solver_.has_value()) {
+            throw CalculationError{"The sensitivities need a converged Newton-Raphson power flow calculation!\n"};
         }
-        return iterative_current_pf_solver_.value().run_power_flow(y_bus, input, err_tol, max_iter, calculation_info);
+        return newton_raphson_pf_solver_.value();
     }
 
     SolverOutput<sym> run_power_flow_linear_current(PowerFlowInput<sym> const& input, double /* err_tol */,
@@ -152,7 +312,8 @@ template <symmetry_tag sym> class MathSolver {
         // construct model if needed
         if (!iterative_linear_se_solver_.has_value()) {
             Timer const timer(calculation_info, 2210, "Create math solver");
-            iterative_linear_se_solver_.emplace(y_bus, topo_ptr_);
+            iterative_linear_se_solver_.emplace(y_bus, topo_ptr_, se_mixed_precision_);
+            iterative_linear_se_solver_->set_lu_parallelism(lu_parallelism_);
         }
 
         // call calculation
@@ -167,6 +328,7 @@ template <symmetry_tag sym> class MathSolver {
         if (!newton_raphson_se_solver_.has_value()) {
             Timer const timer(calculation_info, 2210, "Create math solver");
             newton_raphson_se_solver_.emplace(y_bus, topo_ptr_);
+            newton_raphson_se_solver_->set_lu_parallelism(lu_parallelism_);
         }
 
         // call calculation
@@ -142,6 +142,43 @@ J.N -= -dP_cal_m/dV
 J.M -= -dQ_cal_m/dtheta
 J.L -= -dQ_cal_m/dV
 
+
+****** Re-use of the factorized Jacobian (chord method)
+Optionally, the factorization of J is kept and re-used in the next iterations, also in the next calculations with
+the same admittance (e.g. the scenarios of a time series batch).
+J is refactorized if the power mismatch is not reduced enough in an iteration with the re-used factorization
+    max(|del_pq|) >= max_mismatch_ratio * max(|del_pq| of the previous iteration)
+The mismatch del_pq is always calculated exactly, only the increment is calculated with the approximate Jacobian.
+The iteration converges linearly instead of quadratically with a re-used factorization,
+    so a small voltage increment of such an iteration does not mean that the voltage is within the error tolerance.
+If the voltage increment of an iteration with a re-used factorization is within the error tolerance,
+    the true mismatch is calculated at the new voltage in an extra iteration. The calculation converged if
+    max(|del_pq|) <= err_tol
+    otherwise J is refactorized and the iteration continues with a Newton-Raphson step.
+
+
+****** Sensitivities
+The factorization of J of the last iteration is retained after a converged calculation.
+Around the solution, a change of the specified injection del_pq gives the change of the unknown
+    del_x = J^-1 * del_pq
+The sensitivity to the injection of bus k is solved with a unit right hand side at bus k,
+    only the rows of the requested buses and branches are solved (sparse right hand side).
+d_theta = del_x.theta
+dV = del_x.v * V
+dU = U .* (del_x.v + 1j * del_x.theta)
+The change of the power at the from side of a branch, with I_f = yff * U_f + yft * U_t
+    dS_f = dU_f .* conj(I_f) + U_f .* conj(yff * dU_f + yft * dU_t)
+The factorization is of the jacobian at the voltage of the last iteration, so the accuracy is in the order of the
+error tolerance. With the re-use of the jacobian, it may be the factorization of an earlier iteration.
+
+Line outage distribution factors (LODF) of the active power are derived from the branch sensitivities.
+The outage of branch m is modelled as a transfer from the to side to the from side of branch m,
+    such that the flow through branch m is cancelled.
+T_lm = dP_l/dP_(from bus of m) - dP_l/dP_(to bus of m)
+LODF_lm = T_lm * (I - T_mm)^-1
+The change of flow in branch l after the outage of branch m is del_P_l = LODF_lm * P_m.
+LODF_mm = -I. If I - T_mm is singular, branch m is a bridge and the LODF is nan.
+
 */
 
 #include "block_matrix.hpp"
@@ -155,8 +192,23 @@ J.L -= -dQ_cal_m/dV
 #include "../common/three_phase_tensor.hpp"
 #include "../common/timer.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <span>
+
 namespace power_grid_model::math_solver {
 
+// re-use of the factorized jacobian over iterations and calculations, see newton_raphson_pf_solver.hpp
+struct JacobianReuseSettings {
+    static constexpr double default_max_mismatch_ratio = 0.5;
+
+    bool enabled{false};
+    double max_mismatch_ratio{default_max_mismatch_ratio}; // refactorize if the mismatch is not reduced below ratio
+
+    bool operator==(JacobianReuseSettings const&) const = default;
+};
+
 // hide implementation in inside namespace
 namespace newton_raphson_pf {
 
@@ -200,40 +252,90 @@ template <symmetry_tag sym> class PFJacBlock : public Block<double, sym, true, 2
 };
 
 // solver
-template <symmetry_tag sym> class NewtonRaphsonPFSolver : public IterativePFSolver<sym, NewtonRaphsonPFSolver<sym>> {
+// the admittance and voltage are stored in the complex layout for the calculation of the jacobian,
+// the split layout calculates the blocks with real arithmetic only
+template <symmetry_tag sym, complex_layout_tag layout = split_complex_t>
+class NewtonRaphsonPFSolver : public IterativePFSolver<sym, NewtonRaphsonPFSolver<sym, layout>> {
   public:
     using SparseSolverType = SparseLUSolver<PFJacBlock<sym>, ComplexPower<sym>, PolarPhasor<sym>>;
     using BlockPermArray =
         typename SparseLUSolver<PFJacBlock<sym>, ComplexPower<sym>, PolarPhasor<sym>>::BlockPermArray;
 
-    NewtonRaphsonPFSolver(YBus<sym> const& y_bus, std::shared_ptr<MathModelTopology const> const& topo_ptr)
+    NewtonRaphsonPFSolver(YBus<sym> const& y_bus, std::shared_ptr<MathModelTopology const> const& topo_ptr,
+                          JacobianReuseSettings const& jacobian_reuse = {})
         : IterativePFSolver<sym, NewtonRaphsonPFSolver>{y_bus, topo_ptr},
           data_jac_(y_bus.nnz_lu()),
           x_(y_bus.size()),
           del_x_pq_(y_bus.size()),
-          sparse_solver_{y_bus.shared_indptr_lu(), y_bus.shared_indices_lu(), y_bus.shared_diag_lu()},
-          perm_(y_bus.size()) {}
+          sparse_solver_{y_bus.shared_lu_symbolic()},
+          perm_(y_bus.size()),
+          branch_bus_idx_{topo_ptr, &topo_ptr->branch_bus_idx},
+          jacobian_reuse_{jacobian_reuse} {}
+
+    SolverOutput<sym> run_power_flow(YBus<sym> const& y_bus, PowerFlowInput<sym> const& input, double err_tol,
+                                     Idx max_iter, CalculationInfo& calculation_info,
+                                     std::span<ComplexValue<sym> const> initial_u = {}) {
+        n_factorizations_ = 0;
+        has_sensitivity_factorization_ = false;
+        err_tol_ = err_tol;
+        is_stale_step_ = false;
+        is_verifying_ = false;
+        is_verified_ = false;
+        SolverOutput<sym> output = IterativePFSolver<sym, NewtonRaphsonPFSolver>::run_power_flow(
+            y_bus, input, err_tol, max_iter, calculation_info, initial_u);
+        if (jacobian_reuse_.enabled) {
+            calculation_info[Timer::make_key(2233, "Number of jacobian factorizations")] +=
+                static_cast<double>(n_factorizations_);
+        }
+        // the factorization of the last iteration is retained for the sensitivities
+        has_sensitivity_factorization_ = true;
+        sensitivity_admittance_id_ = y_bus.admittance_id();
+        return output;
+    }
 
     // Initilize the unknown variable in polar form
-    void initialize_derived_solver(YBus<sym> const& y_bus, PowerFlowInput<sym> const& input,
-                                   SolverOutput<sym>& output) {
-        using LinearSparseSolverType = SparseLUSolver<ComplexTensor<sym>, ComplexValue<sym>, ComplexValue<sym>>;
-
-        ComplexTensorVector<sym> linear_mat_data(y_bus.nnz_lu());
-        LinearSparseSolverType linear_sparse_solver{y_bus.shared_indptr_lu(), y_bus.shared_indices_lu(),
-                                                    y_bus.shared_diag_lu()};
-        typename LinearSparseSolverType::BlockPermArray linear_perm(y_bus.size());
-
-        detail::copy_y_bus<sym>(y_bus, linear_mat_data);
-        detail::prepare_linear_matrix_and_rhs(y_bus, input, *this->load_gens_per_bus_, *this->sources_per_bus_, output,
-                                              linear_mat_data);
-        linear_sparse_solver.prefactorize_and_solve(linear_mat_data, linear_perm, output.u, output.u);
+    // with a warm start, output.u already contains the start voltage; otherwise it is the solution of the linear method
+    void initialize_derived_solver(YBus<sym> const& y_bus, PowerFlowInput<sym> const& input, SolverOutput<sym>& output,
+                                   bool warm_start) {
+        if (!warm_start) {
+            using LinearSparseSolverType = SparseLUSolver<ComplexTensor<sym>, ComplexValue<sym>, ComplexValue<sym>>;
+
+            ComplexTensorVector<sym> linear_mat_data(y_bus.nnz_lu());
+            LinearSparseSolverType linear_sparse_solver{y_bus.shared_lu_symbolic()};
+            typename LinearSparseSolverType::BlockPermArray linear_perm(y_bus.size());
+
+            detail::copy_y_bus<sym>(y_bus, linear_mat_data);
+            detail::prepare_linear_matrix_and_rhs(y_bus, input, *this->load_gens_per_bus_, *this->sources_per_bus_,
+                                                  output, linear_mat_data);
+            linear_sparse_solver.prefactorize_and_solve(linear_mat_data, linear_perm, output.u, output.u);
+        }
 
         // get magnitude and angle of start voltage
         for (Idx i = 0; i != this->n_bus_; ++i) {
             x_[i].v() = cabs(output.u[i]);
             x_[i].theta() = arg(output.u[i]);
         }
+
+        // admittance in the split layout, only converted again after a change of the admittance
+        if constexpr (is_split_complex_v<layout>) {
+            if (y_split_.empty() || y_bus.admittance_id() != y_split_admittance_id_) {
+                ComplexTensorVector<sym> const& ydata = y_bus.admittance();
+                y_split_.resize(ydata.size());
+                std::ranges::transform(ydata, y_split_.begin(),
+                                       [](ComplexTensor<sym> const& yij) { return SplitComplexTensor<sym>{yij}; });
+                y_split_admittance_id_ = y_bus.admittance_id();
+            }
+            u_split_.resize(this->n_bus_);
+        }
+
+        // the factorized jacobian of the previous calculation is re-used in the first iteration
+        if (jacobian_reuse_.enabled) {
+            if (y_bus.admittance_id() != factorized_admittance_id_) {
+                is_factorized_ = false;
+                factorized_admittance_id_ = y_bus.admittance_id();
+            }
+            previous_mismatch_ = std::numeric_limits<double>::infinity();
+        }
     }
 
     // Calculate the Jacobian and deviation
@@ -250,13 +352,51 @@ template <symmetry_tag sym> class NewtonRaphsonPFSolver : public IterativePFSolv
             add_loads(load_gens, bus_number, diagonal_position, input, load_gen_type);
             add_sources(sources, bus_number, diagonal_position, y_bus, input, u);
         }
+
+        if (jacobian_reuse_.enabled) {
+            mismatch_ = 0.0;
+            for (Idx bus = 0; bus != this->n_bus_; ++bus) {
+                mismatch_ =
+                    std::max({mismatch_, max_val(cabs(del_x_pq_[bus].p())), max_val(cabs(del_x_pq_[bus].q()))});
+            }
+        }
     }
 
     // Solve the linear Equations
-    void solve_matrix() { sparse_solver_.prefactorize_and_solve(data_jac_, perm_, del_x_pq_, del_x_pq_); }
+    // with the re-use of the jacobian, only refactorize if the mismatch is not reduced enough
+    // after a converged step with a re-used factorization, nothing is solved if the true mismatch is within tolerance
+    void solve_matrix() {
+        if (!jacobian_reuse_.enabled) {
+            sparse_solver_.prefactorize_and_solve(data_jac_, perm_, del_x_pq_, del_x_pq_);
+            return;
+        }
+        if (is_verifying_) {
+            is_verifying_ = false;
+            if (mismatch_ <= err_tol_) {
+                is_verified_ = true;
+                return;
+            }
+            is_factorized_ = false;
+        }
+        is_stale_step_ = is_factorized_ && mismatch_ < jacobian_reuse_.max_mismatch_ratio * previous_mismatch_;
+        if (!is_stale_step_) {
+            is_factorized_ = false;
+            lu_jac_ = data_jac_;
+            sparse_solver_.prefactorize(lu_jac_, perm_);
+            is_factorized_ = true;
+            ++n_factorizations_;
+        }
+        sparse_solver_.solve_with_prefactorized_matrix(lu_jac_, perm_, del_x_pq_, del_x_pq_);
+        previous_mismatch_ = mismatch_;
+    }
 
     // Get maximum deviation among all bus voltages
+    // the convergence of a step with a re-used factorization is only final after the check of the true mismatch
     double iterate_unknown(ComplexValueVector<sym>& u) {
+        if (is_verified_) {
+            is_verified_ = false;
+            return 0.0;
+        }
         double max_dev = 0.0;
         // loop each bus as i
         for (Idx i = 0; i != this->n_bus_; ++i) {
@@ -273,10 +413,160 @@ template <symmetry_tag sym> class NewtonRaphsonPFSolver : public IterativePFSolv
             // assign
             u[i] = u_tmp;
         }
+        if (is_stale_step_ && max_dev <= err_tol_) {
+            // not converged yet, the next iteration checks the true mismatch
+            is_verifying_ = true;
+            return std::max(max_dev, 2.0 * err_tol_);
+        }
         return max_dev;
     }
 
+    // Sensitivities of the voltage at the buses and the power flow in the branches to the injection at the buses
+    // uses the factorization of the last converged calculation with the same admittance
+    // a branch which is not connected at both sides has zero sensitivity
+    PowerFlowSensitivity<sym> calculate_sensitivity(YBus<sym> const& y_bus, std::span<Idx const> injection_buses,
+                                                    std::span<Idx const> buses, std::span<Idx const> branches) {
+        if (!has_sensitivity_factorization_ || y_bus.admittance_id() != sensitivity_admittance_id_) {
+            throw CalculationError{"The sensitivities need a converged Newton-Raphson power flow calculation with the "
+                                   "same admittance!\n"};
+        }
+        std::vector<PFJacBlock<sym>> const& lu = jacobian_reuse_.enabled ? lu_jac_ : data_jac_;
+        std::vector<BranchIdx> const& branch_bus_idx = *branch_bus_idx_;
+        std::vector<BranchCalcParam<sym>> const& branch_param = y_bus.math_model_param().branch_param;
+
+        // only the rows of the requested buses and the buses of the requested branches are needed
+        IdxVector x_rows(buses.begin(), buses.end());
+        for (Idx const branch : branches) {
+            for (Idx const bus : branch_bus_idx[branch]) {
+                if (bus != -1) {
+                    x_rows.push_back(bus);
+                }
+            }
+        }
+        std::ranges::sort(x_rows);
+        auto const [first, last] = std::ranges::unique(x_rows);
+        x_rows.erase(first, last);
+
+        // voltage and branch current of the solution
+        ComplexValueVector<sym> u(this->n_bus_);
+        for (Idx const bus : x_rows) {
+            u[bus] = x_[bus].v() * exp(1.0i * x_[bus].theta());
+        }
+        ComplexValueVector<sym> i_f(branches.size());
+        for (size_t i = 0; i != branches.size(); ++i) {
+            auto const [bus_f, bus_t] = branch_bus_idx[branches[i]];
+            if (bus_f != -1 && bus_t != -1) {
+                BranchCalcParam<sym> const& param = branch_param[branches[i]];
+                i_f[i] = dot(param.yff(), u[bus_f]) + dot(param.yft(), u[bus_t]);
+            }
+        }
+
+        size_t const n_injection = injection_buses.size();
+        PowerFlowSensitivity<sym> sensitivity{
+            .voltage = std::vector<VoltageSensitivity<sym>>(buses.size() * n_injection),
+            .branch = std::vector<BranchFlowSensitivity<sym>>(branches.size() * n_injection)};
+        std::vector<ComplexPower<sym>> rhs(this->n_bus_);
+        std::vector<PolarPhasor<sym>> x(this->n_bus_);
+        // dU = U .* (del_x.v + 1j * del_x.theta)
+        auto const delta_u = [&u, &x](Idx bus) -> ComplexValue<sym> {
+            return u[bus] * ComplexValue<sym>{RealValue<sym>{x[bus].v()}, RealValue<sym>{x[bus].theta()}};
+        };
+        for (size_t k = 0; k != n_injection; ++k) {
+            Idx const bus = injection_buses[k];
+            IdxVector const rhs_rows{bus};
+            for (bool const reactive : {false, true}) {
+                for (Idx phase = 0; phase != n_phase; ++phase) {
+                    if (reactive) {
+                        rhs[bus].q() = detail::unit_value<sym>(phase);
+                    } else {
+                        rhs[bus].p() = detail::unit_value<sym>(phase);
+                    }
+                    sparse_solver_.solve_sparse_with_prefactorized_matrix(lu, perm_, rhs, rhs_rows, x_rows, x);
+                    rhs[bus] = ComplexPower<sym>{};
+
+                    for (size_t i = 0; i != buses.size(); ++i) {
+                        Idx const b = buses[i];
+                        VoltageSensitivity<sym>& entry = sensitivity.voltage[i * n_injection + k];
+                        RealValue<sym> const d_v = x_[b].v() * x[b].v();
+                        detail::set_column<sym>(reactive ? entry.dtheta_dq : entry.dtheta_dp, phase, x[b].theta());
+                        detail::set_column<sym>(reactive ? entry.dv_dq : entry.dv_dp, phase, d_v);
+                    }
+                    for (size_t i = 0; i != branches.size(); ++i) {
+                        auto const [bus_f, bus_t] = branch_bus_idx[branches[i]];
+                        if (bus_f == -1 || bus_t == -1) {
+                            continue;
+                        }
+                        BranchCalcParam<sym> const& param = branch_param[branches[i]];
+                        ComplexValue<sym> const du_f = delta_u(bus_f);
+                        ComplexValue<sym> const du_t = delta_u(bus_t);
+                        ComplexValue<sym> const ds_f =
+                            du_f * conj(i_f[i]) + u[bus_f] * conj(dot(param.yff(), du_f) + dot(param.yft(), du_t));
+                        BranchFlowSensitivity<sym>& entry = sensitivity.branch[i * n_injection + k];
+                        detail::set_column<sym>(reactive ? entry.dp_dq : entry.dp_dp, phase, real(ds_f));
+                        detail::set_column<sym>(reactive ? entry.dq_dq : entry.dq_dp, phase, imag(ds_f));
+                    }
+                }
+            }
+        }
+        return sensitivity;
+    }
+
+    // Line outage distribution factors of the active power in the branches to the outage of the outage branches
+    // the result is row major, entry [i * outage_branches.size() + m] is the factor of branches[i] to
+    // outage_branches[m]
+    // an outage branch which is not connected at both sides has zero factors
+    std::vector<RealTensor<sym>> calculate_lodf(YBus<sym> const& y_bus, std::span<Idx const> branches,
+                                                std::span<Idx const> outage_branches) {
+        std::vector<BranchIdx> const& branch_bus_idx = *branch_bus_idx_;
+
+        // transfer over the outage branches, injection at both sides of the outage branches
+        IdxVector injection_buses;
+        for (Idx const branch : outage_branches) {
+            for (Idx const bus : branch_bus_idx[branch]) {
+                if (bus != -1) {
+                    injection_buses.push_back(bus);
+                }
+            }
+        }
+        std::ranges::sort(injection_buses);
+        auto const [first, last] = std::ranges::unique(injection_buses);
+        injection_buses.erase(first, last);
+        IdxVector flow_branches(branches.begin(), branches.end());
+        flow_branches.insert(flow_branches.end(), outage_branches.begin(), outage_branches.end());
+        PowerFlowSensitivity<sym> const sensitivity = calculate_sensitivity(y_bus, injection_buses, {}, flow_branches);
+
+        size_t const n_injection = injection_buses.size();
+        auto const transfer = [&](size_t flow_branch, Idx outage_branch) -> RealTensor<sym> {
+            auto const [bus_f, bus_t] = branch_bus_idx[outage_branch];
+            auto const injection_position = [&injection_buses](Idx bus) {
+                return static_cast<size_t>(std::ranges::lower_bound(injection_buses, bus) - injection_buses.begin());
+            };
+            return sensitivity.branch[flow_branch * n_injection + injection_position(bus_f)].dp_dp -
+                   sensitivity.branch[flow_branch * n_injection + injection_position(bus_t)].dp_dp;
+        };
+
+        std::vector<RealTensor<sym>> lodf(branches.size() * outage_branches.size());
+        for (size_t m = 0; m != outage_branches.size(); ++m) {
+            auto const [bus_f, bus_t] = branch_bus_idx[outage_branches[m]];
+            if (bus_f == -1 || bus_t == -1) {
+                continue;
+            }
+            RealTensor<sym> const inv_remaining = inv_remaining_flow(transfer(branches.size() + m, outage_branches[m]));
+            for (size_t i = 0; i != branches.size(); ++i) {
+                lodf[i * outage_branches.size() + m] = branches[i] == outage_branches[m]
+                                                           ? RealTensor<sym>{-1.0}
+                                                           : RealTensor<sym>{dot(transfer(i, outage_branches[m]),
+                                                                                 inv_remaining)};
+            }
+        }
+        return lodf;
+    }
+
+    void set_lu_parallelism(SparseLUParallelism const& parallelism) { sparse_solver_.set_parallelism(parallelism); }
+
   private:
+    static constexpr Idx n_phase = is_symmetric_v<sym> ? 1 : 3;
+
     // data for jacobian
     std::vector<PFJacBlock<sym>> data_jac_;
     // calculation data
@@ -290,6 +580,39 @@ template <symmetry_tag sym> class NewtonRaphsonPFSolver : public IterativePFSolv
     SparseSolverType sparse_solver_;
     // permutation array
     BlockPermArray perm_;
+    // admittance and voltage in the split layout, only used for the split complex layout
+    std::vector<SplitComplexTensor<sym>> y_split_;
+    uint64_t y_split_admittance_id_{};
+    std::vector<SplitComplexValue<sym>> u_split_;
+    // shared topo data, and the factorization of the last converged calculation for the sensitivities
+    std::shared_ptr<std::vector<BranchIdx> const> branch_bus_idx_;
+    bool has_sensitivity_factorization_{false};
+    uint64_t sensitivity_admittance_id_{};
+    // factorized jacobian, only used with the re-use of the jacobian
+    JacobianReuseSettings jacobian_reuse_;
+    std::vector<PFJacBlock<sym>> lu_jac_;
+    bool is_factorized_{false};
+    uint64_t factorized_admittance_id_{};
+    double mismatch_{};
+    double previous_mismatch_{};
+    Idx n_factorizations_{};
+    double err_tol_{};
+    bool is_stale_step_{false}; // the last increment is solved with a re-used factorization
+    bool is_verifying_{false};  // the next iteration checks the true mismatch
+    bool is_verified_{false};   // the true mismatch is within the error tolerance
+
+    // (I - T_mm)^-1, nan if the outage branch is a bridge
+    static RealTensor<sym> inv_remaining_flow(RealTensor<sym> const& transfer) {
+        RealTensor<sym> const remaining = RealTensor<sym>{1.0} - transfer;
+        if constexpr (is_symmetric_v<sym>) {
+            return std::abs(remaining) < numerical_tolerance ? std::numeric_limits<double>::quiet_NaN()
+                                                             : 1.0 / remaining;
+        } else {
+            return std::abs(remaining.matrix().determinant()) < numerical_tolerance
+                       ? RealTensor<sym>{RealTensor<sym>::Constant(std::numeric_limits<double>::quiet_NaN())}
+                       : RealTensor<sym>{remaining.matrix().inverse().array()};
+        }
+    }
 
     /// @brief power_flow_ij = (ui @* conj(uj))  .* conj(yij)
     /// Hij = diag(Vi) * ( Gij .* sin(theta_ij) - Bij .* cos(theta_ij) ) * diag(Vj)
@@ -309,6 +632,24 @@ template <symmetry_tag sym> class NewtonRaphsonPFSolver : public IterativePFSolv
         return block;
     }
 
+    /// @brief same as above, in the split layout
+    /// ui = a + 1j * b, uj = c + 1j * d, yij = Gij + 1j * Bij
+    /// ui @* conj(uj) = (a @* c + b @* d) + 1j * (b @* c - a @* d) = R + 1j * I
+    /// power_flow_ij = (R .* Gij + I .* Bij) + 1j * (I .* Gij - R .* Bij)
+    static PFJacBlock<sym> calculate_hnml(SplitComplexTensor<sym> const& yij, SplitComplexValue<sym> const& ui,
+                                          SplitComplexValue<sym> const& uj) {
+        PFJacBlock<sym> block{};
+        RealTensor<sym> const flow_real =
+            vector_outer_product(ui.real, uj.real) + vector_outer_product(ui.imag, uj.imag);
+        RealTensor<sym> const flow_imag =
+            vector_outer_product(ui.imag, uj.real) - vector_outer_product(ui.real, uj.imag);
+        block.h() = flow_imag * yij.real - flow_real * yij.imag;
+        block.n() = flow_real * yij.real + flow_imag * yij.imag;
+        block.m() = -block.n();
+        block.l() = block.h();
+        return block;
+    }
+
     void prepare_matrix_and_rhs_from_network_perspective(YBus<sym> const& y_bus, ComplexValueVector<sym> const& u,
                                                          IdxVector const& bus_entry) {
         IdxVector const& indptr = y_bus.row_indptr_lu();
@@ -316,6 +657,12 @@ template <symmetry_tag sym> class NewtonRaphsonPFSolver : public IterativePFSolv
         IdxVector const& map_lu_y_bus = y_bus.map_lu_y_bus();
         ComplexTensorVector<sym> const& ydata = y_bus.admittance();
 
+        if constexpr (is_split_complex_v<layout>) {
+            for (Idx bus = 0; bus != this->n_bus_; ++bus) {
+                u_split_[bus] = SplitComplexValue<sym>{u[bus]};
+            }
+        }
+
         for (Idx row = 0; row != this->n_bus_; ++row) {
             // reset power injection
             del_x_pq_[row].p() = RealValue<sym>{0.0};
@@ -332,7 +679,11 @@ template <symmetry_tag sym> class NewtonRaphsonPFSolver : public IterativePFSolv
                 }
                 Idx const j = indices[k];
                 // incomplete jacobian
-                data_jac_[k] = calculate_hnml(ydata[k_y_bus], u[row], u[j]);
+                if constexpr (is_split_complex_v<layout>) {
+                    data_jac_[k] = calculate_hnml(y_split_[k_y_bus], u_split_[row], u_split_[j]);
+                } else {
+                    data_jac_[k] = calculate_hnml(ydata[k_y_bus], u[row], u[j]);
+                }
                 // accumulate negative power injection
                 // -P = sum(-N)
                 del_x_pq_[row].p() -= sum_row(data_jac_[k].n());
@@ -436,8 +787,10 @@ template <symmetry_tag sym> class NewtonRaphsonPFSolver : public IterativePFSolv
     }
 };
 
-template class NewtonRaphsonPFSolver<symmetric_t>;
-template class NewtonRaphsonPFSolver<asymmetric_t>;
+template class NewtonRaphsonPFSolver<symmetric_t, split_complex_t>;
+template class NewtonRaphsonPFSolver<asymmetric_t, split_complex_t>;
+template class NewtonRaphsonPFSolver<symmetric_t, interleaved_complex_t>;
+template class NewtonRaphsonPFSolver<asymmetric_t, interleaved_complex_t>;
 
 } // namespace newton_raphson_pf
 
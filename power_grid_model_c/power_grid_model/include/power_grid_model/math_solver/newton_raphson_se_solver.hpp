@@ -135,7 +135,7 @@ template <symmetry_tag sym> class NewtonRaphsonSESolver {
           data_gain_(y_bus.nnz_lu()),
           delta_x_rhs_(y_bus.size()),
           x_(y_bus.size()),
-          sparse_solver_{y_bus.shared_indptr_lu(), y_bus.shared_indices_lu(), y_bus.shared_diag_lu()},
+          sparse_solver_{y_bus.shared_lu_symbolic()},
           perm_(y_bus.size()) {}
 
     SolverOutput<sym> run_state_estimation(YBus<sym> const& y_bus, StateEstimationInput<sym> const& input,
@@ -188,6 +188,8 @@ template <symmetry_tag sym> class NewtonRaphsonSESolver {
         return output;
     }
 
+    void set_lu_parallelism(SparseLUParallelism const& parallelism) { sparse_solver_.set_parallelism(parallelism); }
+
   private:
     Idx n_bus_;
     // shared topo data
@@ -0,0 +1,267 @@
+// SPDX-FileCopyrightText: Contributors to the Power Grid Model project <powergridmodel@lfenergy.org>
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#pragma once
+
+/*
+Backward/Forward Sweep Power Flow for radial math models
+
+A math model without cycles is a tree with the source as root.
+The buses of a radial math model are in reverse depth-first order (see topology.hpp),
+    so the parent p of a bus i always has a higher index than the bus itself.
+The math model is radial if every bus has at most one neighbour with a higher index,
+    the elimination in the bus order then gives no fill-ins.
+
+The iteration is the same as the iterative current method (see iterative_current_pf_solver.hpp)
+    Y * U = I_inj(U)
+but the linear equations are solved by two sweeps over the tree instead of with the sparse LU solver.
+
+Ladder reduction, once per admittance
+    The subtree of every bus is reduced to an equivalent admittance at the bus, from the leaves to the root
+    Y_eq_i = Y_ii + sum(Y_source) - sum{children c} (Y_ic * Y_eq_c^-1 * Y_ci)
+    only the tensors Y_eq_i^-1, Y_pi * Y_eq_i^-1 and Y_eq_i^-1 * Y_ip are kept
+Backward sweep, from the leaves to the root
+    I_eq_i = I_inj_i - sum{children c} (Y_ic * Y_eq_c^-1 * I_eq_c)
+Forward sweep, from the root to the leaves
+    U_i = Y_eq_i^-1 * I_eq_i - (Y_eq_i^-1 * Y_ip) * U_p
+
+Every iteration is O(n) with dense operations on the bus tensors only,
+    without the sparse LU factorization, the block permutations and the copy of the Y bus.
+The math solver uses this solver automatically for the iterative current methods if the math model is radial.
+*/
+
+#include "iterative_pf_solver.hpp"
+#include "y_bus.hpp"
+
+#include "../calculation_parameters.hpp"
+#include "../common/common.hpp"
+#include "../common/exception.hpp"
+#include "../common/three_phase_tensor.hpp"
+
+#include <Eigen/Dense>
+
+#include <algorithm>
+#include <cmath>
+
+namespace power_grid_model::math_solver {
+
+// hide implementation in inside namespace
+namespace radial_sweep_pf {
+
+// solver
+template <symmetry_tag sym> class RadialSweepPFSolver : public IterativePFSolver<sym, RadialSweepPFSolver<sym>> {
+  public:
+    RadialSweepPFSolver(YBus<sym> const& y_bus, std::shared_ptr<MathModelTopology const> const& topo_ptr)
+        : IterativePFSolver<sym, RadialSweepPFSolver>{y_bus, topo_ptr},
+          rhs_u_(y_bus.size()),
+          parent_(y_bus.size(), -1),
+          parent_entry_(y_bus.size(), -1),
+          child_entry_(y_bus.size(), -1),
+          y_eq_inv_(y_bus.size()),
+          current_transfer_(y_bus.size()),
+          voltage_transfer_(y_bus.size()) {
+        IdxVector const& indptr = y_bus.row_indptr();
+        IdxVector const& indices = y_bus.col_indices();
+        for (Idx bus = 0; bus != this->n_bus_; ++bus) {
+            for (Idx k = indptr[bus]; k != indptr[bus + 1]; ++k) {
+                if (indices[k] > bus) {
+                    if (parent_[bus] != -1) {
+                        throw SparseMatrixError{};
+                    }
+                    parent_[bus] = indices[k];
+                    parent_entry_[bus] = k;
+                }
+            }
+            // Y_pi, the column of the bus in the row of the parent
+            if (Idx const parent = parent_[bus]; parent != -1) {
+                auto const row_begin = indices.cbegin() + indptr[parent];
+                auto const row_end = indices.cbegin() + indptr[parent + 1];
+                child_entry_[bus] = indptr[parent] + (std::lower_bound(row_begin, row_end, bus) - row_begin);
+            }
+        }
+    }
+
+    // a math model is radial if every bus has at most one neighbour with a higher index, see above
+    static bool is_radial(MathModelTopology const& topo) {
+        if (!topo.fill_in.empty()) {
+            return false;
+        }
+        IdxVector parent(topo.n_bus(), -1);
+        for (auto const& [bus_f, bus_t] : topo.branch_bus_idx) {
+            if (bus_f == -1 || bus_t == -1 || bus_f == bus_t) {
+                continue;
+            }
+            auto const [bus, parent_bus] = std::minmax(bus_f, bus_t);
+            // parallel branches to the same parent are allowed
+            if (parent[bus] != -1 && parent[bus] != parent_bus) {
+                return false;
+            }
+            parent[bus] = parent_bus;
+        }
+        return true;
+    }
+
+    // Reduce the subtrees if the admittance changed
+    // with a warm start, output.u already contains the start voltage; otherwise use a flat start
+    void initialize_derived_solver(YBus<sym> const& y_bus, PowerFlowInput<sym> const& input, SolverOutput<sym>& output,
+                                   bool warm_start) {
+        if (!warm_start) {
+            this->make_flat_start(input, output.u);
+        }
+
+        // the admittance id also detects changes in copies of the y bus
+        if (!is_reduced_ || y_bus.admittance_id() != reduced_admittance_id_) {
+            is_reduced_ = false;
+            reduce_subtrees(y_bus);
+            reduced_admittance_id_ = y_bus.admittance_id();
+            is_reduced_ = true;
+        }
+    }
+
+    // Calculate the injected current
+    void prepare_matrix_and_rhs(YBus<sym> const& y_bus, PowerFlowInput<sym> const& input,
+                                ComplexValueVector<sym> const& u) {
+        std::vector<LoadGenType> const& load_gen_type = *this->load_gen_type_;
+
+        std::ranges::fill(rhs_u_, ComplexValue<sym>{0.0});
+        for (auto const& [bus_number, load_gens, sources] :
+             enumerated_zip_sequence(*this->load_gens_per_bus_, *this->sources_per_bus_)) {
+            add_loads(load_gens, bus_number, input, load_gen_type, u);
+            add_sources(sources, bus_number, y_bus, input);
+        }
+    }
+
+    // Backward and forward sweep, in place
+    void solve_matrix() {
+        // backward sweep, accumulate the equivalent current of the subtrees into the parents
+        for (Idx bus = 0; bus != this->n_bus_; ++bus) {
+            if (Idx const parent = parent_[bus]; parent != -1) {
+                rhs_u_[parent] -= dot(current_transfer_[bus], rhs_u_[bus]);
+            }
+        }
+        // forward sweep, the voltage of the parent is already known
+        for (Idx bus = this->n_bus_ - 1; bus != -1; --bus) {
+            rhs_u_[bus] = dot(y_eq_inv_[bus], rhs_u_[bus]);
+            if (Idx const parent = parent_[bus]; parent != -1) {
+                rhs_u_[bus] -= dot(voltage_transfer_[bus], rhs_u_[parent]);
+            }
+        }
+    }
+
+    // Find maximum deviation in voltage among all buses
+    double iterate_unknown(ComplexValueVector<sym>& u) {
+        double max_dev = 0.0;
+        for (Idx bus = 0; bus != this->n_bus_; ++bus) {
+            double const dev = max_val(cabs(rhs_u_[bus] - u[bus]));
+            max_dev = std::max(dev, max_dev);
+            u[bus] = rhs_u_[bus];
+        }
+        return max_dev;
+    }
+
+  private:
+    // relative threshold of the determinant of a (pseudo) singular equivalent admittance, as low as in the LU solver
+    static constexpr double singular_threshold = 1e-100;
+
+    // injected current, solved in place into the voltage
+    ComplexValueVector<sym> rhs_u_;
+    // tree structure, -1 for the root
+    IdxVector parent_;
+    // entries of Y_ip and Y_pi in the y bus
+    IdxVector parent_entry_;
+    IdxVector child_entry_;
+    // reduced subtrees
+    ComplexTensorVector<sym> y_eq_inv_;
+    ComplexTensorVector<sym> current_transfer_; // Y_pi * Y_eq_i^-1
+    ComplexTensorVector<sym> voltage_transfer_; // Y_eq_i^-1 * Y_ip
+    bool is_reduced_{false};
+    uint64_t reduced_admittance_id_{};
+
+    static ComplexTensor<sym> invert_equivalent(ComplexTensor<sym> const& y_eq) {
+        if constexpr (is_symmetric_v<sym>) {
+            if (!is_normal(y_eq)) {
+                throw SparseMatrixError{};
+            }
+            return 1.0 / y_eq;
+        } else {
+            // closed form inverse of the 3 * 3 matrix, (pseudo) singular if the determinant vanishes
+            Eigen::Matrix<DoubleComplex, 3, 3> const matrix = y_eq.matrix();
+            double const scale = matrix.cwiseAbs().maxCoeff();
+            if (!(std::abs(matrix.determinant()) > singular_threshold * scale * scale * scale)) {
+                throw SparseMatrixError{};
+            }
+            Eigen::Matrix<DoubleComplex, 3, 3> const inverse = matrix.inverse();
+            if (!inverse.allFinite()) {
+                throw SparseMatrixError{};
+            }
+            return ComplexTensor<sym>{inverse.array()};
+        }
+    }
+
+    // ladder reduction from the leaves to the root, the children have a lower index than the parent
+    void reduce_subtrees(YBus<sym> const& y_bus) {
+        ComplexTensorVector<sym> const& ydata = y_bus.admittance();
+        IdxVector const& bus_entry = y_bus.bus_entry();
+
+        ComplexTensorVector<sym> y_eq(this->n_bus_);
+        for (Idx bus = 0; bus != this->n_bus_; ++bus) {
+            y_eq[bus] = ydata[bus_entry[bus]];
+        }
+        for (auto const& [bus_number, sources] : enumerated_zip_sequence(*this->sources_per_bus_)) {
+            for (Idx const source_number : sources) {
+                y_eq[bus_number] += y_bus.math_model_param().source_param[source_number].template y_ref<sym>();
+            }
+        }
+        for (Idx bus = 0; bus != this->n_bus_; ++bus) {
+            y_eq_inv_[bus] = invert_equivalent(y_eq[bus]);
+            if (Idx const parent = parent_[bus]; parent != -1) {
+                current_transfer_[bus] = dot(ydata[child_entry_[bus]], y_eq_inv_[bus]);
+                voltage_transfer_[bus] = dot(y_eq_inv_[bus], ydata[parent_entry_[bus]]);
+                y_eq[parent] -= dot(current_transfer_[bus], ydata[parent_entry_[bus]]);
+            }
+        }
+    }
+
+    void add_loads(IdxRange const& load_gens, Idx bus_number, PowerFlowInput<sym> const& input,
+                   std::vector<LoadGenType> const& load_gen_type, ComplexValueVector<sym> const& u) {
+        using enum LoadGenType;
+        for (Idx const load_number : load_gens) {
+            LoadGenType const type = load_gen_type[load_number];
+            switch (type) {
+            case const_pq:
+                // I_inj_i = conj(S_inj_j/U_i)
+                rhs_u_[bus_number] += conj(input.s_injection[load_number] / u[bus_number]);
+                break;
+            case const_y:
+                // I_inj_i = conj(S_inj_j) * U_i
+                rhs_u_[bus_number] += conj(input.s_injection[load_number]) * u[bus_number];
+                break;
+            case const_i:
+                // I_inj_i = conj(S_inj_j*abs(U_i)/U_i)
+                rhs_u_[bus_number] += conj(input.s_injection[load_number] * cabs(u[bus_number]) / u[bus_number]);
+                break;
+            default:
+                throw MissingCaseForEnumError("Injection current calculation", type);
+            }
+        }
+    }
+
+    void add_sources(IdxRange const& sources, Idx bus_number, YBus<sym> const& y_bus,
+                     PowerFlowInput<sym> const& input) {
+        for (Idx const source_number : sources) {
+            // I_inj_i += Y_source_j * U_ref_j
+            rhs_u_[bus_number] += dot(y_bus.math_model_param().source_param[source_number].template y_ref<sym>(),
+                                      ComplexValue<sym>{input.source[source_number]});
+        }
+    }
+};
+
+template class RadialSweepPFSolver<symmetric_t>;
+template class RadialSweepPFSolver<asymmetric_t>;
+
+} // namespace radial_sweep_pf
+
+using radial_sweep_pf::RadialSweepPFSolver;
+
+} // namespace power_grid_model::math_solver
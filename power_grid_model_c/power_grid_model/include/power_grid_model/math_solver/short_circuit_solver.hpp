@@ -28,7 +28,7 @@ template <symmetry_tag sym> class ShortCircuitSolver {
           n_source_{topo_ptr->n_source()},
           sources_per_bus_{topo_ptr, &topo_ptr->sources_per_bus},
           mat_data_(y_bus.nnz_lu()),
-          sparse_solver_{y_bus.shared_indptr_lu(), y_bus.shared_indices_lu(), y_bus.shared_diag_lu()},
+          sparse_solver_{y_bus.shared_lu_symbolic()},
           perm_{static_cast<BlockPermArray>(n_bus_)} {}
 
     ShortCircuitSolverOutput<sym> run_short_circuit(YBus<sym> const& y_bus, ShortCircuitInput const& input) {
@@ -60,6 +60,8 @@ template <symmetry_tag sym> class ShortCircuitSolver {
         return output;
     }
 
+    void set_lu_parallelism(SparseLUParallelism const& parallelism) { sparse_solver_.set_parallelism(parallelism); }
+
   private:
     Idx n_bus_;
     Idx n_fault_;
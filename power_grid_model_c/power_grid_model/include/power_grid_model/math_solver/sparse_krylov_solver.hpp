@@ -0,0 +1,296 @@
+// SPDX-FileCopyrightText: Contributors to the Power Grid Model project <powergridmodel@lfenergy.org>
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#pragma once
+
+/*
+Iterative solve of a sparse matrix with the preconditioned BiCGSTAB method
+
+The direct LU factorization needs the fill-ins of the elimination, which get prohibitive in memory for very large grids.
+The Krylov solver only uses the sparsity pattern of the matrix itself, e.g. the pattern of the admittance matrix:
+    M = L * U                   incomplete LU factorization ILU(0), on the pattern of the matrix without fill-ins
+    x = A^-1 * b                BiCGSTAB iterations, right preconditioned with M^-1
+
+The iteration converges when the residual is reduced relative to the right hand side
+    ||b - A * x|| <= tolerance * ||b||      (euclidean norms over all buses and phases)
+The solve throws IterationDiverge if it did not converge within the maximum number of iterations,
+and SparseMatrixError if a pivot of the incomplete factorization is singular or the iteration breaks down.
+*/
+
+#include "sparse_lu_solver.hpp"
+
+#include "../common/common.hpp"
+#include "../common/exception.hpp"
+#include "../common/three_phase_tensor.hpp"
+
+#include <Eigen/Dense>
+
+#include <cassert>
+#include <cmath>
+#include <complex>
+#include <memory>
+#include <vector>
+
+namespace power_grid_model::math_solver {
+
+// selection of the Krylov solver instead of the direct LU solver, per math model
+struct SparseKrylovSettings {
+    static constexpr Idx default_min_size = 500000;
+    static constexpr double default_tolerance = 1e-12;
+    static constexpr Idx default_max_iter = 1000;
+
+    Idx min_size{default_min_size}; // math models with at least this number of buses use the Krylov solver
+    double tolerance{default_tolerance};
+    Idx max_iter{default_max_iter};
+};
+
+template <class Tensor, class RHSVector, class XVector> class SparseKrylovSolver {
+  public:
+    using entry_trait = sparse_lu_entry_trait<Tensor, RHSVector, XVector>;
+    static constexpr bool is_block = entry_trait::is_block;
+    static constexpr Idx block_size = entry_trait::block_size;
+    using Scalar = typename entry_trait::Scalar;
+
+    // csr structure of the matrix, the column indices are sorted per row
+    SparseKrylovSolver(std::shared_ptr<IdxVector const> row_indptr, std::shared_ptr<IdxVector const> col_indices,
+                       std::shared_ptr<IdxVector const> diag, SparseKrylovSettings const& settings = {})
+        : size_{static_cast<Idx>(diag->size())},
+          row_indptr_{std::move(row_indptr)},
+          col_indices_{std::move(col_indices)},
+          diag_{std::move(diag)},
+          settings_{settings} {}
+
+    // incomplete LU factorization of the matrix as preconditioner, the matrix is not changed
+    void prefactorize(std::vector<Tensor> const& data) {
+        auto const& row_indptr = *row_indptr_;
+        auto const& col_indices = *col_indices_;
+        auto const& diag = *diag_;
+        assert(static_cast<Idx>(data.size()) == row_indptr.back());
+
+        ilu_matrix_ = data;
+        pivot_inverse_.resize(size_);
+        for (Idx row = 0; row != size_; ++row) {
+            // L_row,k = A_row,k * U_k,k^-1, in increasing order of k < row
+            for (Idx l_idx = row_indptr[row]; l_idx != diag[row]; ++l_idx) {
+                Idx const k = col_indices[l_idx];
+                assert(k < row);
+                ilu_matrix_[l_idx] = dot(ilu_matrix_[l_idx], pivot_inverse_[k]);
+                // A_row,j = A_row,j - L_row,k * U_k,j, for j > k
+                // only for the entries in the pattern of the matrix, the fill-ins are dropped
+                Idx a_idx = l_idx + 1;
+                for (Idx u_idx = diag[k] + 1; u_idx != row_indptr[k + 1] && a_idx != row_indptr[row + 1];) {
+                    if (col_indices[u_idx] < col_indices[a_idx]) {
+                        ++u_idx;
+                    } else if (col_indices[a_idx] < col_indices[u_idx]) {
+                        ++a_idx;
+                    } else {
+                        ilu_matrix_[a_idx] -= dot(ilu_matrix_[l_idx], ilu_matrix_[u_idx]);
+                        ++u_idx;
+                        ++a_idx;
+                    }
+                }
+            }
+            pivot_inverse_[row] = invert_pivot(ilu_matrix_[diag[row]]);
+        }
+        is_factorized_ = true;
+    }
+
+    // solve with the preconditioner of prefactorize, rhs and x can be the same vector
+    // return the number of iterations
+    Idx solve_with_prefactorized_matrix(std::vector<Tensor> const& data, std::vector<RHSVector> const& rhs,
+                                        std::vector<XVector>& x) {
+        assert(is_factorized_);
+        b_ = rhs;
+        r_.resize(size_);
+        r0_.resize(size_);
+        p_.resize(size_);
+        v_.resize(size_);
+        preconditioned_.resize(size_);
+        t_.resize(size_);
+
+        double const b_norm = norm(b_);
+        for (Idx row = 0; row != size_; ++row) {
+            set_zero(x[row]);
+        }
+        if (b_norm == 0.0) {
+            return 0;
+        }
+        double const residual_tolerance = settings_.tolerance * b_norm;
+
+        // r = b - A * 0, r0 = r
+        r_ = b_;
+        r0_ = b_;
+        for (Idx row = 0; row != size_; ++row) {
+            set_zero(p_[row]);
+            set_zero(v_[row]);
+        }
+        Scalar rho{1.0};
+        Scalar alpha{1.0};
+        Scalar omega{1.0};
+        double residual_norm = b_norm;
+        for (Idx iter = 1; iter <= settings_.max_iter; ++iter) {
+            Scalar const rho_new = inner_product(r0_, r_);
+            if (!is_normal(rho_new) || !is_normal(omega)) {
+                throw SparseMatrixError{};
+            }
+            Scalar const beta = (rho_new / rho) * (alpha / omega);
+            rho = rho_new;
+            // p = r + beta * (p - omega * v)
+            for (Idx row = 0; row != size_; ++row) {
+                p_[row] = r_[row] + beta * (p_[row] - omega * v_[row]);
+            }
+            // v = A * M^-1 * p
+            apply_preconditioner(p_, preconditioned_);
+            multiply(data, preconditioned_, v_);
+            Scalar const r0_v = inner_product(r0_, v_);
+            if (!is_normal(r0_v)) {
+                throw SparseMatrixError{};
+            }
+            alpha = rho / r0_v;
+            // x = x + alpha * M^-1 * p, s = r - alpha * v, the residual r is overwritten with s
+            for (Idx row = 0; row != size_; ++row) {
+                x[row] += alpha * preconditioned_[row];
+                r_[row] -= alpha * v_[row];
+            }
+            residual_norm = norm(r_);
+            if (residual_norm <= residual_tolerance) {
+                return iter;
+            }
+            // t = A * M^-1 * s
+            apply_preconditioner(r_, preconditioned_);
+            multiply(data, preconditioned_, t_);
+            double const t_norm = norm(t_);
+            if (t_norm == 0.0) {
+                throw SparseMatrixError{};
+            }
+            omega = inner_product(t_, r_) / (t_norm * t_norm);
+            // x = x + omega * M^-1 * s, r = s - omega * t
+            for (Idx row = 0; row != size_; ++row) {
+                x[row] += omega * preconditioned_[row];
+                r_[row] -= omega * t_[row];
+            }
+            residual_norm = norm(r_);
+            if (residual_norm <= residual_tolerance) {
+                return iter;
+            }
+        }
+        throw IterationDiverge{settings_.max_iter, residual_norm / b_norm, settings_.tolerance};
+    }
+
+    Idx size() const { return size_; }
+
+    // memory of the preconditioner and the work vectors in bytes, the matrix itself is not included
+    size_t memory_usage() const {
+        return ilu_matrix_.capacity() * sizeof(Tensor) + pivot_inverse_.capacity() * sizeof(Tensor) +
+               (b_.capacity() + r_.capacity() + r0_.capacity() + p_.capacity() + v_.capacity() + t_.capacity()) *
+                   sizeof(RHSVector) +
+               preconditioned_.capacity() * sizeof(XVector);
+    }
+
+  private:
+    Idx size_;
+    std::shared_ptr<IdxVector const> row_indptr_;
+    std::shared_ptr<IdxVector const> col_indices_;
+    std::shared_ptr<IdxVector const> diag_;
+    SparseKrylovSettings settings_;
+
+    // incomplete factorization, with the inverse of the pivots of U
+    std::vector<Tensor> ilu_matrix_;
+    std::vector<Tensor> pivot_inverse_;
+    bool is_factorized_{false};
+    // work vectors of BiCGSTAB
+    std::vector<RHSVector> b_;
+    std::vector<RHSVector> r_;
+    std::vector<RHSVector> r0_;
+    std::vector<RHSVector> p_;
+    std::vector<RHSVector> v_;
+    std::vector<RHSVector> t_;
+    std::vector<XVector> preconditioned_;
+
+    static Tensor invert_pivot(Tensor const& pivot) {
+        if constexpr (is_block) {
+            using Matrix = typename entry_trait::Matrix;
+            Eigen::FullPivLU<Matrix> const lu{pivot.matrix()};
+            if (!lu.isInvertible() || !lu.inverse().allFinite()) {
+                throw SparseMatrixError{};
+            }
+            return lu.inverse().array();
+        } else {
+            if (!is_normal(pivot)) {
+                throw SparseMatrixError{};
+            }
+            return Tensor{1.0} / pivot;
+        }
+    }
+
+    template <class Vector> static void set_zero(Vector& value) {
+        if constexpr (is_block) {
+            value.setZero();
+        } else {
+            value = Vector{};
+        }
+    }
+
+    // conjugate inner product <x, y> = sum conj(x) * y
+    template <class Vector> static Scalar inner_product(std::vector<Vector> const& x, std::vector<Vector> const& y) {
+        Scalar result{};
+        for (size_t row = 0; row != x.size(); ++row) {
+            if constexpr (is_block) {
+                result += x[row].matrix().dot(y[row].matrix());
+            } else if constexpr (std::same_as<Scalar, double>) {
+                result += x[row] * y[row];
+            } else {
+                result += std::conj(x[row]) * y[row];
+            }
+        }
+        return result;
+    }
+
+    template <class Vector> static double norm(std::vector<Vector> const& x) {
+        double result = 0.0;
+        for (Vector const& value : x) {
+            if constexpr (is_block) {
+                result += value.abs2().sum();
+            } else {
+                result += std::norm(value);
+            }
+        }
+        return std::sqrt(result);
+    }
+
+    // y = A * x
+    void multiply(std::vector<Tensor> const& data, std::vector<XVector> const& x, std::vector<RHSVector>& y) const {
+        auto const& row_indptr = *row_indptr_;
+        auto const& col_indices = *col_indices_;
+        for (Idx row = 0; row != size_; ++row) {
+            set_zero(y[row]);
+            for (Idx idx = row_indptr[row]; idx != row_indptr[row + 1]; ++idx) {
+                y[row] += dot(data[idx], x[col_indices[idx]]);
+            }
+        }
+    }
+
+    // z = M^-1 * r = U^-1 * L^-1 * r
+    void apply_preconditioner(std::vector<RHSVector> const& r, std::vector<XVector>& z) const {
+        auto const& row_indptr = *row_indptr_;
+        auto const& col_indices = *col_indices_;
+        auto const& diag = *diag_;
+        // forward substitution with L, unit diagonal
+        for (Idx row = 0; row != size_; ++row) {
+            z[row] = r[row];
+            for (Idx l_idx = row_indptr[row]; l_idx != diag[row]; ++l_idx) {
+                z[row] -= dot(ilu_matrix_[l_idx], z[col_indices[l_idx]]);
+            }
+        }
+        // backward substitution with U
+        for (Idx row = size_ - 1; row != -1; --row) {
+            for (Idx u_idx = diag[row] + 1; u_idx != row_indptr[row + 1]; ++u_idx) {
+                z[row] -= dot(ilu_matrix_[u_idx], z[col_indices[u_idx]]);
+            }
+            z[row] = dot(pivot_inverse_[row], z[row]);
+        }
+    }
+};
+
+} // namespace power_grid_model::math_solver
@@ -0,0 +1,156 @@
+// SPDX-FileCopyrightText: Contributors to the Power Grid Model project <powergridmodel@lfenergy.org>
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#pragma once
+
+/*
+Low-rank update of a factorized sparse matrix, using the Sherman-Morrison-Woodbury formula
+
+The modified matrix only differs from the factorized matrix A in the rows and columns of a few buses
+    A' = A + P * D * P^T
+    P: n * m selection matrix of the m modified rows (bus and entry in the block)
+    D: m * m dense modification, e.g. minus the admittance stamp of a branch outage
+
+The solution of A' * x = b is calculated with the factorization of A
+    Z = A^-1 * P                    (m solves, once per update)
+    C = I + D * P^T * Z             (m * m dense capacitance matrix, once per update)
+    y = A^-1 * b                    (one solve per right hand side)
+    x = y - Z * C^-1 * D * P^T * y
+
+A singular capacitance matrix means that the modified matrix is singular,
+e.g. when a branch outage splits off part of the grid without any connection to the ground.
+The modified system should then be solved with a full factorization of the new matrix (or topology).
+*/
+
+#include "sparse_lu_solver.hpp"
+
+#include "../common/common.hpp"
+#include "../common/exception.hpp"
+
+#include <Eigen/Dense>
+
+#include <cassert>
+#include <vector>
+
+namespace power_grid_model::math_solver {
+
+template <class Tensor, class RHSVector, class XVector> class SparseLULowRankUpdate {
+  public:
+    using SolverType = SparseLUSolver<Tensor, RHSVector, XVector>;
+    using BlockPermArray = typename SolverType::BlockPermArray;
+    using Scalar = typename SolverType::Scalar;
+    static constexpr bool is_block = SolverType::is_block;
+    static constexpr Idx block_size = SolverType::block_size;
+    using DenseMatrix = Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic>;
+    using DenseVector = Eigen::Matrix<Scalar, Eigen::Dynamic, 1>;
+
+    // solver, lu_data and block_perm_array contain the factorization of A
+    // the update does not refer to them, solve should be called with the same factorization
+    // so the update can be kept next to a factorization that is copied or moved
+    // buses are the modified rows and columns of the matrix
+    // delta is the modification, delta[i * n_buses + j] is added to the entry (buses[i], buses[j])
+    SparseLULowRankUpdate(SolverType& solver, std::vector<Tensor> const& lu_data,
+                          BlockPermArray const& block_perm_array, IdxVector buses, std::vector<Tensor> const& delta)
+        : buses_{std::move(buses)},
+          rank_{static_cast<Idx>(buses_.size()) * block_size},
+          delta_(rank_, rank_),
+          z_(rank_) {
+        Idx const n_buses = static_cast<Idx>(buses_.size());
+        assert(static_cast<Idx>(delta.size()) == n_buses * n_buses);
+        for (Idx i = 0; i != n_buses; ++i) {
+            for (Idx j = 0; j != n_buses; ++j) {
+                for (Idx block_row = 0; block_row != block_size; ++block_row) {
+                    for (Idx block_col = 0; block_col != block_size; ++block_col) {
+                        delta_(i * block_size + block_row, j * block_size + block_col) =
+                            entry(delta[i * n_buses + j], block_row, block_col);
+                    }
+                }
+            }
+        }
+
+        // Z = A^-1 * P, column per modified row
+        Idx const size = solver.size();
+        DenseMatrix selected_z(rank_, rank_);
+        for (Idx col = 0; col != rank_; ++col) {
+            std::vector<RHSVector> unit(size, zero_vector<RHSVector>());
+            component(unit[buses_[col / block_size]], col % block_size) = Scalar{1.0};
+            z_[col].resize(size);
+            solver.solve_with_prefactorized_matrix(lu_data, block_perm_array, unit, z_[col]);
+            for (Idx row = 0; row != rank_; ++row) {
+                selected_z(row, col) = component(z_[col][buses_[row / block_size]], row % block_size);
+            }
+        }
+
+        // C = I + D * P^T * Z
+        capacitance_.compute(DenseMatrix::Identity(rank_, rank_) + delta_ * selected_z);
+    }
+
+    // the update of n_buses buses costs a solve per modified row, and a correction for each of the n_solves solves
+    // the alternative is to refactorize the modified matrix, and to refactorize again once the original is restored
+    // the work is counted in block operations, in the same way as SparseLUSolver::refactorization_work
+    static bool is_cheaper_than_refactorization(SolverType const& solver, IdxVector const& changed_entries,
+                                                Idx n_buses, Idx n_solves) {
+        return n_buses * (solver.nnz() + n_solves * solver.size()) < 2 * solver.refactorization_work(changed_entries);
+    }
+
+    // the modified matrix is singular, the update cannot be used
+    bool is_singular() const { return !capacitance_.isInvertible(); }
+
+    // solve A' * x = b, with the factorization of A
+    void solve(SolverType& solver, std::vector<Tensor> const& lu_data, BlockPermArray const& block_perm_array,
+               std::vector<RHSVector> const& rhs, std::vector<XVector>& x) const {
+        if (is_singular()) {
+            throw SparseMatrixError{};
+        }
+        // y = A^-1 * b
+        solver.solve_with_prefactorized_matrix(lu_data, block_perm_array, rhs, x);
+        // t = C^-1 * D * P^T * y
+        DenseVector selected_y(rank_);
+        for (Idx row = 0; row != rank_; ++row) {
+            selected_y(row) = component(x[buses_[row / block_size]], row % block_size);
+        }
+        DenseVector const t = capacitance_.solve(delta_ * selected_y);
+        // x = y - Z * t
+        for (Idx col = 0; col != rank_; ++col) {
+            for (Idx row = 0; row != static_cast<Idx>(x.size()); ++row) {
+                x[row] -= z_[col][row] * t(col);
+            }
+        }
+    }
+
+    Idx rank() const { return rank_; }
+
+  private:
+    IdxVector buses_;
+    Idx rank_;
+    DenseMatrix delta_;
+    std::vector<std::vector<XVector>> z_;
+    Eigen::FullPivLU<DenseMatrix> capacitance_;
+
+    static Scalar entry(Tensor const& value, [[maybe_unused]] Idx block_row, [[maybe_unused]] Idx block_col) {
+        if constexpr (is_block) {
+            return value(block_row, block_col);
+        } else {
+            return value;
+        }
+    }
+
+    template <class Vector> static auto& component(Vector& value, [[maybe_unused]] Idx block_row) {
+        if constexpr (is_block) {
+            return value(block_row);
+        } else {
+            return value;
+        }
+    }
+
+    template <class Vector> static Vector zero_vector() {
+        if constexpr (is_block) {
+            return Vector::Zero();
+        } else {
+            return Vector{};
+        }
+    }
+};
+
+} // namespace power_grid_model::math_solver
@@ -0,0 +1,279 @@
+// SPDX-FileCopyrightText: Contributors to the Power Grid Model project <powergridmodel@lfenergy.org>
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#pragma once
+
+/*
+Mixed precision solve of a sparse matrix, with a single precision LU factorization and iterative refinement
+
+The factorization and the triangular solves are memory-bandwidth bound for large matrices.
+The LU matrix is stored in single precision, which halves the memory traffic of the factorization and the solves.
+The double precision accuracy is recovered with iterative refinement against the double precision matrix A
+    x_0 = (LU)^-1 * b                   (single precision solve)
+    r_k = b - A * x_k                   (double precision residual)
+    x_k+1 = x_k + (LU)^-1 * r_k         (single precision solve of the correction)
+
+The refinement stops when the backward error is at the level of the rounding errors of double precision
+    ||r_k|| <= sqrt(n) * eps * ||A|| * ||x_k||      (infinity norms)
+so the solution is as accurate as the solution of a double precision factorization.
+
+The refinement converges if the condition number of A is well below the inverse of the single precision epsilon.
+It falls back to a double precision factorization of A if
+    the matrix cannot be represented or factorized in single precision,
+    or the residual is not halved in a refinement step (the refinement stalls),
+    or the refinement did not converge within the maximum number of steps.
+This can happen for badly conditioned matrices, e.g. the gain matrix of a state estimation with large weights.
+The fallback is kept until the next factorization.
+
+It is used for the gain matrix of the iterative linear state estimation if the se_mixed_precision option is set.
+*/
+
+#include "sparse_lu_solver.hpp"
+#include "sparse_lu_symbolic.hpp"
+
+#include "../common/common.hpp"
+#include "../common/exception.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <complex>
+#include <limits>
+#include <memory>
+#include <vector>
+
+namespace power_grid_model::math_solver {
+
+namespace detail {
+template <class T> struct single_precision;
+template <> struct single_precision<double> {
+    using type = float;
+};
+template <> struct single_precision<DoubleComplex> {
+    using type = std::complex<float>;
+};
+template <class T>
+    requires eigen_array<T>
+struct single_precision<T> {
+    using type = Eigen::Array<typename single_precision<typename T::Scalar>::type, T::RowsAtCompileTime,
+                              T::ColsAtCompileTime, T::Options>;
+};
+template <class T> using single_precision_t = typename single_precision<T>::type;
+} // namespace detail
+
+template <class Tensor, class RHSVector, class XVector> class SparseLUMixedPrecisionSolver {
+  public:
+    using DoubleSolverType = SparseLUSolver<Tensor, RHSVector, XVector>;
+    using SingleTensor = detail::single_precision_t<Tensor>;
+    using SingleRHSVector = detail::single_precision_t<RHSVector>;
+    using SingleXVector = detail::single_precision_t<XVector>;
+    using SingleSolverType = SparseLUSolver<SingleTensor, SingleRHSVector, SingleXVector>;
+    static constexpr bool is_block = DoubleSolverType::is_block;
+    static constexpr Idx block_size = DoubleSolverType::block_size;
+
+    static constexpr Idx max_refinement_steps = 10;
+    // the residual should at least be halved in every refinement step
+    static constexpr double refinement_stall_ratio = 0.5;
+
+    explicit SparseLUMixedPrecisionSolver(std::shared_ptr<SparseLUSymbolic const> const& symbolic)
+        : symbolic_{symbolic},
+          single_solver_{symbolic},
+          double_solver_{symbolic},
+          refinement_tolerance_{std::numeric_limits<double>::epsilon() *
+                                std::sqrt(static_cast<double>(symbolic->size() * block_size))} {
+        if constexpr (is_block) {
+            single_block_perm_.resize(symbolic_->size());
+            double_block_perm_.resize(symbolic_->size());
+        }
+    }
+
+    // factorize the matrix in single precision
+    // matrix contains the entries of the LU pattern with zero fill-ins, it is not changed
+    // matrix is used for the refinement and should outlive the factorization
+    void prefactorize(std::vector<Tensor> const& matrix) {
+        assert(static_cast<Idx>(matrix.size()) == symbolic_->nnz());
+        matrix_ = &matrix;
+        double_precision_ = false;
+        n_refinement_steps_ = 0;
+
+        // infinity norm of the matrix, and conversion to single precision
+        double max_entry = 0.0;
+        std::vector<double> row_norm(symbolic_->size() * block_size, 0.0);
+        single_data_.resize(matrix.size());
+        for (Idx row = 0; row != symbolic_->size(); ++row) {
+            for (Idx idx = symbolic_->row_indptr[row]; idx != symbolic_->row_indptr[row + 1]; ++idx) {
+                for (Idx block_row = 0; block_row != block_size; ++block_row) {
+                    for (Idx block_col = 0; block_col != block_size; ++block_col) {
+                        double const abs_entry = std::sqrt(std::norm(entry(matrix[idx], block_row, block_col)));
+                        max_entry = std::max(max_entry, abs_entry);
+                        row_norm[row * block_size + block_row] += abs_entry;
+                    }
+                }
+                single_data_[idx] = to_single<SingleTensor>(matrix[idx]);
+            }
+        }
+        matrix_norm_ = row_norm.empty() ? 0.0 : std::ranges::max(row_norm);
+
+        // also catches nan and inf
+        if (!(max_entry < static_cast<double>(std::numeric_limits<float>::max()))) {
+            fallback_to_double_precision();
+            return;
+        }
+        try {
+            single_solver_.prefactorize(single_data_, single_block_perm_);
+        } catch (SparseMatrixError const&) {
+            fallback_to_double_precision();
+        }
+    }
+
+    // solve with the factorized matrix
+    // the solution has the accuracy of a double precision solve
+    void solve_with_prefactorized_matrix(std::vector<RHSVector> const& rhs, std::vector<XVector>& x) {
+        assert(matrix_ != nullptr);
+        n_refinement_steps_ = 0;
+        if (double_precision_) {
+            double_solver_.solve_with_prefactorized_matrix(double_data_, double_block_perm_, rhs, x);
+            return;
+        }
+
+        single_rhs_.resize(rhs.size());
+        single_x_.resize(rhs.size());
+        residual_.resize(rhs.size());
+        for (size_t row = 0; row != rhs.size(); ++row) {
+            single_rhs_[row] = to_single<SingleRHSVector>(rhs[row]);
+        }
+        single_solver_.solve_with_prefactorized_matrix(single_data_, single_block_perm_, single_rhs_, single_x_);
+        for (size_t row = 0; row != rhs.size(); ++row) {
+            x[row] = to_double<XVector>(single_x_[row]);
+        }
+
+        double previous_residual_norm = std::numeric_limits<double>::infinity();
+        for (;; ++n_refinement_steps_) {
+            double const residual_norm = calculate_residual(rhs, x);
+            if (residual_norm <= refinement_tolerance_ * matrix_norm_ * max_abs(x)) {
+                return;
+            }
+            // also catches nan
+            if (n_refinement_steps_ == max_refinement_steps ||
+                !(residual_norm < refinement_stall_ratio * previous_residual_norm)) {
+                break;
+            }
+            previous_residual_norm = residual_norm;
+
+            // x = x + (LU)^-1 * r
+            for (size_t row = 0; row != rhs.size(); ++row) {
+                single_rhs_[row] = to_single<SingleRHSVector>(residual_[row]);
+            }
+            single_solver_.solve_with_prefactorized_matrix(single_data_, single_block_perm_, single_rhs_, single_x_);
+            for (size_t row = 0; row != rhs.size(); ++row) {
+                x[row] += to_double<XVector>(single_x_[row]);
+            }
+        }
+
+        // the refinement stalled, solve again in double precision
+        fallback_to_double_precision();
+        double_solver_.solve_with_prefactorized_matrix(double_data_, double_block_perm_, rhs, x);
+    }
+
+    void prefactorize_and_solve(std::vector<Tensor> const& matrix, std::vector<RHSVector> const& rhs,
+                                std::vector<XVector>& x) {
+        prefactorize(matrix);
+        solve_with_prefactorized_matrix(rhs, x);
+    }
+
+    Idx size() const { return symbolic_->size(); }
+
+    void set_parallelism(SparseLUParallelism const& parallelism) {
+        single_solver_.set_parallelism(parallelism);
+        double_solver_.set_parallelism(parallelism);
+    }
+
+    // the matrix is factorized in double precision, because the single precision solve did not converge
+    bool is_double_precision() const { return double_precision_; }
+    // number of refinement steps of the last solve
+    Idx n_refinement_steps() const { return n_refinement_steps_; }
+
+  private:
+    std::shared_ptr<SparseLUSymbolic const> symbolic_;
+    SingleSolverType single_solver_;
+    DoubleSolverType double_solver_;
+    double refinement_tolerance_;
+
+    std::vector<Tensor> const* matrix_{nullptr};
+    double matrix_norm_{};
+    bool double_precision_{false};
+    Idx n_refinement_steps_{};
+
+    // factorization in single precision
+    std::vector<SingleTensor> single_data_;
+    typename SingleSolverType::BlockPermArray single_block_perm_{};
+    // factorization in double precision, only after a fallback
+    std::vector<Tensor> double_data_;
+    typename DoubleSolverType::BlockPermArray double_block_perm_{};
+    // buffers of the refinement
+    std::vector<SingleRHSVector> single_rhs_;
+    std::vector<SingleXVector> single_x_;
+    std::vector<RHSVector> residual_;
+
+    void fallback_to_double_precision() {
+        double_precision_ = true;
+        single_data_ = {};
+        double_data_ = *matrix_;
+        double_solver_.prefactorize(double_data_, double_block_perm_);
+    }
+
+    // r = b - A * x in double precision, return the infinity norm of r
+    double calculate_residual(std::vector<RHSVector> const& rhs, std::vector<XVector> const& x) {
+        auto const& row_indptr = symbolic_->row_indptr;
+        auto const& col_indices = symbolic_->col_indices;
+        std::vector<Tensor> const& matrix = *matrix_;
+        for (Idx row = 0; row != symbolic_->size(); ++row) {
+            RHSVector& r = residual_[row];
+            r = rhs[row];
+            for (Idx idx = row_indptr[row]; idx != row_indptr[row + 1]; ++idx) {
+                r -= dot(matrix[idx], x[col_indices[idx]]);
+            }
+        }
+        return max_abs(residual_);
+    }
+
+    // compare squared magnitudes, which avoids the square roots of complex abs
+    template <class Vector> static double max_abs(std::vector<Vector> const& values) {
+        double result = 0.0;
+        for (Vector const& value : values) {
+            if constexpr (is_block) {
+                result = std::max(result, static_cast<double>(value.abs2().maxCoeff()));
+            } else {
+                result = std::max(result, static_cast<double>(std::norm(value)));
+            }
+        }
+        return std::sqrt(result);
+    }
+
+    static auto entry(Tensor const& value, [[maybe_unused]] Idx block_row, [[maybe_unused]] Idx block_col) {
+        if constexpr (is_block) {
+            return value(block_row, block_col);
+        } else {
+            return value;
+        }
+    }
+
+    template <class Single, class Double> static Single to_single(Double const& value) {
+        if constexpr (is_block) {
+            return value.template cast<typename Single::Scalar>();
+        } else {
+            return static_cast<Single>(value);
+        }
+    }
+
+    template <class Double, class Single> static Double to_double(Single const& value) {
+        if constexpr (is_block) {
+            return value.template cast<typename Double::Scalar>();
+        } else {
+            return static_cast<Double>(value);
+        }
+    }
+};
+
+} // namespace power_grid_model::math_solver
@@ -8,15 +8,27 @@
 #include "../common/exception.hpp"
 #include "../common/three_phase_tensor.hpp"
 #include "../common/typing.hpp"
+#include "../thread_pool.hpp"
+#include "sparse_lu_symbolic.hpp"
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <barrier>
+#include <complex>
+#include <limits>
 #include <memory>
 
 namespace power_grid_model::math_solver {
 
 template <class Tensor, class RHSVector, class XVector, class = void> struct sparse_lu_entry_trait;
 
+// the matrix can also be factorized in single precision, see SparseLUMixedPrecisionSolver
+template <class T>
+concept lu_scalar_value = scalar_value<T> || std::same_as<T, float> || std::same_as<T, std::complex<float>>;
+
 template <class Tensor, class RHSVector, class XVector>
-concept scalar_value_lu = scalar_value<Tensor> && std::same_as<Tensor, RHSVector> && std::same_as<Tensor, XVector>;
+concept scalar_value_lu = lu_scalar_value<Tensor> && std::same_as<Tensor, RHSVector> && std::same_as<Tensor, XVector>;
 
 // TODO(mgovers) improve this concept
 template <class Derived> int check_array_base(Eigen::ArrayBase<Derived> const& /* array_base */) { return 0; }
@@ -34,7 +46,7 @@ concept tensor_lu =
     matrix_multiplicable<Tensor, RHSVector> && matrix_multiplicable<Tensor, XVector> &&
     std::same_as<typename Tensor::Scalar, typename RHSVector::Scalar> && // all entries should have same scalar type
     std::same_as<typename Tensor::Scalar, typename XVector::Scalar> &&   // all entries should have same scalar type
-    scalar_value<typename Tensor::Scalar>;                               // scalar can only be double or complex double
+    lu_scalar_value<typename Tensor::Scalar>; // scalar can only be (complex) double, or (complex) float
 
 template <class Tensor, class RHSVector, class XVector>
     requires scalar_value_lu<Tensor, RHSVector, XVector>
@@ -43,7 +55,6 @@ struct sparse_lu_entry_trait<Tensor, RHSVector, XVector> {
     static constexpr Idx block_size = 1;
     using Scalar = Tensor;
     using Matrix = Tensor;
-    using LUFactor = void;
     struct BlockPerm {};
     using BlockPermArray = Idx;
 };
@@ -55,32 +66,47 @@ struct sparse_lu_entry_trait<Tensor, RHSVector, XVector> {
     static constexpr Idx block_size = Tensor::RowsAtCompileTime;
     using Scalar = typename Tensor::Scalar;
     using Matrix = Eigen::Matrix<Scalar, block_size, block_size, Tensor::Options>;
-    using LUFactor = Eigen::FullPivLU<Eigen::Ref<Matrix>>; // LU decomposition with full pivoting in place
+    // row permutation of the dense LU decomposition of a pivot block, the columns are never permuted
+    // row i of the factorized block is row p[i] of the original block
     struct BlockPerm {
-        typename LUFactor::PermutationPType p;
-        typename LUFactor::PermutationQType q;
-    }; // Extract permutation matrices p and q from LUFactor
+        std::array<IntS, block_size> p{};
+        bool permuted{false}; // most pivot blocks are factorized without row swaps
+
+        friend bool operator==(BlockPerm const&, BlockPerm const&) = default;
+    };
+    static_assert(block_size <= std::numeric_limits<IntS>::max());
     using BlockPermArray = std::vector<BlockPerm>;
 };
 
+// threads to run the factorization and the triangular solves of large matrices in parallel
+// the rows are processed level by level in the elimination tree, rows in the same level are independent
+// the results do not depend on the number of threads
+struct SparseLUParallelism {
+    static constexpr Idx default_min_size = 1000;
+
+    ThreadPool* thread_pool{nullptr}; // no parallel calculation without thread pool
+    Idx n_threads{1};
+    Idx min_size{default_min_size}; // matrices with less block rows are calculated sequentially
+};
+
 template <class Tensor, class RHSVector, class XVector> class SparseLUSolver {
   public:
     using entry_trait = sparse_lu_entry_trait<Tensor, RHSVector, XVector>;
     static constexpr bool is_block = entry_trait::is_block;
     static constexpr Idx block_size = entry_trait::block_size;
     using Scalar = typename entry_trait::Scalar;
-    using LUFactor = typename entry_trait::LUFactor;
     using BlockPerm = typename entry_trait::BlockPerm;
     using BlockPermArray = typename entry_trait::BlockPermArray;
 
+    explicit SparseLUSolver(std::shared_ptr<SparseLUSymbolic const> symbolic)
+        : size_{symbolic->size()}, nnz_{symbolic->nnz()}, symbolic_{std::move(symbolic)} {}
+
     SparseLUSolver(std::shared_ptr<IdxVector const> const& row_indptr, // indptr including fill-ins
-                   std::shared_ptr<IdxVector const> col_indices,       // indices including fill-ins
-                   std::shared_ptr<IdxVector const> diag_lu)
-        : size_{static_cast<Idx>(row_indptr->size()) - 1},
-          nnz_{row_indptr->back()},
-          row_indptr_{row_indptr},
-          col_indices_{std::move(col_indices)},
-          diag_lu_{std::move(diag_lu)} {}
+                   std::shared_ptr<IdxVector const> const& col_indices, // indices including fill-ins
+                   [[maybe_unused]] std::shared_ptr<IdxVector const> const& diag_lu)
+        : SparseLUSolver{std::make_shared<SparseLUSymbolic const>(*row_indptr, *col_indices)} {
+        assert(symbolic_->diag == *diag_lu);
+    }
 
     // solve with new matrix data, need to factorize first
     void
@@ -97,74 +123,78 @@ template <class Tensor, class RHSVector, class XVector> class SparseLUSolver {
     solve_with_prefactorized_matrix(std::vector<Tensor> const& data,        // pre-factoirzed data, const ref
                                     BlockPermArray const& block_perm_array, // pre-calculated permutation, const ref
                                     std::vector<RHSVector> const& rhs, std::vector<XVector>& x) {
-        // local reference
-        auto const& row_indptr = *row_indptr_;
-        auto const& col_indices = *col_indices_;
-        auto const& diag_lu = *diag_lu_;
-        auto const& lu_matrix = data;
-
-        // forward substitution with L
-        for (Idx row = 0; row != size_; ++row) {
-            // permutation if needed
-            if constexpr (is_block) {
-                x[row] = (block_perm_array[row].p * rhs[row].matrix()).array();
-            } else {
-                x[row] = rhs[row];
+        if (is_parallel()) {
+            // forward substitution with L, a row depends on its descendants in the elimination tree
+            run_levels(false, [&](Idx row) { forward_substitute_row(row, data, block_perm_array, rhs, x); });
+            // backward substitution with U, a row depends on its ancestors in the elimination tree
+            run_levels(true, [&](Idx row) { backward_substitute_row(row, data, x); });
+        } else {
+            for (Idx row = 0; row != size_; ++row) {
+                forward_substitute_row(row, data, block_perm_array, rhs, x);
             }
-
-            // loop all columns until diagonal
-            for (Idx l_idx = row_indptr[row]; l_idx < diag_lu[row]; ++l_idx) {
-                Idx const col = col_indices[l_idx];
-                // never overshoot
-                assert(col < row);
-                // forward subtract
-                x[row] -= dot(lu_matrix[l_idx], x[col]);
-            }
-            // forward substitution inside block, for block matrix
-            if constexpr (is_block) {
-                XVector& xb = x[row];
-                Tensor const& pivot = lu_matrix[diag_lu[row]];
-                for (Idx br = 0; br < block_size; ++br) {
-                    for (Idx bc = 0; bc < br; ++bc) {
-                        xb(br) -= pivot(br, bc) * xb(bc);
-                    }
-                }
+            for (Idx row = size_ - 1; row != -1; --row) {
+                backward_substitute_row(row, data, x);
             }
         }
+    }
 
-        // backward substitution with U
-        for (Idx row = size_ - 1; row != -1; --row) {
-            // loop all columns from diagonal
-            for (Idx u_idx = row_indptr[row + 1] - 1; u_idx > diag_lu[row]; --u_idx) {
-                Idx const col = col_indices[u_idx];
-                // always in upper diagonal
-                assert(col > row);
-                // backward subtract
-                x[row] -= dot(lu_matrix[u_idx], x[col]);
-            }
-            // solve the diagonal pivot
-            if constexpr (is_block) {
-                // backward substitution inside block
-                XVector& xb = x[row];
-                Tensor const& pivot = lu_matrix[diag_lu[row]];
-                for (Idx br = block_size - 1; br != -1; --br) {
-                    for (Idx bc = block_size - 1; bc > br; --bc) {
-                        xb(br) -= pivot(br, bc) * xb(bc);
-                    }
-                    xb(br) = xb(br) / pivot(br, br);
+    // solve with existing pre-factorization for a sparse right hand side and a sparse subset of the solution
+    // rhs is a full vector, but only the entries in rhs_rows can be non-zero, the other entries should be zero
+    // only the solution at x_rows is calculated, the other entries of x are undefined
+    // with the elimination tree, the rows of the forward substitution are the reach of rhs_rows,
+    //    i.e. the rows on the paths from rhs_rows to the root
+    // the rows of the backward substitution are the paths from x_rows to the root,
+    //    x of a row only depends on the ancestors of the row
+    // the calculation is proportional to the size of the reach instead of the size of the matrix
+    void solve_sparse_with_prefactorized_matrix(std::vector<Tensor> const& data,
+                                                BlockPermArray const& block_perm_array,
+                                                std::vector<RHSVector> const& rhs, IdxVector const& rhs_rows,
+                                                IdxVector const& x_rows, std::vector<XVector>& x) {
+        // stamp per row, to mark the reach without clearing all rows
+        if (reach_stamp_.empty()) {
+            reach_stamp_.resize(size_, 0);
+        }
+        Idx const forward_stamp = ++stamp_counter_;
+        collect_reach(rhs_rows, forward_stamp, forward_reach_);
+        for (Idx const row : forward_reach_) {
+            forward_substitute_row(row, data, block_perm_array, rhs, x,
+                                   [this, forward_stamp](Idx col) { return reach_stamp_[col] == forward_stamp; });
+        }
+
+        Idx const backward_stamp = ++stamp_counter_;
+        collect_reach(x_rows, backward_stamp, backward_reach_);
+        // the rows outside the forward reach have a zero result of the forward substitution
+        for (Idx const row : backward_reach_) {
+            if (!std::ranges::binary_search(forward_reach_, row)) {
+                if constexpr (is_block) {
+                    x[row].setZero();
+                } else {
+                    x[row] = XVector{};
                 }
-            } else {
-                x[row] = x[row] / lu_matrix[diag_lu[row]];
             }
         }
-        // restore permutation for block matrix
-        if constexpr (is_block) {
-            for (Idx row = 0; row != size_; ++row) {
-                x[row] = (block_perm_array[row].q * x[row].matrix()).array();
-            }
+        for (auto it = backward_reach_.crbegin(); it != backward_reach_.crend(); ++it) {
+            backward_substitute_row(*it, data, x);
         }
     }
 
+    Idx size() const { return size_; }
+    Idx nnz() const { return nnz_; }
+
+    // work of refactorize for the changed entries, in number of pivots and updates, see affected_work
+    Idx refactorization_work(IdxVector const& changed_entries) const {
+        std::vector<bool> affected(size_, false);
+        Idx const partial_work = affected_work(changed_entries, affected);
+        return 2 * partial_work > full_work() ? full_work() : partial_work;
+    }
+
+    // use the threads of the parallelism for matrices that are large enough
+    void set_parallelism(SparseLUParallelism const& parallelism) { parallelism_ = parallelism; }
+
+    bool is_parallel() const {
+        return parallelism_.thread_pool != nullptr && n_workers() > 1 && size_ >= parallelism_.min_size;
+    }
+
     // prefactorize in-place
     // the LU matrix has the form A = L * U
     // diagonals of L are one
@@ -172,64 +202,43 @@ template <class Tensor, class RHSVector, class XVector> class SparseLUSolver {
     // fill-ins should be pre-allocated with zero
     // block permutation array should be pre-allocated
     void prefactorize(std::vector<Tensor>& data, BlockPermArray& block_perm_array) {
+        if (is_parallel()) {
+            prefactorize_parallel(data, block_perm_array);
+            return;
+        }
+
         // local reference
-        auto const& row_indptr = *row_indptr_;
-        auto const& col_indices = *col_indices_;
-        auto const& diag_lu = *diag_lu_;
+        auto const& row_indptr = symbolic_->row_indptr;
+        auto const& col_indices = symbolic_->col_indices;
+        auto const& diag_lu = symbolic_->diag;
+        auto const& transpose_entry = symbolic_->transpose_entry;
+        auto const& update_entry = symbolic_->update_entry;
+        bool const has_update_entry = symbolic_->has_update_entry();
         // lu matrix inplace
         std::vector<Tensor>& lu_matrix = data;
 
-        // column position idx per row for LU matrix
-        IdxVector col_position_idx(row_indptr.cbegin(), row_indptr.cend() - 1);
+        // position in the pre-computed entries to update, they are visited in the same order
+        Idx update_idx = 0;
 
         // start pivoting, it is always the diagonal
         for (Idx pivot_row_col = 0; pivot_row_col != size_; ++pivot_row_col) {
             Idx const pivot_idx = diag_lu[pivot_row_col];
 
             // Dense LU factorize pivot for block matrix in-place
-            // A_pivot,pivot, becomes P_pivot^-1 * L_pivot * U_pivot * Q_pivot^-1
+            // A_pivot,pivot, becomes P_pivot^-1 * L_pivot * U_pivot
             // return reference to pivot permutation
-            BlockPerm const& block_perm = [&]() -> std::conditional_t<is_block, BlockPerm const&, BlockPerm> {
-                if constexpr (is_block) {
-                    LUFactor lu_factor(lu_matrix[pivot_idx]);
-                    // set a low threshold, because state estimation can have large differences in eigen values
-                    lu_factor.setThreshold(1e-100);
-                    if (lu_factor.rank() < block_size) {
-                        throw SparseMatrixError{};
-                    }
-                    // record block permutation
-                    block_perm_array[pivot_row_col] = {lu_factor.permutationP(), lu_factor.permutationQ()};
-                    return block_perm_array[pivot_row_col];
-                } else {
-                    if (!is_normal(lu_matrix[pivot_idx])) {
-                        throw SparseMatrixError{};
-                    }
-                    return {};
-                }
-            }();
+            BlockPerm const& block_perm = factorize_pivot(lu_matrix[pivot_idx], block_perm_array, pivot_row_col);
             // reference to pivot
             Tensor const& pivot = lu_matrix[pivot_idx];
 
             // for block matrix
             // permute rows of L's in the left of the pivot
             // L_k,pivot = P_pivot * L_k,pivot    k < pivot
-            // permute columns of U's above the pivot
-            // U_pivot,k = U_pivot,k * Q_pivot    k < pivot
             if constexpr (is_block) {
-                // loop rows and columns at the same time
-                // since the matrix is symmetric
-                for (Idx l_idx = row_indptr[pivot_row_col]; l_idx < pivot_idx; ++l_idx) {
-                    // permute rows of L_k,pivot
-                    lu_matrix[l_idx] = (block_perm.p * lu_matrix[l_idx].matrix()).array();
-                    // get row and idx of u
-                    Idx const u_row = col_indices[l_idx];
-                    Idx const u_idx = col_position_idx[u_row];
-                    // we should exactly find the current column
-                    assert(col_indices[u_idx] == pivot_row_col);
-                    // permute columns of U_pivot,k
-                    lu_matrix[u_idx] = (lu_matrix[u_idx].matrix() * block_perm.q).array();
-                    // increment column position
-                    ++col_position_idx[u_row];
+                if (block_perm.permuted) {
+                    for (Idx l_idx = row_indptr[pivot_row_col]; l_idx < pivot_idx; ++l_idx) {
+                        permute_rows(block_perm, lu_matrix[l_idx]);
+                    }
                 }
             }
 
@@ -240,7 +249,7 @@ template <class Tensor, class RHSVector, class XVector> class SparseLUSolver {
                 for (Idx u_idx = pivot_idx + 1; u_idx < row_indptr[pivot_row_col + 1]; ++u_idx) {
                     Tensor& u = lu_matrix[u_idx];
                     // permutation
-                    u = (block_perm.p * u.matrix()).array();
+                    permute_rows(block_perm, u);
                     // forward substitution, per row in u
                     for (Idx block_row = 0; block_row < block_size; ++block_row) {
                         for (Idx block_col = 0; block_col < block_row; ++block_col) {
@@ -256,19 +265,14 @@ template <class Tensor, class RHSVector, class XVector> class SparseLUSolver {
             //    looking for col_indices at pivot_row_col, starting from the diagonal (pivot_row_col, pivot_row_col)
             //    we get also the non-zero row indices under the pivot
             for (Idx l_ref_idx = pivot_idx + 1; l_ref_idx < row_indptr[pivot_row_col + 1]; ++l_ref_idx) {
-                // find index of l in corresponding row
-                Idx const l_row = col_indices[l_ref_idx];
-                Idx const l_idx = col_position_idx[l_row];
-                // we should exactly find the current column
-                assert(col_indices[l_idx] == pivot_row_col);
+                // index of l in corresponding row
+                Idx const l_idx = transpose_entry[l_ref_idx];
                 // calculating l at (l_row, pivot_row_col)
                 if constexpr (is_block) {
                     // for block matrix
                     // calculate L blocks below the pivot, in-place
-                    // L_k,pivot * U_pivot = A_k_pivot * Q_pivot    k > pivot
+                    // L_k,pivot * U_pivot = A_k_pivot    k > pivot
                     Tensor& l = lu_matrix[l_idx];
-                    // permutation
-                    l = (l.matrix() * block_perm.q).array();
                     // forward substitution, per column in l
                     // l0 = [l00, l10]^T
                     // l1 = [l01, l11]^T
@@ -298,36 +302,410 @@ template <class Tensor, class RHSVector, class XVector> class SparseLUSolver {
                 //          for u_col > pivot_row_col
                 // it can create fill-ins, but the fill-ins are pre-allocated
                 // it is garanteed to have an entry at (l_row, u_col), if (pivot_row_col, u_col) is non-zero
-                // starting A index from (l_row, pivot_row_col)
-                Idx a_idx = l_idx;
+                // the index of the entry at (l_row, u_col) is pre-computed in the symbolic factorization,
+                //    or found by a merge walk through row l_row, starting from (l_row, pivot_row_col)
                 // loop all columns in the right of (pivot_row_col, pivot_row_col), at pivot_row
-                for (Idx u_idx = pivot_idx + 1; u_idx < row_indptr[pivot_row_col + 1]; ++u_idx) {
-                    Idx const u_col = col_indices[u_idx];
-                    assert(u_col > pivot_row_col);
-                    // search the a_idx to the u_col,
-                    auto const found = std::lower_bound(col_indices.cbegin() + a_idx,
-                                                        col_indices.cbegin() + row_indptr[l_row + 1], u_col);
-                    // should always found
-                    assert(found != col_indices.cbegin() + row_indptr[l_row + 1]);
-                    assert(*found == u_col);
-                    a_idx = narrow_cast<Idx>(std::distance(col_indices.cbegin(), found));
-                    // subtract
-                    lu_matrix[a_idx] -= dot(l, lu_matrix[u_idx]);
+                if (has_update_entry) {
+                    for (Idx u_idx = pivot_idx + 1; u_idx < row_indptr[pivot_row_col + 1]; ++u_idx) {
+                        lu_matrix[update_entry[update_idx++]] -= dot(l, lu_matrix[u_idx]);
+                    }
+                } else {
+                    for (Idx u_idx = pivot_idx + 1, a_idx = l_idx; u_idx < row_indptr[pivot_row_col + 1]; ++u_idx) {
+                        a_idx = symbolic_->find_in_row(a_idx, col_indices[u_idx]);
+                        lu_matrix[a_idx] -= dot(l, lu_matrix[u_idx]);
+                    }
                 }
-                // iterate column position
-                ++col_position_idx[l_row];
             }
-            // iterate column position for the pivot
-            ++col_position_idx[pivot_row_col];
         }
+        assert(!has_update_entry || update_idx == symbolic_->n_updates());
+    }
+
+    // refactorize in-place after a change of some entries of the matrix
+    // data contains the factorization of the previous matrix, matrix is the new matrix
+    // changed_entries are the indices of the entries which are different in the new matrix
+    // only the rows on the paths in the elimination tree from the changed entries to the root are factorized again,
+    //    the other rows of L and U do not depend on the changed entries
+    // the result is the same as the factorization of the new matrix with prefactorize
+    // return false if the full factorization is used instead
+    bool refactorize(std::vector<Tensor> const& matrix, std::vector<Tensor>& data, BlockPermArray& block_perm_array,
+                     IdxVector const& changed_entries) {
+        assert(static_cast<Idx>(matrix.size()) == nnz_);
+        assert(static_cast<Idx>(data.size()) == nnz_);
+        auto const& row_indptr = symbolic_->row_indptr;
+        auto const& diag_lu = symbolic_->diag;
+        auto const& transpose_entry = symbolic_->transpose_entry;
+
+        std::vector<bool> affected(size_, false);
+        Idx const partial_work = affected_work(changed_entries, affected);
+
+        // the full factorization is faster if most of the work is in the affected rows,
+        // e.g. the rows close to the root of the elimination tree of a meshed grid
+        if (2 * partial_work > full_work()) {
+            data = matrix;
+            prefactorize(data, block_perm_array);
+            return false;
+        }
+
+        // the descendants of a row have a lower row number, they are factorized first
+        for (Idx row = 0; row != size_; ++row) {
+            if (!affected[row]) {
+                continue;
+            }
+            // restore the entries of the row left of the diagonal, the pivot and the column above the diagonal
+            for (Idx l_idx = row_indptr[row]; l_idx <= diag_lu[row]; ++l_idx) {
+                Idx const u_idx = transpose_entry[l_idx];
+                data[l_idx] = matrix[l_idx];
+                data[u_idx] = matrix[u_idx];
+            }
+            factorize_row(row, data, block_perm_array);
+        }
+        return true;
     }
 
   private:
     Idx size_;
     Idx nnz_; // number of non zeroes (in block)
-    std::shared_ptr<IdxVector const> row_indptr_;
-    std::shared_ptr<IdxVector const> col_indices_;
-    std::shared_ptr<IdxVector const> diag_lu_;
+    std::shared_ptr<SparseLUSymbolic const> symbolic_;
+    SparseLUParallelism parallelism_{};
+    // work data of the sparse solves
+    IdxVector reach_stamp_;
+    Idx stamp_counter_{};
+    IdxVector forward_reach_;
+    IdxVector backward_reach_;
+
+    // mark the rows of the factorization which depend on the changed entries, and count their work
+    // the entries (i, j) and (j, i) are factorized in row max(i, j), which is read by all its ancestors
+    // the work is counted as the number of pivots and updates L_k,i * U_i,j or L_j,i * U_i,k in the affected rows
+    Idx affected_work(IdxVector const& changed_entries, std::vector<bool>& affected) const {
+        auto const& row_indptr = symbolic_->row_indptr;
+        auto const& col_indices = symbolic_->col_indices;
+        auto const& diag_lu = symbolic_->diag;
+        auto const& transpose_entry = symbolic_->transpose_entry;
+        auto const& parent = symbolic_->parent;
+
+        Idx partial_work = 0;
+        for (Idx const entry : changed_entries) {
+            for (Idx row = std::max(col_indices[entry], col_indices[transpose_entry[entry]]);
+                 row != -1 && !affected[row]; row = parent[row]) {
+                affected[row] = true;
+                ++partial_work;
+                for (Idx l_idx = row_indptr[row]; l_idx < diag_lu[row]; ++l_idx) {
+                    Idx const k_position = transpose_entry[l_idx] - diag_lu[col_indices[l_idx]] - 1;
+                    partial_work += 2 * k_position + 1;
+                }
+            }
+        }
+        return partial_work;
+    }
+
+    Idx full_work() const { return (size_ + symbolic_->n_updates()) / (is_parallel() ? n_workers() : 1); }
+
+    // rows on the paths from the start rows to the root in the elimination tree, in increasing order
+    // the rows of the reach are marked with the stamp
+    void collect_reach(IdxVector const& start_rows, Idx stamp, IdxVector& reach) {
+        auto const& parent = symbolic_->parent;
+        reach.clear();
+        for (Idx const start_row : start_rows) {
+            for (Idx row = start_row; row != -1 && reach_stamp_[row] != stamp; row = parent[row]) {
+                reach_stamp_[row] = stamp;
+                reach.push_back(row);
+            }
+        }
+        std::ranges::sort(reach);
+    }
+
+    Idx n_workers() const { return std::min(parallelism_.n_threads, parallelism_.thread_pool->n_threads()); }
+
+    // Dense LU factorize pivot for block matrix in-place
+    // A_pivot,pivot, becomes P_pivot^-1 * L_pivot * U_pivot
+    // return reference to pivot permutation
+    std::conditional_t<is_block, BlockPerm const&, BlockPerm>
+    factorize_pivot(Tensor& pivot, BlockPermArray& block_perm_array, Idx pivot_row_col) const {
+        if constexpr (is_block) {
+            BlockPerm& block_perm = block_perm_array[pivot_row_col];
+            factorize_block(pivot, block_perm);
+            return block_perm;
+        } else {
+            if (!is_normal(pivot)) {
+                throw SparseMatrixError{};
+            }
+            return {};
+        }
+    }
+
+    // threshold partial pivoting of the dense LU factorization of a pivot block
+    // the diagonal entry is kept as pivot if its magnitude is at least this fraction of the largest entry in its column
+    static constexpr double block_pivot_threshold = 0.1;
+    // the block is (pseudo) singular if no pivot is larger than this fraction of the largest entry in the block
+    // set a low threshold, because state estimation can have large differences in eigen values
+    static constexpr double block_singular_threshold = 1e-100;
+
+    // in-place dense LU factorization with threshold partial pivoting, L has a unit diagonal
+    // the loops have a fixed size per block type, so the compiler can unroll and vectorize them
+    // the rows are only swapped for a small diagonal entry, which is rare for the admittance matrices of power flow
+    static void factorize_block(Tensor& pivot, BlockPerm& block_perm) {
+        // compare squared magnitudes, which avoids the square roots of complex abs
+        auto const magnitude = [](Scalar const& value) -> double { return std::norm(value); };
+        double max_magnitude = 0.0;
+        for (Idx block_col = 0; block_col != block_size; ++block_col) {
+            for (Idx block_row = 0; block_row != block_size; ++block_row) {
+                max_magnitude = std::max(max_magnitude, magnitude(pivot(block_row, block_col)));
+            }
+        }
+        double const singular_magnitude = block_singular_threshold * block_singular_threshold * max_magnitude;
+
+        block_perm.permuted = false;
+        for (Idx block_row = 0; block_row != block_size; ++block_row) {
+            block_perm.p[block_row] = static_cast<IntS>(block_row);
+        }
+        for (Idx col = 0; col != block_size; ++col) {
+            // find the largest entry on or below the diagonal
+            Idx max_row = col;
+            double col_max_magnitude = magnitude(pivot(col, col));
+            for (Idx block_row = col + 1; block_row != block_size; ++block_row) {
+                if (double const row_magnitude = magnitude(pivot(block_row, col));
+                    row_magnitude > col_max_magnitude) {
+                    max_row = block_row;
+                    col_max_magnitude = row_magnitude;
+                }
+            }
+            // also catches nan and inf
+            if (!(col_max_magnitude > singular_magnitude)) {
+                throw SparseMatrixError{};
+            }
+            // only swap the rows if the diagonal is too small
+            if (magnitude(pivot(col, col)) < block_pivot_threshold * block_pivot_threshold * col_max_magnitude) {
+                pivot.row(col).swap(pivot.row(max_row));
+                std::swap(block_perm.p[col], block_perm.p[max_row]);
+                block_perm.permuted = true;
+            }
+            // L below the diagonal, and update of the remaining lower right block
+            Idx const n_remaining = block_size - col - 1;
+            for (Idx block_row = col + 1; block_row != block_size; ++block_row) {
+                pivot(block_row, col) /= pivot(col, col);
+                pivot.row(block_row).tail(n_remaining) -= pivot(block_row, col) * pivot.row(col).tail(n_remaining);
+            }
+        }
+    }
+
+    // permute the rows of a block or a vector of the block row with the pivot permutation
+    // x = P * x
+    template <class Block> static void permute_rows(BlockPerm const& block_perm, Block& value) {
+        if (!block_perm.permuted) {
+            return;
+        }
+        Block const original = value;
+        for (Idx block_row = 0; block_row != block_size; ++block_row) {
+            value.row(block_row) = original.row(block_perm.p[block_row]);
+        }
+    }
+
+    // only the columns in the filter are used, the other entries of x are zero
+    struct AllColumns {
+        constexpr bool operator()(Idx /* col */) const { return true; }
+    };
+    template <typename ColumnFilter = AllColumns>
+    void forward_substitute_row(Idx row, std::vector<Tensor> const& lu_matrix, BlockPermArray const& block_perm_array,
+                                std::vector<RHSVector> const& rhs, std::vector<XVector>& x,
+                                ColumnFilter const& in_filter = {}) const {
+        auto const& row_indptr = symbolic_->row_indptr;
+        auto const& col_indices = symbolic_->col_indices;
+        auto const& diag_lu = symbolic_->diag;
+
+        // permutation if needed
+        x[row] = rhs[row];
+        if constexpr (is_block) {
+            permute_rows(block_perm_array[row], x[row]);
+        }
+
+        // loop all columns until diagonal
+        for (Idx l_idx = row_indptr[row]; l_idx < diag_lu[row]; ++l_idx) {
+            Idx const col = col_indices[l_idx];
+            // never overshoot
+            assert(col < row);
+            if (!in_filter(col)) {
+                continue;
+            }
+            // forward subtract
+            x[row] -= dot(lu_matrix[l_idx], x[col]);
+        }
+        // forward substitution inside block, for block matrix
+        if constexpr (is_block) {
+            XVector& xb = x[row];
+            Tensor const& pivot = lu_matrix[diag_lu[row]];
+            for (Idx br = 0; br < block_size; ++br) {
+                for (Idx bc = 0; bc < br; ++bc) {
+                    xb(br) -= pivot(br, bc) * xb(bc);
+                }
+            }
+        }
+    }
+
+    void backward_substitute_row(Idx row, std::vector<Tensor> const& lu_matrix, std::vector<XVector>& x) const {
+        auto const& row_indptr = symbolic_->row_indptr;
+        auto const& col_indices = symbolic_->col_indices;
+        auto const& diag_lu = symbolic_->diag;
+
+        // loop all columns from diagonal
+        for (Idx u_idx = row_indptr[row + 1] - 1; u_idx > diag_lu[row]; --u_idx) {
+            Idx const col = col_indices[u_idx];
+            // always in upper diagonal
+            assert(col > row);
+            // backward subtract
+            x[row] -= dot(lu_matrix[u_idx], x[col]);
+        }
+        // solve the diagonal pivot
+        if constexpr (is_block) {
+            // backward substitution inside block
+            XVector& xb = x[row];
+            Tensor const& pivot = lu_matrix[diag_lu[row]];
+            for (Idx br = block_size - 1; br != -1; --br) {
+                for (Idx bc = block_size - 1; bc > br; --bc) {
+                    xb(br) -= pivot(br, bc) * xb(bc);
+                }
+                xb(br) = xb(br) / pivot(br, br);
+            }
+        } else {
+            x[row] = x[row] / lu_matrix[diag_lu[row]];
+        }
+    }
+
+    // process all rows on the threads of the pool, level by level in increasing or decreasing order
+    // the rows in one level are divided over the workers, the next level starts when all workers finished the level
+    // levels with less rows than workers are processed by the first worker only, without waiting in between
+    // process_row should not throw
+    template <typename ProcessRow> void run_levels(bool reverse, ProcessRow const& process_row) const {
+        auto const& level_indptr = symbolic_->level_indptr;
+        auto const& level_rows = symbolic_->level_rows;
+        Idx const n_levels = static_cast<Idx>(level_indptr.size()) - 1;
+        Idx const n_workers = this->n_workers();
+
+        std::atomic<Idx> worker_counter{0};
+        std::barrier level_barrier{n_workers};
+        parallelism_.thread_pool->run(n_workers, [&] {
+            Idx const worker = worker_counter++;
+            bool previous_serial = false;
+            for (Idx step = 0; step != n_levels; ++step) {
+                Idx const level = reverse ? n_levels - 1 - step : step;
+                Idx const begin = level_indptr[level];
+                Idx const end = level_indptr[level + 1];
+                bool const serial = end - begin < n_workers;
+                if (step != 0 && !(serial && previous_serial)) {
+                    level_barrier.arrive_and_wait();
+                }
+                previous_serial = serial;
+                if (serial && worker != 0) {
+                    continue;
+                }
+                Idx const stride = serial ? 1 : n_workers;
+                for (Idx position = serial ? begin : begin + worker; position < end; position += stride) {
+                    process_row(level_rows[position]);
+                }
+            }
+        });
+    }
+
+    // left-looking factorization in the order of the elimination tree
+    // per row k, the pivot (k, k), L_k,i in row k and U_i,k in column k (i < k) are calculated
+    // only the factorized rows i < k of the descendants of k in the elimination tree are read,
+    // the updates are applied in increasing order of i, so the result is the same as with the sequential factorization
+    void prefactorize_parallel(std::vector<Tensor>& lu_matrix, BlockPermArray& block_perm_array) const {
+        std::atomic<bool> failed{false};
+        run_levels(false, [&](Idx row) {
+            if (failed) {
+                return;
+            }
+            try {
+                factorize_row(row, lu_matrix, block_perm_array);
+            } catch (SparseMatrixError const&) {
+                failed = true;
+            }
+        });
+        if (failed) {
+            throw SparseMatrixError{};
+        }
+    }
+
+    void factorize_row(Idx k, std::vector<Tensor>& lu_matrix, BlockPermArray& block_perm_array) const {
+        auto const& row_indptr = symbolic_->row_indptr;
+        auto const& col_indices = symbolic_->col_indices;
+        auto const& diag_lu = symbolic_->diag;
+        auto const& transpose_entry = symbolic_->transpose_entry;
+        auto const& update_indptr = symbolic_->update_indptr;
+        auto const& update_entry = symbolic_->update_entry;
+        bool const has_update_entry = symbolic_->has_update_entry();
+        Idx const pivot_idx = diag_lu[k];
+
+        // for block matrix
+        // the factorized U_i,j are already permuted with the pivot permutations of i
+        // permute the entries of column k in the same way before subtracting
+        // A_i,k = P_i * A_i,k    i < k
+        if constexpr (is_block) {
+            for (Idx l_idx = row_indptr[k]; l_idx < pivot_idx; ++l_idx) {
+                permute_rows(block_perm_array[col_indices[l_idx]], lu_matrix[transpose_entry[l_idx]]);
+            }
+        }
+
+        // loop all columns i until diagonal
+        for (Idx l_idx = row_indptr[k]; l_idx < pivot_idx; ++l_idx) {
+            Idx const i = col_indices[l_idx];
+            Idx const u_idx = transpose_entry[l_idx];
+            Tensor const& pivot = lu_matrix[diag_lu[i]];
+            // calculate L_k,i * U_pivot = A_k,i and L_pivot * U_i,k = A_i,k
+            if constexpr (is_block) {
+                Tensor& l = lu_matrix[l_idx];
+                for (Idx block_col = 0; block_col < block_size; ++block_col) {
+                    for (Idx block_row = 0; block_row < block_col; ++block_row) {
+                        l.col(block_col) -= pivot(block_row, block_col) * l.col(block_row);
+                    }
+                    l.col(block_col) = l.col(block_col) / pivot(block_col, block_col);
+                }
+                Tensor& u = lu_matrix[u_idx];
+                for (Idx block_row = 0; block_row < block_size; ++block_row) {
+                    for (Idx block_col = 0; block_col < block_row; ++block_col) {
+                        u.row(block_row) -= pivot(block_row, block_col) * u.row(block_col);
+                    }
+                }
+            } else {
+                lu_matrix[l_idx] = lu_matrix[l_idx] / pivot;
+            }
+            Tensor const& l = lu_matrix[l_idx];
+            Tensor const& u = lu_matrix[u_idx];
+
+            // for all columns j of U_i,j at the right of the pivot (i, i), until column k
+            //     A(k, j) = A(k, j) - L_k,i * U_i,j
+            //     A(j, k) = A(j, k) - L_j,i * U_i,k
+            // the fill-ins are pre-allocated
+            // k is the n-th column right of the pivot in row i, the updates of row k are the n-th row of updates of i
+            // without pre-computed updates, the entries (k, j) are found by a merge walk through row k from (k, i)
+            Idx const n_upper = row_indptr[i + 1] - diag_lu[i] - 1;
+            Idx const k_position = u_idx - diag_lu[i] - 1;
+            Idx const* const k_update_entry =
+                has_update_entry ? update_entry.data() + update_indptr[i] + k_position * n_upper : nullptr;
+            Idx a_idx = l_idx;
+            for (Idx j_position = 0; j_position != k_position; ++j_position) {
+                Idx const ij_idx = diag_lu[i] + 1 + j_position;
+                a_idx = has_update_entry ? k_update_entry[j_position]
+                                         : symbolic_->find_in_row(a_idx, col_indices[ij_idx]);
+                assert(col_indices[a_idx] == col_indices[ij_idx]);
+                lu_matrix[a_idx] -= dot(l, lu_matrix[ij_idx]);
+                lu_matrix[transpose_entry[a_idx]] -= dot(lu_matrix[transpose_entry[ij_idx]], u);
+            }
+            assert(!has_update_entry || k_update_entry[k_position] == pivot_idx);
+            lu_matrix[pivot_idx] -= dot(l, u);
+        }
+
+        // factorize the pivot, and permute the rows of L_k,i for block matrix
+        // L_k,i = P_k * L_k,i    i < k
+        [[maybe_unused]] BlockPerm const& block_perm = factorize_pivot(lu_matrix[pivot_idx], block_perm_array, k);
+        if constexpr (is_block) {
+            if (block_perm.permuted) {
+                for (Idx l_idx = row_indptr[k]; l_idx < pivot_idx; ++l_idx) {
+                    permute_rows(block_perm, lu_matrix[l_idx]);
+                }
+            }
+        }
+    }
 };
 
 } // namespace power_grid_model::math_solver
@@ -0,0 +1,198 @@
+// SPDX-FileCopyrightText: Contributors to the Power Grid Model project <powergridmodel@lfenergy.org>
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#pragma once
+
+#include "../common/common.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <vector>
+
+namespace power_grid_model::math_solver {
+
+// symbolic factorization of a sparse matrix with a symmetric structure
+//
+// it only depends on the sparsity pattern of the LU matrix, i.e. the matrix with all fill-ins of the ordering,
+// so it can be shared between all matrices with the same pattern:
+// the islands of a grid, the switching states of a batch and the different solvers of one grid.
+// the numerical factorization is done by SparseLUSolver.
+struct SparseLUSymbolic {
+    // csr structure of the lu matrix, including fill-ins
+    IdxVector row_indptr;
+    IdxVector col_indices;
+    // diagonal entry per row
+    IdxVector diag;
+    // position of entry (j, i) for the entry (i, j), for entry in the diagonal transpose_entry[i] = i
+    IdxVector transpose_entry;
+    // elimination tree, the parent of a row is the first column right of the diagonal, -1 for the roots
+    IdxVector parent;
+    // rows grouped by their height in the elimination tree, the rows in one level are independent of each other
+    // a row is always in a higher level than all its descendants
+    IdxVector level_indptr;
+    IdxVector level_rows;
+    // per pivot i, the entries (j, k) updated by L_j,i * U_i,k in the factorization, for all j, k > i in row i
+    // the updates of pivot i are stored row-major from update_indptr[i], in the order of the entries in row i
+    // this is also the order in which the right-looking factorization visits them
+    // update_entry is only stored if it is at most max_update_entry_ratio times the size of the lu matrix,
+    // otherwise, e.g. for large meshed grids, the factorization finds the entries by a merge walk through row j,
+    // starting from the entry (j, i)
+    IdxVector update_indptr;
+    IdxVector update_entry;
+
+    static constexpr Idx max_update_entry_ratio = 4;
+
+    SparseLUSymbolic(IdxVector row_indptr_lu, IdxVector col_indices_lu)
+        : row_indptr{std::move(row_indptr_lu)}, col_indices{std::move(col_indices_lu)} {
+        Idx const n = size();
+        diag.resize(n);
+        parent.assign(n, -1);
+        transpose_entry.resize(nnz());
+
+        // the structure is symmetric: entries (row, col) above the diagonal are visited in the same order as
+        // the entries (col, row) left of the diagonal in row col
+        IdxVector col_position_idx(row_indptr.cbegin(), row_indptr.cend() - 1);
+        for (Idx row = 0; row != n; ++row) {
+            // all entries left of the diagonal are already visited
+            diag[row] = col_position_idx[row];
+            assert(col_indices[diag[row]] == row);
+            transpose_entry[diag[row]] = diag[row];
+            for (Idx u_idx = diag[row] + 1; u_idx < row_indptr[row + 1]; ++u_idx) {
+                Idx const l_idx = col_position_idx[col_indices[u_idx]]++;
+                assert(col_indices[l_idx] == row);
+                transpose_entry[u_idx] = l_idx;
+                transpose_entry[l_idx] = u_idx;
+            }
+            if (diag[row] + 1 < row_indptr[row + 1]) {
+                parent[row] = col_indices[diag[row] + 1];
+            }
+        }
+
+        // for each pivot, merge the columns right of the pivot with each row j below the pivot
+        // the entries (j, k) exist for all of them, either as non-zero or as fill-in
+        update_indptr.resize(n + 1);
+        update_indptr[0] = 0;
+        for (Idx row = 0; row != n; ++row) {
+            Idx const n_upper = row_indptr[row + 1] - diag[row] - 1;
+            update_indptr[row + 1] = update_indptr[row] + n_upper * n_upper;
+        }
+        if (n_updates() <= max_update_entry_ratio * nnz()) {
+            update_entry.resize(n_updates());
+            for (Idx row = 0, update_idx = 0; row != n; ++row) {
+                for (Idx l_ref_idx = diag[row] + 1; l_ref_idx < row_indptr[row + 1]; ++l_ref_idx) {
+                    [[maybe_unused]] Idx const l_row = col_indices[l_ref_idx];
+                    Idx a_idx = transpose_entry[l_ref_idx];
+                    for (Idx u_idx = diag[row] + 1; u_idx < row_indptr[row + 1]; ++u_idx) {
+                        a_idx = find_in_row(a_idx, col_indices[u_idx]);
+                        assert(a_idx < row_indptr[l_row + 1]);
+                        update_entry[update_idx++] = a_idx;
+                    }
+                }
+            }
+        }
+
+        build_levels();
+    }
+
+    Idx size() const { return static_cast<Idx>(row_indptr.size()) - 1; }
+    Idx nnz() const { return row_indptr.back(); }
+    Idx n_levels() const { return static_cast<Idx>(level_indptr.size()) - 1; }
+    Idx n_updates() const { return update_indptr.back(); }
+    bool has_update_entry() const { return static_cast<Idx>(update_entry.size()) == n_updates(); }
+
+    // merge walk to the entry of column col, from the entry a_idx left of it in the same row
+    Idx find_in_row(Idx a_idx, Idx col) const {
+        while (col_indices[a_idx] < col) {
+            ++a_idx;
+        }
+        assert(col_indices[a_idx] == col);
+        return a_idx;
+    }
+
+    bool has_pattern(IdxVector const& other_row_indptr, IdxVector const& other_col_indices) const {
+        return row_indptr == other_row_indptr && col_indices == other_col_indices;
+    }
+
+  private:
+    void build_levels() {
+        Idx const n = size();
+        // height of each row in the elimination tree, children always have a lower row number than their parent
+        IdxVector level(n, 0);
+        Idx n_levels = 0;
+        for (Idx row = 0; row != n; ++row) {
+            n_levels = std::max(n_levels, level[row] + 1);
+            if (parent[row] != -1) {
+                level[parent[row]] = std::max(level[parent[row]], level[row] + 1);
+            }
+        }
+        // counting sort of the rows by level
+        level_indptr.assign(n_levels + 1, 0);
+        for (Idx row = 0; row != n; ++row) {
+            ++level_indptr[level[row] + 1];
+        }
+        std::partial_sum(level_indptr.cbegin(), level_indptr.cend(), level_indptr.begin());
+        IdxVector level_position(level_indptr.cbegin(), level_indptr.cend() - 1);
+        level_rows.resize(n);
+        for (Idx row = 0; row != n; ++row) {
+            level_rows[level_position[level[row]]++] = row;
+        }
+    }
+};
+
+inline size_t hash_sparsity_pattern(IdxVector const& row_indptr, IdxVector const& col_indices) {
+    size_t seed = 0;
+    auto const combine = [&seed](Idx value) {
+        seed ^= std::hash<Idx>{}(value) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+    };
+    std::ranges::for_each(row_indptr, combine);
+    std::ranges::for_each(col_indices, combine);
+    return seed;
+}
+
+// symbolic factorizations keyed by their sparsity pattern
+//
+// the cache does not own the symbolic factorizations: an entry is available as long as it is used somewhere else,
+// e.g. by a y bus structure in the topology cache of the model.
+// the y bus structures only query the cache at their first factorization,
+// so it is shared with the copies of the model and guarded for the calculations in parallel threads.
+class SparseLUSymbolicCache {
+  public:
+    // get the symbolic factorization of the sparsity pattern, re-use an existing one with the same pattern if possible
+    std::shared_ptr<SparseLUSymbolic const> get(IdxVector row_indptr, IdxVector col_indices) {
+        std::scoped_lock const lock{mutex_};
+        size_t const hash = hash_sparsity_pattern(row_indptr, col_indices);
+        for (Entry const& entry : entries_) {
+            if (entry.hash != hash) {
+                continue;
+            }
+            if (auto symbolic = entry.symbolic.lock(); symbolic && symbolic->has_pattern(row_indptr, col_indices)) {
+                return symbolic;
+            }
+        }
+        std::erase_if(entries_, [](Entry const& entry) { return entry.symbolic.expired(); });
+        auto symbolic = std::make_shared<SparseLUSymbolic const>(std::move(row_indptr), std::move(col_indices));
+        entries_.push_back({.hash = hash, .symbolic = symbolic});
+        return symbolic;
+    }
+
+    Idx size() const {
+        std::scoped_lock const lock{mutex_};
+        return static_cast<Idx>(entries_.size());
+    }
+
+  private:
+    struct Entry {
+        size_t hash;
+        std::weak_ptr<SparseLUSymbolic const> symbolic;
+    };
+
+    std::vector<Entry> entries_;
+    mutable std::mutex mutex_;
+};
+
+} // namespace power_grid_model::math_solver
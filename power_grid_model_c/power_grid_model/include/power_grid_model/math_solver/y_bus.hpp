@@ -7,9 +7,12 @@
 #include "../calculation_parameters.hpp"
 #include "../common/common.hpp"
 #include "../common/three_phase_tensor.hpp"
+#include "sparse_lu_symbolic.hpp"
 
 #include <algorithm>
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <numeric>
 #include <ranges>
 
@@ -18,8 +21,6 @@ namespace power_grid_model {
 // hide implementation in inside namespace
 namespace math_solver {
 
-using OffDiagIdxMap = std::array<Idx, 2>; // map of ft and tf for branch
-
 using MatrixPos = std::pair<Idx, Idx>;
 
 struct YBusElementMap {
@@ -77,28 +78,23 @@ struct YBusStructure {
     std::vector<MatrixPos> y_bus_pos_in_entries;
     // sequence entry of bus data
     IdxVector bus_entry;
-    // LU csr structure for the y bus with sparse fill-ins
-    // this is the structure when y bus is LU-factorized
-    // it will contain all the elements plus the elements in fill_in from topology
-    // fill_in should never contain entries which already exist in y bus
-    IdxVector row_indptr_lu;
-    IdxVector col_indices_lu;
-    // diagonal entry of lu matrices
-    IdxVector diag_lu;
-
     // map index between LU structure and y bus structure
     // for Element i in lu matrix, it is the element map_lu_y_bus[i] in y bus
     // if the element is a fill-in, map_lu_y_bus[i] = -1
     // i.e. data_lu[i] = data_y_bus[map_lu_y_bus[i]]; if map_lu_y_bus[i] != -1
     IdxVector map_lu_y_bus;
-    // transpose entry of the sparse matrix
-    // length of nnz_lu Idx array.
-    // for lu_transpose_entry[i] indicates the position i-th element in transposed lu matrix in CSR form
-    // for entry in the diagonal lu_transpose_entry[i] = i
-    IdxVector lu_transpose_entry;
+    // map from branch/shunt parameters to the y bus entries they contribute to, in CSR form
+    // the entries of branch i are branch_param_entries[branch_param_entry_indptr[i]:branch_param_entry_indptr[i + 1]]
+    IdxVector branch_param_entry_indptr;
+    IdxVector branch_param_entries;
+    IdxVector shunt_param_entry_indptr;
+    IdxVector shunt_param_entries;
 
     // construct ybus structure
-    explicit YBusStructure(MathModelTopology const& topo) {
+    // the symbolic factorization is taken from the cache if another structure has the same LU sparsity pattern
+    explicit YBusStructure(MathModelTopology const& topo,
+                           std::shared_ptr<SparseLUSymbolicCache> lu_symbolic_cache = nullptr)
+        : lu_symbolic_cache_{std::move(lu_symbolic_cache)} {
         Idx const n_bus = topo.n_bus();
         Idx const n_branch = topo.n_branch();
         auto const n_fill_in = static_cast<Idx>(topo.fill_in.size());
@@ -107,8 +103,6 @@ struct YBusStructure {
         Idx const total_number_entries = 4 * n_branch + n_bus + 2 * n_fill_in;
         vec_map_element.reserve(total_number_entries);
         // add element
-        // off diagonal element list
-        std::vector<OffDiagIdxMap> off_diag_map(n_branch + n_fill_in);
         // loop branch
         for (Idx branch = 0; branch != n_branch; ++branch) {
             // ff, ft, tf, tt for branch
@@ -142,10 +136,9 @@ struct YBusStructure {
         // allocate arrays
         row_indptr.resize(n_bus + 1);
         row_indptr[0] = 0;
-        row_indptr_lu.resize(n_bus + 1);
-        row_indptr_lu[0] = 0;
+        row_indptr_lu_.resize(n_bus + 1);
+        row_indptr_lu_[0] = 0;
         bus_entry.resize(n_bus);
-        diag_lu.resize(n_bus);
         // start entry indptr as zero
         y_bus_entry_indptr.push_back(0);
         // copy all elements in y bus (excluding fill-in)
@@ -165,10 +158,10 @@ struct YBusStructure {
             Idx const row = pos.first;
             Idx const col = pos.second;
             // always assign lu col
-            col_indices_lu.push_back(col);
+            col_indices_lu_.push_back(col);
             // iterate lu row if needed
             if (row > row_start_lu) {
-                row_indptr_lu[++row_start_lu] = nnz_counter_lu;
+                row_indptr_lu_[++row_start_lu] = nnz_counter_lu;
             }
             // every row should have entries
             // so the row start (after increment once) should be the same as current row
@@ -190,13 +183,6 @@ struct YBusStructure {
                 // assign nnz as indices for bus diag entry
                 if (row == col) {
                     bus_entry[row] = nnz_counter;
-                    diag_lu[row] = nnz_counter_lu;
-                }
-                // record off diag entry
-                if (row != col) {
-                    off_diag_map[it_element->element.idx]
-                                // minus 1 because ft is 1 and tf is 2, mapped to 0 and 1
-                                [static_cast<Idx>(it_element->element.element_type) - 1] = nnz_counter_lu;
                 }
                 // inner loop of elements in the same position
                 for ( // use it_element to start
@@ -222,10 +208,6 @@ struct YBusStructure {
                 assert(it_element + 1 != vec_map_element.cend());
                 // next element can never be the same
                 assert((it_element + 1)->pos != pos);
-                // record off diag entry
-                off_diag_map[it_element->element.idx + n_branch]
-                            // minus 1 because ft is 5 and tf is 6, mapped to 0 and 1
-                            [static_cast<Idx>(it_element->element.element_type) - 5] = nnz_counter_lu;
                 // map between y bus and lu struct
                 map_lu_y_bus.push_back(-1);
                 // iterate counter
@@ -237,7 +219,7 @@ struct YBusStructure {
         }
         // last entry for indptr
         row_indptr[++row_start] = nnz_counter;
-        row_indptr_lu[++row_start_lu] = nnz_counter_lu;
+        row_indptr_lu_[++row_start_lu] = nnz_counter_lu;
         // for empty shunt and branch, add artificial one element
         if (topo.n_branch() == 0 && topo.n_shunt() == 0) {
             assert(n_bus == 1);
@@ -246,11 +228,9 @@ struct YBusStructure {
             row_indptr = {0, 1};
             col_indices = {0};
             bus_entry = {0};
-            lu_transpose_entry = {0};
             y_bus_entry_indptr = {0, 0};
-            row_indptr_lu = {0, 1};
-            col_indices_lu = {0};
-            diag_lu = {0};
+            row_indptr_lu_ = {0, 1};
+            col_indices_lu_ = {0};
             map_lu_y_bus = {0};
         }
         // no empty row is allowed
@@ -261,15 +241,63 @@ struct YBusStructure {
         // end of y_bus_entry_indptr is same as size of entry
         assert(y_bus_entry_indptr.back() == static_cast<Idx>(y_bus_element.size()));
 
-        // construct transpose entry
-        lu_transpose_entry.resize(nnz_counter_lu);
-        // default transpose_entry[i] = i
-        std::iota(lu_transpose_entry.begin(), lu_transpose_entry.end(), 0);
-        // fill off-diagonal, loop all the branches
-        for (auto const [entry_1, entry_2] : off_diag_map) {
-            // for each branch entry tf and ft, they are transpose to each other
-            lu_transpose_entry[entry_1] = entry_2;
-            lu_transpose_entry[entry_2] = entry_1;
+        // construct parameter to entry map
+        build_param_entry_map(n_branch, topo.n_shunt());
+    }
+
+    // symbolic factorization of the LU csr structure for the y bus with sparse fill-ins
+    // this is the structure when y bus is LU-factorized
+    // it will contain all the elements plus the elements in fill_in from topology
+    // fill_in should never contain entries which already exist in y bus
+    // it is shared with other y bus structures with the same LU sparsity pattern
+    // it is only calculated at the first use, solvers without LU factorization (e.g. Krylov) never need it
+    std::shared_ptr<SparseLUSymbolic const> const& lu_symbolic() const {
+        std::call_once(lu_symbolic_flag_, [this] {
+            if (lu_symbolic_cache_ != nullptr) {
+                lu_symbolic_ = lu_symbolic_cache_->get(std::move(row_indptr_lu_), std::move(col_indices_lu_));
+            } else {
+                lu_symbolic_ =
+                    std::make_shared<SparseLUSymbolic const>(std::move(row_indptr_lu_), std::move(col_indices_lu_));
+            }
+            lu_symbolic_cache_.reset();
+        });
+        return lu_symbolic_;
+    }
+
+  private:
+    // LU csr structure until the symbolic factorization is calculated
+    mutable IdxVector row_indptr_lu_;
+    mutable IdxVector col_indices_lu_;
+    mutable std::shared_ptr<SparseLUSymbolicCache> lu_symbolic_cache_;
+    mutable std::shared_ptr<SparseLUSymbolic const> lu_symbolic_;
+    mutable std::once_flag lu_symbolic_flag_;
+
+    void build_param_entry_map(Idx n_branch, Idx n_shunt) {
+        auto const is_shunt = [](YBusElement const& element) { return element.element_type == YBusElementType::shunt; };
+        // count entries per parameter
+        branch_param_entry_indptr.assign(n_branch + 1, 0);
+        shunt_param_entry_indptr.assign(n_shunt + 1, 0);
+        for (YBusElement const& element : y_bus_element) {
+            ++(is_shunt(element) ? shunt_param_entry_indptr : branch_param_entry_indptr)[element.idx + 1];
+        }
+        std::partial_sum(branch_param_entry_indptr.cbegin(), branch_param_entry_indptr.cend(),
+                         branch_param_entry_indptr.begin());
+        std::partial_sum(shunt_param_entry_indptr.cbegin(), shunt_param_entry_indptr.cend(),
+                         shunt_param_entry_indptr.begin());
+        // fill entries, in increasing order per parameter
+        branch_param_entries.resize(branch_param_entry_indptr.back());
+        shunt_param_entries.resize(shunt_param_entry_indptr.back());
+        IdxVector branch_position{branch_param_entry_indptr.cbegin(), branch_param_entry_indptr.cend() - 1};
+        IdxVector shunt_position{shunt_param_entry_indptr.cbegin(), shunt_param_entry_indptr.cend() - 1};
+        for (Idx entry = 0; entry != static_cast<Idx>(y_bus_entry_indptr.size()) - 1; ++entry) {
+            for (Idx element = y_bus_entry_indptr[entry]; element != y_bus_entry_indptr[entry + 1]; ++element) {
+                Idx const param_idx = y_bus_element[element].idx;
+                if (is_shunt(y_bus_element[element])) {
+                    shunt_param_entries[shunt_position[param_idx]++] = entry;
+                } else {
+                    branch_param_entries[branch_position[param_idx]++] = entry;
+                }
+            }
         }
     }
 };
@@ -277,8 +305,6 @@ struct YBusStructure {
 // See also "Node Admittance Matrix" in "State Estimation Alliander"
 template <symmetry_tag sym> class YBus {
   public:
-    using ParamChangedCallback = std::function<void(bool param_changed)>;
-
     YBus(std::shared_ptr<MathModelTopology const> const& topo_ptr,
          std::shared_ptr<MathModelParam<sym> const> const& param,
          std::shared_ptr<YBusStructure const> const& y_bus_struct = {})
@@ -287,7 +313,7 @@ template <symmetry_tag sym> class YBus {
         if (y_bus_struct) {
             y_bus_struct_ = y_bus_struct;
         } else {
-            y_bus_struct_ = std::make_shared<YBusStructure const>(YBusStructure{*topo_ptr});
+            y_bus_struct_ = std::make_shared<YBusStructure const>(*topo_ptr);
         }
         // update values
         update_admittance(param);
@@ -299,17 +325,20 @@ template <symmetry_tag sym> class YBus {
     Idx nnz_lu() const { return row_indptr_lu().back(); }
     IdxVector const& row_indptr() const { return y_bus_struct_->row_indptr; }
     IdxVector const& col_indices() const { return y_bus_struct_->col_indices; }
-    IdxVector const& row_indptr_lu() const { return y_bus_struct_->row_indptr_lu; }
-    IdxVector const& col_indices_lu() const { return y_bus_struct_->col_indices_lu; }
-    IdxVector const& lu_transpose_entry() const { return y_bus_struct_->lu_transpose_entry; }
+    IdxVector const& row_indptr_lu() const { return y_bus_struct_->lu_symbolic()->row_indptr; }
+    IdxVector const& col_indices_lu() const { return y_bus_struct_->lu_symbolic()->col_indices; }
+    IdxVector const& lu_transpose_entry() const { return y_bus_struct_->lu_symbolic()->transpose_entry; }
     std::vector<YBusElement> const& y_bus_element() const { return y_bus_struct_->y_bus_element; }
     IdxVector const& y_bus_entry_indptr() const { return y_bus_struct_->y_bus_entry_indptr; }
     MathModelTopology const& math_topology() const { return *math_topology_; }
     MathModelParam<sym> const& math_model_param() const { return *math_model_param_; }
 
     ComplexTensorVector<sym> const& admittance() const { return admittance_; }
+    // unique id of the admittance, a new id is generated at every update of the admittance
+    // copies of the y bus keep the id, data derived from the admittance can be cached with it
+    uint64_t admittance_id() const { return admittance_id_; }
     IdxVector const& bus_entry() const { return y_bus_struct_->bus_entry; }
-    IdxVector const& lu_diag() const { return y_bus_struct_->diag_lu; }
+    IdxVector const& lu_diag() const { return y_bus_struct_->lu_symbolic()->diag; }
     IdxVector const& map_lu_y_bus() const { return y_bus_struct_->map_lu_y_bus; }
 
     // getter of shared ptr
@@ -317,11 +346,16 @@ template <symmetry_tag sym> class YBus {
     std::shared_ptr<IdxVector const> shared_indices() const { return {y_bus_struct_, &y_bus_struct_->col_indices}; }
     std::shared_ptr<MathModelTopology const> shared_topology() const { return math_topology_; }
     std::shared_ptr<YBusStructure const> shared_y_bus_struct() const { return y_bus_struct_; }
-    std::shared_ptr<IdxVector const> shared_indptr_lu() const { return {y_bus_struct_, &y_bus_struct_->row_indptr_lu}; }
+    std::shared_ptr<SparseLUSymbolic const> shared_lu_symbolic() const { return y_bus_struct_->lu_symbolic(); }
+    std::shared_ptr<IdxVector const> shared_indptr_lu() const {
+        return {y_bus_struct_->lu_symbolic(), &y_bus_struct_->lu_symbolic()->row_indptr};
+    }
     std::shared_ptr<IdxVector const> shared_indices_lu() const {
-        return {y_bus_struct_, &y_bus_struct_->col_indices_lu};
+        return {y_bus_struct_->lu_symbolic(), &y_bus_struct_->lu_symbolic()->col_indices};
+    }
+    std::shared_ptr<IdxVector const> shared_diag_lu() const {
+        return {y_bus_struct_->lu_symbolic(), &y_bus_struct_->lu_symbolic()->diag};
     }
-    std::shared_ptr<IdxVector const> shared_diag_lu() const { return {y_bus_struct_, &y_bus_struct_->diag_lu}; }
 
     constexpr auto& get_y_bus_structure() const { return y_bus_struct_; }
 
@@ -344,45 +378,43 @@ template <symmetry_tag sym> class YBus {
         for (Idx entry = 0; entry != nnz(); ++entry) {
             // start admittance accumulation with zero
             ComplexTensor<sym> entry_admittance{0.0};
-            IdxVector entry_param_shunt;
-            IdxVector entry_param_branch;
             // loop over all entries of this position
             for (Idx element = y_bus_entry_indptr[entry]; element != y_bus_entry_indptr[entry + 1]; ++element) {
                 auto param_idx = y_bus_element[element].idx;
                 if (y_bus_element[element].element_type == YBusElementType::shunt) {
                     entry_admittance += shunt_param[param_idx];
-                    entry_param_shunt.push_back(param_idx);
                 } else {
                     entry_admittance +=
                         branch_param[param_idx].value[static_cast<Idx>(y_bus_element[element].element_type)];
-                    entry_param_branch.push_back(param_idx);
                 }
             }
             // assign
             admittance_[entry] = entry_admittance;
-            map_admittance_param_branch_.push_back(entry_param_branch);
-            map_admittance_param_shunt_.push_back(entry_param_shunt);
         }
 
-        parameters_changed(true);
+        admittance_id_ = new_admittance_id();
     }
 
-    IdxVector increments_to_entries(auto const& math_model_param_incrmt) {
+    // sorted unique y bus entries affected by the changed parameters
+    IdxVector increments_to_entries(auto const& math_model_param_incrmt) const {
         // construct affected entries
         IdxVector affected_entries;
 
-        auto query_params_in_map = [&affected_entries](auto const& params_to_change, auto const& mapping) {
-            for (size_t i = 0; i < mapping.size(); ++i) {
-                if (std::ranges::any_of(mapping[i], [&](Idx val) {
-                        return std::ranges::find(params_to_change, val) != params_to_change.end();
-                    })) {
-                    affected_entries.push_back(static_cast<int>(i));
-                }
+        auto query_params_in_map = [&affected_entries](auto const& params_to_change, IdxVector const& indptr,
+                                                       IdxVector const& entries) {
+            for (Idx const param_idx : params_to_change) {
+                affected_entries.insert(affected_entries.end(), entries.cbegin() + indptr[param_idx],
+                                        entries.cbegin() + indptr[param_idx + 1]);
             }
         };
 
-        query_params_in_map(math_model_param_incrmt.branch_param_to_change, map_admittance_param_branch_);
-        query_params_in_map(math_model_param_incrmt.shunt_param_to_change, map_admittance_param_shunt_);
+        query_params_in_map(math_model_param_incrmt.branch_param_to_change, y_bus_struct_->branch_param_entry_indptr,
+                            y_bus_struct_->branch_param_entries);
+        query_params_in_map(math_model_param_incrmt.shunt_param_to_change, y_bus_struct_->shunt_param_entry_indptr,
+                            y_bus_struct_->shunt_param_entries);
+        std::ranges::sort(affected_entries);
+        auto const duplicates = std::ranges::unique(affected_entries);
+        affected_entries.erase(duplicates.begin(), duplicates.end());
         return affected_entries;
     }
 
@@ -422,7 +454,7 @@ template <symmetry_tag sym> class YBus {
             admittance_[entry] = entry_admittance;
         }
 
-        parameters_changed(true);
+        admittance_id_ = new_admittance_id();
     }
 
     ComplexValue<sym> calculate_injection(ComplexValueVector<sym> const& u, Idx bus_number) const {
@@ -491,33 +523,13 @@ template <symmetry_tag sym> class YBus {
         return shunt_flow;
     }
 
-    /// @brief register a new callback to signal a parameter change
-    /// @param callback the callback to register
-    /// @return the unique key referencing this callback (used for unregistering)
-    uint64_t register_parameters_changed_callback(ParamChangedCallback callback) {
-        static uint64_t num_added = 0;
-
-        auto const new_key = num_added;
-        ++num_added;
-
-        assert(!parameters_changed_callbacks_.contains(new_key));
-        parameters_changed_callbacks_.emplace_hint(parameters_changed_callbacks_.cend(), new_key, std::move(callback));
-        return new_key;
-    }
-
-    /// @brief unregister a callback to signal a parameter change
-    /// @param key the unique key referencing the callback (returned by register_parameters_changed_callback)
-    void unregister_parameters_changed_callback(uint64_t key) {
-        assert(parameters_changed_callbacks_.contains(key));
-        parameters_changed_callbacks_.erase(key);
-    }
-
   private:
     // csr structure
     std::shared_ptr<YBusStructure const> y_bus_struct_;
 
     // admittance
     ComplexTensorVector<sym> admittance_;
+    uint64_t admittance_id_{};
 
     // cache math topology
     std::shared_ptr<MathModelTopology const> math_topology_;
@@ -529,16 +541,9 @@ template <symmetry_tag sym> class YBus {
     IdxVector branch_param_idx_{};
     IdxVector shunt_param_idx_{};
 
-    // map index between admittance entries and parameter entries
-    std::vector<IdxVector> map_admittance_param_branch_{};
-    std::vector<IdxVector> map_admittance_param_shunt_{};
-
-    std::unordered_map<uint64_t, ParamChangedCallback> parameters_changed_callbacks_;
-
-    void parameters_changed(bool param_changed) const {
-        std::ranges::for_each(parameters_changed_callbacks_, [param_changed](auto const& key_and_callback) {
-            key_and_callback.second(param_changed);
-        });
+    static uint64_t new_admittance_id() {
+        static std::atomic<uint64_t> next_id{0};
+        return next_id++;
     }
 };
 
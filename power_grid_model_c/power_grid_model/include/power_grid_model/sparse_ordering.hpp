@@ -8,214 +8,181 @@
 
 #include <algorithm>
 #include <cassert>
-#include <compare>
+#include <functional>
 #include <map>
-#include <set>
+#include <queue>
 #include <utility>
 #include <vector>
 
 namespace power_grid_model {
 
 namespace detail {
-class DegreeLookup {
-  public:
-    void set(Idx u, Idx degree) {
-        if (auto degree_it = vertex_to_degree.find(u); degree_it != vertex_to_degree.end()) {
-            remove_degree(u, degree_it->second);
-            degree_it->second = degree;
-        } else {
-            vertex_to_degree.try_emplace(u, degree);
-        }
-        degrees_to_vertex[degree].insert(u);
-    }
-
-    void erase(Idx u) {
-        auto vertex_it = vertex_to_degree.find(u);
-        if (vertex_it == vertex_to_degree.end()) {
-            return;
-        }
-        Idx const degree = vertex_it->second;
-        vertex_to_degree.erase(vertex_it);
-        remove_degree(u, degree);
+inline bool in_graph(std::pair<Idx, Idx> const& e, std::map<Idx, IdxVector> const& d) {
+    if (auto edges_it = d.find(e.first);
+        edges_it != d.cend() && std::ranges::find(edges_it->second, e.second) != edges_it->second.cend()) {
+        return true;
     }
+    return false;
+}
 
-    friend auto min_element(DegreeLookup const& dgd);
+// elimination graph of the minimum degree ordering
+//
+// the vertices are numbered 0..n-1 in increasing order of their original ids, so that ties in the degree are broken
+// by the smallest id.
+// all data is stored in arrays indexed by vertex number. eliminated vertices are removed lazily from the adjacency
+// lists; the degree lookup is a min-heap of (degree, vertex) in which outdated entries are skipped.
+class EliminationGraph {
+  public:
+    using Fills = std::vector<std::pair<Idx, Idx>>;
 
-  private:
-    void remove_degree(Idx u, Idx degree) {
-        if (auto degree_it = degrees_to_vertex.find(degree); degree_it != degrees_to_vertex.end()) {
-            degree_it->second.erase(u);
-            if (degree_it->second.empty()) {
-                degrees_to_vertex.erase(degree_it);
+    explicit EliminationGraph(std::map<Idx, IdxVector> const& d) {
+        // all vertices, including the ones that only appear as adjacent vertex
+        for (auto const& [k, adjacent] : d) {
+            vertex_id_.push_back(k);
+            vertex_id_.insert(vertex_id_.end(), adjacent.cbegin(), adjacent.cend());
+        }
+        std::ranges::sort(vertex_id_);
+        auto const duplicates = std::ranges::unique(vertex_id_);
+        vertex_id_.erase(duplicates.begin(), duplicates.end());
+
+        auto const n = static_cast<Idx>(vertex_id_.size());
+        adjacency_.resize(n);
+        degree_.resize(n);
+        eliminated_.resize(n, false);
+        marker_.resize(n, -1);
+
+        // make symmetric
+        for (auto const& [k, adjacent] : d) {
+            Idx const u = vertex(k);
+            for (Idx const e : adjacent) {
+                Idx const v = vertex(e);
+                adjacency_[u].push_back(v);
+                adjacency_[v].push_back(u);
             }
         }
+        for (Idx u = 0; u != n; ++u) {
+            auto& adjacent = adjacency_[u];
+            std::ranges::sort(adjacent);
+            auto const duplicate_adjacent = std::ranges::unique(adjacent);
+            adjacent.erase(duplicate_adjacent.begin(), duplicate_adjacent.end());
+            set_degree(u, static_cast<Idx>(adjacent.size()));
+        }
+        n_remaining_ = n;
     }
 
-    std::map<Idx, Idx> vertex_to_degree;
-    std::map<Idx, std::set<Idx>> degrees_to_vertex;
-};
-
-inline auto min_element(DegreeLookup const& dgd) {
-    Idx const vertex = *dgd.degrees_to_vertex.begin()->second.begin();
-    return dgd.vertex_to_degree.find(vertex);
-}
-
-inline void remove_element_degree(Idx u, DegreeLookup& dgd) { dgd.erase(u); }
-
-inline void set_element_degree(Idx u, Idx degree, DegreeLookup& dgd) { dgd.set(u, degree); }
-
-inline Idx num_adjacent(Idx const u, std::map<Idx, IdxVector> const& d) {
-    if (auto it = d.find(u); it != d.end()) {
-        return static_cast<Idx>(it->second.size());
+    std::pair<IdxVector, Fills> eliminate_all() {
+        IdxVector alpha;
+        alpha.reserve(vertex_id_.size());
+        Fills fills;
+
+        while (n_remaining_ > 0) {
+            Idx const u = pop_min_degree();
+            alpha.push_back(vertex_id_[u]);
+            if (n_remaining_ == 2) {
+                remove_eliminated(u);
+                assert(adjacency_[u].size() == 1);
+                alpha.push_back(vertex_id_[adjacency_[u].front()]);
+                break;
+            }
+            eliminate(u, alpha, fills);
+        }
+        return {std::move(alpha), std::move(fills)};
     }
-    return 0;
-}
 
-inline IdxVector const& adj(Idx const u, std::map<Idx, IdxVector> const& d) { return d.at(u); }
-
-inline std::vector<std::pair<Idx, DegreeLookup>> comp_size_degrees_graph(std::map<Idx, IdxVector> const& d) {
-    DegreeLookup dd;
-    IdxVector v;
-
-    for (auto const& [k, adjacent] : d) {
-        v.push_back(k);
-        set_element_degree(k, static_cast<Idx>(adjacent.size()), dd);
+  private:
+    IdxVector vertex_id_;
+    std::vector<IdxVector> adjacency_;
+    IdxVector degree_;
+    std::vector<bool> eliminated_;
+    IdxVector marker_;
+    Idx stamp_{0};
+    Idx n_remaining_{0};
+    std::priority_queue<std::pair<Idx, Idx>, std::vector<std::pair<Idx, Idx>>, std::greater<>> min_degree_;
+
+    Idx vertex(Idx id) const {
+        return static_cast<Idx>(std::ranges::lower_bound(vertex_id_, id) - vertex_id_.cbegin());
     }
 
-    return {{d.size(), dd}};
-}
-
-inline std::map<Idx, IdxVector> make_clique(IdxVector& l) {
-    std::map<Idx, IdxVector> d;
-
-    for (Idx i = 0; i < static_cast<Idx>(l.size()); i++) {
-        IdxVector sl(l.size() - 1);
-        std::copy(l.begin(), l.begin() + i, sl.begin());
-        std::copy(l.begin() + i + 1, l.end(), sl.begin() + i);
-        d[l[i]] = std::move(sl);
+    void set_degree(Idx u, Idx degree) {
+        degree_[u] = degree;
+        min_degree_.emplace(degree, u);
     }
 
-    return d;
-}
-
-inline std::vector<std::pair<IdxVector, IdxVector>> check_indistguishable(Idx const u,
-                                                                          std::map<Idx, IdxVector> const& d) {
-    IdxVector rl;
-
-    auto l = adj(u, d);
-    auto lu = l;
-    lu.push_back(u);
-    std::ranges::sort(lu);
-
-    for (auto const& v : l) {
-        auto lv = adj(v, d);
-        lv.push_back(v);
-        std::ranges::sort(lv);
-        if (lu == lv) {
-            rl.push_back(v);
+    Idx pop_min_degree() {
+        while (true) {
+            assert(!min_degree_.empty());
+            auto const [degree, u] = min_degree_.top();
+            min_degree_.pop();
+            if (!eliminated_[u] && degree_[u] == degree) {
+                return u;
+            }
         }
     }
 
-    return {{l, rl}};
-}
-
-inline bool in_graph(std::pair<Idx, Idx> const& e, std::map<Idx, IdxVector> const& d) {
-    if (auto edges_it = d.find(e.first);
-        edges_it != d.cend() && std::ranges::find(edges_it->second, e.second) != edges_it->second.cend()) {
-        return true;
+    void remove_eliminated(Idx u) {
+        std::erase_if(adjacency_[u], [this](Idx v) { return eliminated_[v]; });
     }
-    return false;
-}
-
-inline IdxVector remove_vertices_update_degrees(Idx const u, std::map<Idx, IdxVector>& d, DegreeLookup& dgd,
-                                                std::vector<std::pair<Idx, Idx>>& fills) {
-    std::vector<std::pair<IdxVector, IdxVector>> nbsrl = check_indistguishable(u, d);
-    auto& [nbs, rl] = nbsrl[0];
-    IdxVector alpha = rl;
-    std::map<Idx, IdxVector> dd;
 
-    rl.push_back(u);
-
-    for (auto uu : rl) {
-        if (uu != u) {
-            std::erase(nbs, uu);
+    // eliminate u and all vertices indistinguishable from u, i.e. with the same closed neighbourhood
+    // the remaining neighbours become a clique
+    void eliminate(Idx u, IdxVector& alpha, Fills& fills) {
+        remove_eliminated(u);
+        IdxVector neighbours = adjacency_[u];
+
+        // mark closed neighbourhood of u
+        ++stamp_;
+        marker_[u] = stamp_;
+        for (Idx const v : neighbours) {
+            marker_[v] = stamp_;
         }
 
-        remove_element_degree(uu, dgd);
-        IdxVector el;
-        for (auto e : d[uu]) {
-            auto& adjacents = d[e];
-            std::erase(adjacents, uu);
-            if (adjacents.empty()) {
-                el.push_back(e);
+        // mass elimination of indistinguishable vertices
+        IdxVector indistinguishable;
+        for (Idx const v : neighbours) {
+            remove_eliminated(v);
+            if (adjacency_[v].size() == neighbours.size() &&
+                std::ranges::all_of(adjacency_[v], [this](Idx w) { return marker_[w] == stamp_; })) {
+                indistinguishable.push_back(v);
             }
         }
-
-        el.push_back(uu);
-
-        for (auto const& it : el) {
-            d.erase(it);
+        eliminated_[u] = true;
+        for (Idx const v : indistinguishable) {
+            alpha.push_back(vertex_id_[v]);
+            eliminated_[v] = true;
         }
-    }
-
-    dd = make_clique(nbs);
-
-    for (auto const& [k, adjacent] : dd) {
-        auto it = d.find(k);
-        for (Idx const e : adjacent) {
-            if (!in_graph(std::make_pair(k, e), d)) {
-                if (it == d.end()) {
-                    std::tie(it, std::ignore) = d.try_emplace(k);
+        n_remaining_ -= 1 + static_cast<Idx>(indistinguishable.size());
+        std::erase_if(neighbours, [this](Idx v) { return eliminated_[v]; });
+
+        // make clique of the remaining neighbours
+        IdxVector sorted_neighbours = neighbours;
+        std::ranges::sort(sorted_neighbours);
+        for (Idx const k : sorted_neighbours) {
+            ++stamp_;
+            for (Idx const v : adjacency_[k]) {
+                marker_[v] = stamp_;
+            }
+            for (Idx const e : neighbours) {
+                if (e != k && marker_[e] != stamp_) {
+                    adjacency_[k].push_back(e);
+                    adjacency_[e].push_back(k);
+                    fills.emplace_back(vertex_id_[k], vertex_id_[e]);
+                    marker_[e] = stamp_;
                 }
-                it->second.push_back(e);
-                d[e].push_back(k);
-                fills.emplace_back(k, e);
             }
         }
-    }
 
-    for (auto const& e : nbs) {
-        set_element_degree(e, num_adjacent(e, d), dgd);
+        // update degrees
+        for (Idx const v : neighbours) {
+            remove_eliminated(v);
+            set_degree(v, static_cast<Idx>(adjacency_[v].size()));
+        }
     }
-
-    return alpha;
-}
+};
 } // namespace detail
 
+// minimum degree ordering of the graph, with mass elimination of indistinguishable vertices
+// returns the elimination order and the fill-ins created by the elimination
 inline std::pair<IdxVector, std::vector<std::pair<Idx, Idx>>> minimum_degree_ordering(std::map<Idx, IdxVector> d) {
-    // make symmetric
-    for (auto const& [k, adjacent] : d) {
-        for (auto e : adjacent) {
-            d[e].push_back(k);
-        }
-    }
-    for (auto& [k, adjacent] : d) {
-        std::set<Idx> const unique_sorted_adjacent{adjacent.begin(), adjacent.end()};
-        adjacent = IdxVector{unique_sorted_adjacent.begin(), unique_sorted_adjacent.end()};
-    }
-
-    auto data = detail::comp_size_degrees_graph(d);
-    auto& [n, dgd] = data[0];
-
-    IdxVector alpha;
-    std::vector<std::pair<Idx, Idx>> fills;
-
-    for (Idx k = 0; k < n; ++k) {
-        Idx const u = get<0>(*detail::min_element(dgd));
-        alpha.push_back(u);
-        if (d.size() == 2) {
-            assert(d.begin()->second.size() == 1);
-
-            Idx const from = d.begin()->first;
-            Idx const to = d.begin()->second[0];
-            alpha.push_back(alpha.back() == from ? to : from);
-            return {alpha, fills};
-        }
-        std::ranges::copy(detail::remove_vertices_update_degrees(u, d, dgd, fills), std::back_inserter(alpha));
-        if (d.empty()) {
-            return {alpha, fills};
-        }
-    }
-    return {alpha, fills};
+    return detail::EliminationGraph{d}.eliminate_all();
 }
 } // namespace power_grid_model
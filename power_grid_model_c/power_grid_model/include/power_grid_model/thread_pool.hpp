@@ -0,0 +1,129 @@
+// SPDX-FileCopyrightText: Contributors to the Power Grid Model project <powergridmodel@lfenergy.org>
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#pragma once
+
+#include "common/common.hpp"
+
+#include <algorithm>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace power_grid_model {
+
+// pool of persistent worker threads for batch calculations
+//
+// the threads are created once and stay alive until the pool is destroyed,
+// so that repeated batch calculations do not pay for thread creation every time.
+// run() executes one job on a number of workers at the same time and blocks until all of them are finished.
+// concurrent calls to run() from different threads are executed one after another.
+class ThreadPool {
+  public:
+    // n_threads = 0: use number of hardware threads
+    explicit ThreadPool(Idx n_threads) {
+        if (n_threads <= 0) {
+            n_threads = static_cast<Idx>(std::thread::hardware_concurrency());
+        }
+        n_threads = std::max(n_threads, Idx{1});
+        threads_.reserve(n_threads);
+        for (Idx thread_number = 0; thread_number != n_threads; ++thread_number) {
+            threads_.emplace_back([this, thread_number] { worker_loop(thread_number); });
+        }
+    }
+
+    ThreadPool(ThreadPool const&) = delete;
+    ThreadPool& operator=(ThreadPool const&) = delete;
+    ThreadPool(ThreadPool&&) = delete;
+    ThreadPool& operator=(ThreadPool&&) = delete;
+
+    ~ThreadPool() {
+        {
+            std::scoped_lock const lock{mutex_};
+            stop_ = true;
+        }
+        work_cv_.notify_all();
+        for (auto& thread : threads_) {
+            thread.join();
+        }
+    }
+
+    Idx n_threads() const { return static_cast<Idx>(threads_.size()); }
+
+    // run the job on n_workers threads of the pool in parallel and wait until all of them are finished
+    // n_workers is capped by the number of threads in the pool
+    // the first exception thrown by the job, if any, is re-thrown after all workers are finished
+    void run(Idx n_workers, std::function<void()> job) {
+        std::scoped_lock const run_lock{run_mutex_};
+
+        n_workers = std::clamp(n_workers, Idx{1}, n_threads());
+        {
+            std::scoped_lock const lock{mutex_};
+            job_ = std::move(job);
+            n_workers_ = n_workers;
+            n_pending_ = n_workers;
+            exception_ = nullptr;
+            ++generation_;
+        }
+        work_cv_.notify_all();
+
+        std::unique_lock lock{mutex_};
+        done_cv_.wait(lock, [this] { return n_pending_ == 0; });
+        job_ = nullptr;
+        if (exception_) {
+            std::rethrow_exception(std::exchange(exception_, nullptr));
+        }
+    }
+
+  private:
+    std::vector<std::thread> threads_;
+
+    std::mutex run_mutex_; // serializes run() calls
+    std::mutex mutex_;     // guards the members below
+    std::condition_variable work_cv_;
+    std::condition_variable done_cv_;
+    std::function<void()> job_;
+    Idx n_workers_{0};
+    Idx n_pending_{0};
+    Idx generation_{0};
+    std::exception_ptr exception_;
+    bool stop_{false};
+
+    void worker_loop(Idx thread_number) {
+        Idx seen_generation = 0;
+        std::unique_lock lock{mutex_};
+        while (true) {
+            work_cv_.wait(lock, [this, &seen_generation] { return stop_ || generation_ != seen_generation; });
+            if (stop_) {
+                return;
+            }
+            seen_generation = generation_;
+            if (thread_number >= n_workers_) {
+                continue;
+            }
+
+            lock.unlock();
+            std::exception_ptr exception;
+            try {
+                job_();
+            } catch (...) {
+                exception = std::current_exception();
+            }
+            lock.lock();
+
+            if (exception && !exception_) {
+                exception_ = exception;
+            }
+            if (--n_pending_ == 0) {
+                done_cv_.notify_all();
+            }
+        }
+    }
+};
+
+} // namespace power_grid_model
@@ -79,6 +79,14 @@ typedef struct PGM_Handle PGM_Handle;
  */
 typedef struct PGM_Options PGM_Options;
 
+/**
+ * @brief Opaque struct for the thread pool class.
+ *
+ * The thread pool class keeps worker threads alive between batch calculations.
+ *
+ */
+typedef struct PGM_ThreadPool PGM_ThreadPool;
+
 // Only enable the opaque struct definition if this header is consumed by the C-API user.
 // If this header is included when compiling the C-API, the structs below are decleared/defined in the C++ files.
 #ifndef PGM_DLL_EXPORTS
@@ -163,7 +171,9 @@ enum PGM_CalculationMethod {
     PGM_iterative_linear = 2,  /**< iterative linear method for state estimation */
     PGM_iterative_current = 3, /**< linear current method for power flow */
     PGM_linear_current = 4,    /**< iterative constant impedance method for power flow */
-    PGM_iec60909 = 5           /**< fault analysis for short circuits using the iec60909 standard */
+    PGM_iec60909 = 5,          /**< fault analysis for short circuits using the iec60909 standard */
+    PGM_fast_decoupled = 6,    /**< fast decoupled method for power flow */
+    PGM_dc = 7                 /**< linearized (DC) method for power flow, with approximate results */
 };
 
 /**
@@ -222,6 +232,16 @@ enum PGM_TapChangingStrategy {
         4, /**< adjust tap position automatically; optimize for any value in the voltage band; binary search */
 };
 
+/**
+ * @brief Enumeration of initialization strategies of iterative power flow calculations.
+ *
+ */
+enum PGM_InitializationStrategy {
+    PGM_initialization_strategy_default = 0, /**< initialization of the calculation method */
+    PGM_initialization_strategy_previous_solution =
+        1, /**< start from the last converged solution of the same model and topology, if available */
+};
+
 /**
  * @brief Enumeration of experimental features.
  *
@@ -112,6 +112,128 @@ PGM_API void PGM_get_indexer(PGM_Handle* handle, PGM_PowerGridModel const* model
 PGM_API void PGM_calculate(PGM_Handle* handle, PGM_PowerGridModel* model, PGM_Options const* opt,
                            PGM_MutableDataset const* output_dataset, PGM_ConstDataset const* batch_dataset);
 
+/**
+ * @brief Execute a contingency calculation, e.g. an N-1 check.
+ *
+ * The base case of the model is calculated once.
+ * After that, each contingency is calculated with a set of components taken out of service,
+ * i.e. with all statuses of those branches, three-winding transformers and sources set to 0.
+ * The model itself is not changed.
+ * The contingencies are calculated in parallel according to the threading option.
+ *
+ * Contingencies which only take out branches without disconnecting any node from its source
+ * are calculated as a parameter change of the base case: the topology and the factorization of the base case
+ * are re-used. They are typically faster than the equivalent batch calculation with status updates.
+ *
+ * You need to pre-allocate all output buffer.
+ *
+ * Use PGM_error_code() and PGM_error_message() to check the error.
+ * If one or more contingencies fail, the error code is #PGM_batch_error, the same as in a batch calculation.
+ *
+ * @param handle
+ * @param model A pointer to an existing model.
+ * @param opt A pointer to options, you need to pre-set all the calculation options you want.
+ * @param output_dataset A pointer to an instance of PGM_MutableDataset.
+ *   The dataset should have is_batch == true and batch_size == n_contingencies,
+ *   one scenario of output per contingency.
+ *   Only the components with output buffers are calculated, as in PGM_calculate().
+ * @param n_contingencies The number of contingencies.
+ * @param outage_indptr A pointer to a #PGM_Idx array with length n_contingencies + 1.
+ *   The outages of contingency i are outage_ids[outage_indptr[i]:outage_indptr[i + 1]].
+ * @param outage_ids A pointer to a #PGM_ID array with length outage_indptr[n_contingencies].
+ *   The ids of the branches, three-winding transformers and sources to take out of service.
+ * @return
+ */
+PGM_API void PGM_calculate_contingency(PGM_Handle* handle, PGM_PowerGridModel* model, PGM_Options const* opt,
+                                       PGM_MutableDataset const* output_dataset, PGM_Idx n_contingencies,
+                                       PGM_Idx const* outage_indptr, PGM_ID const* outage_ids);
+
+/**
+ * @brief Calculate the sensitivities of the power flow solution to the power injection at nodes.
+ *
+ * The sensitivities are those of the last Newton-Raphson power flow calculation of the model,
+ * which should have the same symmetry as the options. The model should not be updated after that calculation.
+ * All values are in per unit.
+ * A tensor is one double for symmetric and nine doubles (row major, phase to phase) for asymmetric options.
+ * The sensitivities between components in different islands and of components that are not energized are zero.
+ *
+ * Use PGM_error_code() and PGM_error_message() to check the error.
+ *
+ * @param handle
+ * @param model A pointer to an existing model.
+ * @param opt A pointer to options, only the symmetry is used.
+ * @param n_injection_nodes The number of injection nodes.
+ * @param injection_nodes A pointer to a #PGM_ID array with the ids of the nodes with the injection.
+ * @param n_nodes The number of nodes.
+ * @param nodes A pointer to a #PGM_ID array with the ids of the nodes of the voltage sensitivities.
+ * @param n_branches The number of branches.
+ * @param branches A pointer to a #PGM_ID array with the ids of the branches of the power flow sensitivities.
+ * @param voltage_sensitivity A pointer to a pre-allocated array of n_nodes * n_injection_nodes * 4 tensors, or NULL.
+ *   Entry i * n_injection_nodes + k is the sensitivity of node i to the injection at node k,
+ *   in the order dtheta/dp, dtheta/dq, dv/dp, dv/dq.
+ * @param branch_sensitivity A pointer to a pre-allocated array of n_branches * n_injection_nodes * 4 tensors, or NULL.
+ *   Entry i * n_injection_nodes + k is the sensitivity of the from side of branch i to the injection at node k,
+ *   in the order dp/dp, dp/dq, dq/dp, dq/dq.
+ * @return
+ */
+PGM_API void PGM_calculate_power_flow_sensitivity(PGM_Handle* handle, PGM_PowerGridModel* model,
+                                                  PGM_Options const* opt, PGM_Idx n_injection_nodes,
+                                                  PGM_ID const* injection_nodes, PGM_Idx n_nodes, PGM_ID const* nodes,
+                                                  PGM_Idx n_branches, PGM_ID const* branches,
+                                                  double* voltage_sensitivity, double* branch_sensitivity);
+
+/**
+ * @brief Calculate the line outage distribution factors (LODF) of the active power.
+ *
+ * The factors are those of the last Newton-Raphson power flow calculation of the model,
+ * which should have the same symmetry as the options. The model should not be updated after that calculation.
+ * A tensor is one double for symmetric and nine doubles (row major, phase to phase) for asymmetric options.
+ * The factors between branches in different islands and of branches that are not energized are zero.
+ * The factors to the outage of a branch which disconnects the grid are NaN.
+ *
+ * Use PGM_error_code() and PGM_error_message() to check the error.
+ *
+ * @param handle
+ * @param model A pointer to an existing model.
+ * @param opt A pointer to options, only the symmetry is used.
+ * @param n_branches The number of branches.
+ * @param branches A pointer to a #PGM_ID array with the ids of the monitored branches.
+ * @param n_outage_branches The number of outage branches.
+ * @param outage_branches A pointer to a #PGM_ID array with the ids of the outage branches.
+ * @param lodf A pointer to a pre-allocated array of n_branches * n_outage_branches tensors.
+ *   Entry i * n_outage_branches + m is the change of the active power flow in branch i
+ *   per active power flow in outage branch m before its outage.
+ * @return
+ */
+PGM_API void PGM_calculate_lodf(PGM_Handle* handle, PGM_PowerGridModel* model, PGM_Options const* opt,
+                                PGM_Idx n_branches, PGM_ID const* branches, PGM_Idx n_outage_branches,
+                                PGM_ID const* outage_branches, double* lodf);
+
+/**
+ * @brief Calculate the power transfer distribution factors (PTDF) of the dc power flow.
+ *
+ * No previous calculation is needed.
+ * A tensor is one double for symmetric and nine doubles (row major, phase to phase) for asymmetric options.
+ * The factors between components in different islands and of components that are not energized are zero.
+ *
+ * Use PGM_error_code() and PGM_error_message() to check the error.
+ *
+ * @param handle
+ * @param model A pointer to an existing model.
+ * @param opt A pointer to options, only the symmetry is used.
+ * @param n_branches The number of branches.
+ * @param branches A pointer to a #PGM_ID array with the ids of the branches.
+ * @param n_nodes The number of nodes.
+ * @param nodes A pointer to a #PGM_ID array with the ids of the injection nodes.
+ * @param ptdf A pointer to a pre-allocated array of n_branches * n_nodes tensors.
+ *   Entry i * n_nodes + k is the change of the active power at the from side of branch i
+ *   per active power injection at node k.
+ * @return
+ */
+PGM_API void PGM_calculate_dc_ptdf(PGM_Handle* handle, PGM_PowerGridModel* model, PGM_Options const* opt,
+                                   PGM_Idx n_branches, PGM_ID const* branches, PGM_Idx n_nodes, PGM_ID const* nodes,
+                                   double* ptdf);
+
 /**
  * @brief Destroy the model returned by PGM_create_model() or PGM_copy_model().
  *
@@ -28,7 +28,12 @@ extern "C" {
  *   - err_tol: 1e-8
  *   - max_iter: 20
  *   - threading: -1
+ *   - thread_pool: NULL
  *   - short_circuit_voltage_scaling: PGM_short_circuit_voltage_scaling_maximum
+ *   - initialization_strategy: PGM_initialization_strategy_default
+ *   - jacobian_reuse: 0
+ *   - jacobian_reuse_max_mismatch_ratio: 0.5
+ *   - se_mixed_precision: 0
  *   - experimental_features: PGM_experimental_features_disabled
  *
  * @param handle
@@ -102,6 +107,42 @@ PGM_API void PGM_set_max_iter(PGM_Handle* handle, PGM_Options* opt, PGM_Idx max_
  */
 PGM_API void PGM_set_threading(PGM_Handle* handle, PGM_Options* opt, PGM_Idx threading);
 
+/**
+ * @brief Create a thread pool instance.
+ *
+ * The threads of the pool are created once and stay alive until the pool is destroyed.
+ * The pool can be shared by multiple options and models, see PGM_set_thread_pool().
+ * Batch calculations using the same pool at the same time are executed one after another.
+ *
+ * @param handle
+ * @param n_threads The number of threads in the pool. 0 to use the number of machine available threads.
+ * @return The pointer to the thread pool instance. Should be freed by PGM_destroy_thread_pool().
+ *     Before freeing, make sure no calculation is using the thread pool.
+ */
+PGM_API PGM_ThreadPool* PGM_create_thread_pool(PGM_Handle* handle, PGM_Idx n_threads);
+
+/**
+ * @brief Free a thread pool instance.
+ *
+ * @param thread_pool The pointer to the thread pool instance created by PGM_create_thread_pool().
+ */
+PGM_API void PGM_destroy_thread_pool(PGM_ThreadPool* thread_pool);
+
+/**
+ * @brief Specify the thread pool to use for multi-threading. Only applicable for batch calculation.
+ *
+ * If a thread pool is set, parallel batch calculations run on the threads of the pool,
+ * instead of creating new threads for each calculation.
+ * The number of parallel threads is still determined by the threading setting, see PGM_set_threading(),
+ * capped by the number of threads in the pool.
+ *
+ * @param handle
+ * @param opt The pointer to the option instance.
+ * @param thread_pool The pointer to the thread pool instance. NULL to create new threads for each calculation.
+ *     The thread pool should outlive the calculations using the option.
+ */
+PGM_API void PGM_set_thread_pool(PGM_Handle* handle, PGM_Options* opt, PGM_ThreadPool* thread_pool);
+
 /**
  * @brief Specify the voltage scaling min/max for short circuit calculations
  *
@@ -121,6 +162,61 @@ PGM_API void PGM_set_short_circuit_voltage_scaling(PGM_Handle* handle, PGM_Optio
  */
 PGM_API void PGM_set_tap_changing_strategy(PGM_Handle* handle, PGM_Options* opt, PGM_Idx tap_changing_strategy);
 
+/**
+ * @brief Specify the initialization strategy for iterative power flow calculations
+ *
+ * With PGM_initialization_strategy_previous_solution, the Newton-Raphson and iterative current methods start from
+ * the last converged solution of the model instead of their own initial guess.
+ * In a batch calculation, this is the solution of the previous scenario calculated by the same thread.
+ * If the topology has changed since the last calculation, the default initialization is used.
+ *
+ * @param handle
+ * @param opt pointer to option instance
+ * @param initialization_strategy See #PGM_InitializationStrategy
+ */
+PGM_API void PGM_set_initialization_strategy(PGM_Handle* handle, PGM_Options* opt, PGM_Idx initialization_strategy);
+
+/**
+ * @brief Enable/disable the re-use of the factorized jacobian in the Newton-Raphson power flow
+ *
+ * The factorization is kept over the iterations and over the calculations with the same admittance,
+ * e.g. the scenarios of a batch calculated by the same thread.
+ * It is refactorized if the power mismatch is not reduced enough, see PGM_set_jacobian_reuse_max_mismatch_ratio().
+ * A calculation only converges with a re-used factorization if the power mismatch is also within the error tolerance.
+ *
+ * @param handle
+ * @param opt pointer to option instance
+ * @param jacobian_reuse 1 to re-use the factorized jacobian, 0 to factorize it in every iteration
+ */
+PGM_API void PGM_set_jacobian_reuse(PGM_Handle* handle, PGM_Options* opt, PGM_Idx jacobian_reuse);
+
+/**
+ * @brief Specify when the re-used jacobian is refactorized
+ *
+ * The jacobian is refactorized if the power mismatch of an iteration is not below
+ * max_mismatch_ratio times the power mismatch of the previous iteration.
+ *
+ * @param handle
+ * @param opt pointer to option instance
+ * @param max_mismatch_ratio ratio between 0 and 1
+ */
+PGM_API void PGM_set_jacobian_reuse_max_mismatch_ratio(PGM_Handle* handle, PGM_Options* opt,
+                                                       double max_mismatch_ratio);
+
+/**
+ * @brief Enable/disable the single precision factorization in the iterative linear state estimation
+ *
+ * The gain matrix is factorized in single precision, which halves the memory traffic of the factorization and of the
+ * solve in every iteration. The double precision accuracy is recovered by iterative refinement.
+ * If the refinement does not converge, e.g. for a badly conditioned gain matrix, the gain matrix is factorized again
+ * in double precision, so the result is the same as without this option within the error tolerance.
+ *
+ * @param handle
+ * @param opt pointer to option instance
+ * @param se_mixed_precision 1 to factorize in single precision, 0 to factorize in double precision
+ */
+PGM_API void PGM_set_se_mixed_precision(PGM_Handle* handle, PGM_Options* opt, PGM_Idx se_mixed_precision);
+
 /**
  * @brief Enable/disable experimental features.
  *
@@ -14,6 +14,8 @@
 #include <power_grid_model/common/common.hpp>
 #include <power_grid_model/main_model.hpp>
 
+#include <algorithm>
+
 namespace {
 using namespace power_grid_model;
 } // namespace
@@ -126,6 +128,19 @@ constexpr auto get_short_circuit_voltage_scaling(PGM_Options const& opt) {
     return static_cast<ShortCircuitVoltageScaling>(opt.short_circuit_voltage_scaling);
 }
 
+constexpr auto get_initialization_strategy(PGM_Options const& opt) {
+    using enum InitializationStrategy;
+
+    switch (opt.initialization_strategy) {
+    case PGM_initialization_strategy_default:
+        return default_initialization;
+    case PGM_initialization_strategy_previous_solution:
+        return previous_solution;
+    default:
+        throw MissingCaseForEnumError{"get_initialization_strategy", opt.initialization_strategy};
+    }
+}
+
 constexpr auto extract_calculation_options(PGM_Options const& opt) {
     return MainModel::Options{.calculation_type = get_calculation_type(opt),
                               .calculation_symmetry = get_calculation_symmetry(opt),
@@ -135,7 +150,29 @@ constexpr auto extract_calculation_options(PGM_Options const& opt) {
                               .err_tol = opt.err_tol,
                               .max_iter = opt.max_iter,
                               .threading = opt.threading,
-                              .short_circuit_voltage_scaling = get_short_circuit_voltage_scaling(opt)};
+                              .thread_pool = opt.thread_pool,
+                              .short_circuit_voltage_scaling = get_short_circuit_voltage_scaling(opt),
+                              .initialization_strategy = get_initialization_strategy(opt),
+                              .jacobian_reuse = opt.jacobian_reuse != 0,
+                              .jacobian_reuse_max_mismatch_ratio = opt.jacobian_reuse_max_mismatch_ratio,
+                              .se_mixed_precision = opt.se_mixed_precision != 0};
+}
+
+template <typename Calculate> void call_calculation_with_catch(PGM_Handle* handle, Calculate&& calculate) {
+    try {
+        std::forward<Calculate>(calculate)();
+    } catch (BatchCalculationError& e) {
+        handle->err_code = PGM_batch_error;
+        handle->err_msg = e.what();
+        handle->failed_scenarios = e.failed_scenarios();
+        handle->batch_errs = e.err_msgs();
+    } catch (std::exception& e) {
+        handle->err_code = PGM_regular_error;
+        handle->err_msg = e.what();
+    } catch (...) {
+        handle->err_code = PGM_regular_error;
+        handle->err_msg = "Unknown error!\n";
+    }
 }
 } // namespace
 
@@ -154,23 +191,135 @@ void PGM_calculate(PGM_Handle* handle, PGM_PowerGridModel* model, PGM_Options co
         batch_dataset != nullptr ? *batch_dataset : PGM_ConstDataset{false, 1, "update", output_dataset->meta_data()};
 
     // call calculation
-    try {
+    call_calculation_with_catch(handle, [model, opt, output_dataset, &exported_update_dataset] {
         check_calculate_valid_options(*opt);
 
         auto const options = extract_calculation_options(*opt);
         model->calculate(options, *output_dataset, exported_update_dataset);
-    } catch (BatchCalculationError& e) {
-        handle->err_code = PGM_batch_error;
-        handle->err_msg = e.what();
-        handle->failed_scenarios = e.failed_scenarios();
-        handle->batch_errs = e.err_msgs();
-    } catch (std::exception& e) {
+    });
+}
+
+// run contingency calculation
+void PGM_calculate_contingency(PGM_Handle* handle, PGM_PowerGridModel* model, PGM_Options const* opt,
+                               PGM_MutableDataset const* output_dataset, PGM_Idx n_contingencies,
+                               PGM_Idx const* outage_indptr, PGM_ID const* outage_ids) {
+    PGM_clear_error(handle);
+    // check dataset integrity
+    if (!output_dataset->is_batch() || output_dataset->batch_size() != n_contingencies) {
         handle->err_code = PGM_regular_error;
-        handle->err_msg = e.what();
-    } catch (...) {
+        handle->err_msg = "The output_dataset should be a batch with one scenario per contingency!\n";
+        return;
+    }
+    if (n_contingencies < 0 || outage_indptr[0] != 0 ||
+        !std::is_sorted(outage_indptr, outage_indptr + n_contingencies + 1)) {
         handle->err_code = PGM_regular_error;
-        handle->err_msg = "Unknown error!\n";
+        handle->err_msg = "The outage_indptr should start with zero and not be decreasing!\n";
+        return;
     }
+
+    // call calculation
+    call_calculation_with_catch(
+        handle, [model, opt, output_dataset, n_contingencies, outage_indptr, outage_ids] {
+            check_calculate_valid_options(*opt);
+
+            ContingencyList const contingencies{
+                .indptr = IdxVector(outage_indptr, outage_indptr + n_contingencies + 1),
+                .outage_ids = std::vector<ID>(outage_ids, outage_ids + outage_indptr[n_contingencies])};
+            auto const options = extract_calculation_options(*opt);
+            model->calculate_contingency(options, *output_dataset, contingencies);
+        });
+}
+
+namespace {
+// call the function template with the symmetry of the options
+template <typename Calculate> void call_with_symmetry(PGM_Options const& opt, Calculate&& calculate) {
+    if (get_calculation_symmetry(opt) == CalculationSymmetry::symmetric) {
+        std::forward<Calculate>(calculate).template operator()<symmetric_t>();
+    } else {
+        std::forward<Calculate>(calculate).template operator()<asymmetric_t>();
+    }
+}
+
+// write a tensor row major, one value for symmetric and nine values for asymmetric calculations
+template <symmetry_tag sym> double* write_tensor(RealTensor<sym> const& tensor, double* out) {
+    if constexpr (is_symmetric_v<sym>) {
+        *out = tensor;
+        return out + 1;
+    } else {
+        for (Idx i = 0; i != 3; ++i) {
+            for (Idx j = 0; j != 3; ++j) {
+                *out++ = tensor(i, j);
+            }
+        }
+        return out;
+    }
+}
+} // namespace
+
+// sensitivities of the last Newton-Raphson power flow calculation
+void PGM_calculate_power_flow_sensitivity(PGM_Handle* handle, PGM_PowerGridModel* model, PGM_Options const* opt,
+                                          PGM_Idx n_injection_nodes, PGM_ID const* injection_nodes, PGM_Idx n_nodes,
+                                          PGM_ID const* nodes, PGM_Idx n_branches, PGM_ID const* branches,
+                                          double* voltage_sensitivity, double* branch_sensitivity) {
+    PGM_clear_error(handle);
+    call_calculation_with_catch(handle, [=] {
+        call_with_symmetry(*opt, [=]<symmetry_tag sym>() {
+            auto const sensitivity = model->calculate_power_flow_sensitivity<sym>(
+                {injection_nodes, static_cast<size_t>(n_injection_nodes)}, {nodes, static_cast<size_t>(n_nodes)},
+                {branches, static_cast<size_t>(n_branches)});
+            if (voltage_sensitivity != nullptr) {
+                double* out = voltage_sensitivity;
+                for (auto const& voltage : sensitivity.voltage) {
+                    out = write_tensor<sym>(voltage.dtheta_dp, out);
+                    out = write_tensor<sym>(voltage.dtheta_dq, out);
+                    out = write_tensor<sym>(voltage.dv_dp, out);
+                    out = write_tensor<sym>(voltage.dv_dq, out);
+                }
+            }
+            if (branch_sensitivity != nullptr) {
+                double* out = branch_sensitivity;
+                for (auto const& branch : sensitivity.branch) {
+                    out = write_tensor<sym>(branch.dp_dp, out);
+                    out = write_tensor<sym>(branch.dp_dq, out);
+                    out = write_tensor<sym>(branch.dq_dp, out);
+                    out = write_tensor<sym>(branch.dq_dq, out);
+                }
+            }
+        });
+    });
+}
+
+// line outage distribution factors of the last Newton-Raphson power flow calculation
+void PGM_calculate_lodf(PGM_Handle* handle, PGM_PowerGridModel* model, PGM_Options const* opt, PGM_Idx n_branches,
+                        PGM_ID const* branches, PGM_Idx n_outage_branches, PGM_ID const* outage_branches,
+                        double* lodf) {
+    PGM_clear_error(handle);
+    call_calculation_with_catch(handle, [=] {
+        call_with_symmetry(*opt, [=]<symmetry_tag sym>() {
+            double* out = lodf;
+            for (auto const& factor : model->calculate_lodf<sym>(
+                     {branches, static_cast<size_t>(n_branches)},
+                     {outage_branches, static_cast<size_t>(n_outage_branches)})) {
+                out = write_tensor<sym>(factor, out);
+            }
+        });
+    });
+}
+
+// power transfer distribution factors of the dc power flow
+void PGM_calculate_dc_ptdf(PGM_Handle* handle, PGM_PowerGridModel* model, PGM_Options const* opt,
+                           PGM_Idx n_branches, PGM_ID const* branches, PGM_Idx n_nodes, PGM_ID const* nodes,
+                           double* ptdf) {
+    PGM_clear_error(handle);
+    call_calculation_with_catch(handle, [=] {
+        call_with_symmetry(*opt, [=]<symmetry_tag sym>() {
+            double* out = ptdf;
+            for (auto const& factor : model->calculate_dc_ptdf<sym>({branches, static_cast<size_t>(n_branches)},
+                                                                    {nodes, static_cast<size_t>(n_nodes)})) {
+                out = write_tensor<sym>(factor, out);
+            }
+        });
+    });
 }
 
 // destroy model
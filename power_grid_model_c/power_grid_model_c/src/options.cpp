@@ -7,6 +7,7 @@
 
 #include "power_grid_model_c/options.h"
 
+#include "handle.hpp"
 #include "options.hpp"
 
 namespace {
@@ -26,6 +27,14 @@ void PGM_set_symmetric(PGM_Handle* /* handle */, PGM_Options* opt, PGM_Idx sym)
 void PGM_set_err_tol(PGM_Handle* /* handle */, PGM_Options* opt, double err_tol) { opt->err_tol = err_tol; }
 void PGM_set_max_iter(PGM_Handle* /* handle */, PGM_Options* opt, PGM_Idx max_iter) { opt->max_iter = max_iter; }
 void PGM_set_threading(PGM_Handle* /* handle */, PGM_Options* opt, PGM_Idx threading) { opt->threading = threading; }
+PGM_ThreadPool* PGM_create_thread_pool(PGM_Handle* handle, PGM_Idx n_threads) {
+    return call_with_catch(
+        handle, [n_threads] { return new PGM_ThreadPool{n_threads}; }, PGM_regular_error);
+}
+void PGM_destroy_thread_pool(PGM_ThreadPool* thread_pool) { delete thread_pool; }
+void PGM_set_thread_pool(PGM_Handle* /* handle */, PGM_Options* opt, PGM_ThreadPool* thread_pool) {
+    opt->thread_pool = thread_pool;
+}
 void PGM_set_short_circuit_voltage_scaling(PGM_Handle* /* handle */, PGM_Options* opt,
                                            PGM_Idx short_circuit_voltage_scaling) {
     opt->short_circuit_voltage_scaling = short_circuit_voltage_scaling;
@@ -33,6 +42,18 @@ void PGM_set_short_circuit_voltage_scaling(PGM_Handle* /* handle */, PGM_Options
 void PGM_set_tap_changing_strategy(PGM_Handle* /* handle */, PGM_Options* opt, PGM_Idx tap_changing_strategy) {
     opt->tap_changing_strategy = tap_changing_strategy;
 }
+void PGM_set_initialization_strategy(PGM_Handle* /* handle */, PGM_Options* opt, PGM_Idx initialization_strategy) {
+    opt->initialization_strategy = initialization_strategy;
+}
+void PGM_set_jacobian_reuse(PGM_Handle* /* handle */, PGM_Options* opt, PGM_Idx jacobian_reuse) {
+    opt->jacobian_reuse = jacobian_reuse;
+}
+void PGM_set_jacobian_reuse_max_mismatch_ratio(PGM_Handle* /* handle */, PGM_Options* opt, double max_mismatch_ratio) {
+    opt->jacobian_reuse_max_mismatch_ratio = max_mismatch_ratio;
+}
+void PGM_set_se_mixed_precision(PGM_Handle* /* handle */, PGM_Options* opt, PGM_Idx se_mixed_precision) {
+    opt->se_mixed_precision = se_mixed_precision;
+}
 void PGM_set_experimental_features(PGM_Handle* /* handle */, PGM_Options* opt, PGM_Idx experimental_features) {
     opt->experimental_features = experimental_features;
 }
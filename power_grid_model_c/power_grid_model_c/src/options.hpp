@@ -13,6 +13,12 @@
 #include "power_grid_model_c/options.h"
 
 #include <power_grid_model/common/common.hpp>
+#include <power_grid_model/thread_pool.hpp>
+
+// aliases thread pool class
+struct PGM_ThreadPool : public power_grid_model::ThreadPool {
+    using ThreadPool::ThreadPool;
+};
 
 // options
 struct PGM_Options {
@@ -23,7 +29,12 @@ struct PGM_Options {
     double err_tol{1e-8};
     Idx max_iter{20};
     Idx threading{-1};
+    PGM_ThreadPool* thread_pool{nullptr};
     Idx short_circuit_voltage_scaling{PGM_short_circuit_voltage_scaling_maximum};
     Idx tap_changing_strategy{PGM_tap_changing_strategy_disabled};
+    Idx initialization_strategy{PGM_initialization_strategy_default};
+    Idx jacobian_reuse{0};
+    double jacobian_reuse_max_mismatch_ratio{0.5};
+    Idx se_mixed_precision{0};
     Idx experimental_features{PGM_experimental_features_disabled};
 };
@@ -65,6 +65,8 @@ class CalculationMethod(IntEnum):
     iterative_current = 3
     linear_current = 4
     iec60909 = 5
+    fast_decoupled = 6
+    dc = 7
 
 
 class TapChangingStrategy(IntEnum):
@@ -3,13 +3,24 @@
 // SPDX-License-Identifier: MPL-2.0
 
 #include "fictional_grid_generator.hpp"
+#include "map_set_sparse_ordering.hpp"
 
 #include <power_grid_model/auxiliary/meta_data_gen.hpp>
 #include <power_grid_model/common/common.hpp>
 #include <power_grid_model/common/timer.hpp>
 #include <power_grid_model/main_model.hpp>
+#include <power_grid_model/math_solver/common_solver_functions.hpp>
+#include <power_grid_model/math_solver/math_solver.hpp>
+#include <power_grid_model/math_solver/newton_raphson_pf_solver.hpp>
+#include <power_grid_model/math_solver/sparse_lu_mixed_precision.hpp>
+#include <power_grid_model/math_solver/sparse_lu_solver.hpp>
+#include <power_grid_model/math_solver/y_bus.hpp>
+#include <power_grid_model/sparse_ordering.hpp>
 
+#include <algorithm>
 #include <iostream>
+#include <map>
+#include <numeric>
 #include <random>
 
 namespace power_grid_model::benchmark {
@@ -20,15 +31,24 @@ struct PowerGridBenchmark {
 
     template <symmetry_tag sym>
     void run_pf(CalculationMethod calculation_method, CalculationInfo& info, Idx batch_size = -1, Idx threading = -1) {
+        BatchData const batch_data = generator.generate_batch_input(batch_size, 0);
+        run_pf<sym>(calculation_method, info, batch_data, threading);
+    }
+
+    template <symmetry_tag sym>
+    void run_pf(CalculationMethod calculation_method, CalculationInfo& info, BatchData const& batch_data,
+                Idx threading) {
         if (!main_model) {
             std::cout << "\nNo main model available: skipping benchmark.\n";
             return;
         }
 
-        OutputData<sym> output = generator.generate_output_data<sym>(batch_size);
-        BatchData const batch_data = generator.generate_batch_input(batch_size, 0);
+        OutputData<sym> output = generator.generate_output_data<sym>(batch_data.batch_size);
         std::cout << "Number of nodes: " << generator.input_data().node.size() << '\n';
-        Idx const max_iter = (calculation_method == CalculationMethod::iterative_current) ? 100 : 20;
+        Idx const max_iter = (calculation_method == CalculationMethod::iterative_current ||
+                              calculation_method == CalculationMethod::fast_decoupled)
+                                 ? 100
+                                 : 20;
         try {
             // calculate
             main_model->calculate({.calculation_type = CalculationType::power_flow,
@@ -60,6 +80,10 @@ struct PowerGridBenchmark {
             title += "Newton-Raphson method";
         } else if (calculation_method == CalculationMethod::linear) {
             title += "Linear method";
+        } else if (calculation_method == CalculationMethod::fast_decoupled) {
+            title += "Fast decoupled method";
+        } else if (calculation_method == CalculationMethod::dc) {
+            title += "DC method";
         } else {
             title += "Iterative current method";
         }
@@ -94,6 +118,406 @@ struct PowerGridBenchmark {
         std::cout << "\n\n";
     }
 
+    // batch in which every period-th scenario changes the topology
+    // with period equal to the number of threads, a fixed-stride dispatch would put all expensive scenarios on the
+    // same thread; the scheduler should keep the parallel run close to (sequential time / threads)
+    template <symmetry_tag sym>
+    void run_skewed_batch_benchmark(Option const& option, Idx batch_size, Idx period, Idx threading) {
+        generator.generate_grid(option, 0);
+        main_model = std::make_unique<MainModel>(50.0, generator.input_data().get_dataset());
+        BatchData const batch_data = generator.generate_skewed_batch_input(batch_size, period, 0);
+
+        std::string title = "Benchmark case: skewed batch, ";
+        title += option.has_mv_ring ? "meshed grid, " : "radial grid, ";
+        title += "topology change every " + std::to_string(period) + " scenarios, ";
+        title += "threading " + std::to_string(threading);
+        std::cout << "=============" << title << "=============\n";
+
+        CalculationInfo info;
+        {
+            Timer const t_total(info, 0000, "Total");
+            run_pf<sym>(CalculationMethod::newton_raphson, info, batch_data, threading);
+        }
+        print(info);
+        std::cout << "\n\n";
+    }
+
+    // N-1 check of all lines, as contingency calculation and as the equivalent batch with status updates
+    template <symmetry_tag sym>
+    void run_contingency_benchmark(Option const& option, CalculationMethod calculation_method, Idx threading) {
+        generator.generate_grid(option, 0);
+        main_model = std::make_unique<MainModel>(50.0, generator.input_data().get_dataset());
+        BatchData const batch_data = generator.generate_line_outage_input();
+        ContingencyList contingencies{};
+        for (BranchUpdate const& line_update : batch_data.line) {
+            contingencies.outage_ids.push_back(line_update.id);
+            contingencies.indptr.push_back(static_cast<Idx>(contingencies.outage_ids.size()));
+        }
+        MainModel::Options const options{.calculation_type = CalculationType::power_flow,
+                                         .calculation_symmetry = is_symmetric_v<sym> ? CalculationSymmetry::symmetric
+                                                                                     : CalculationSymmetry::asymmetric,
+                                         .calculation_method = calculation_method,
+                                         .err_tol = 1e-8,
+                                         .max_iter = 100,
+                                         .threading = threading};
+
+        std::string title = "Benchmark case: N-1 of all lines, ";
+        title += option.has_mv_ring ? "meshed grid, " : "radial grid, ";
+        title += "threading " + std::to_string(threading);
+        std::cout << "=============" << title << "=============\n";
+        std::cout << "Number of contingencies: " << contingencies.size() << '\n';
+
+        CalculationInfo info;
+        {
+            std::cout << "*****Run with batch calculation*****\n";
+            Timer const t_total(info, 0000, "Total");
+            run_pf<sym>(calculation_method, info, batch_data, threading);
+        }
+        print(info);
+        info.clear();
+        {
+            std::cout << "\n*****Run with contingency calculation*****\n";
+            OutputData<sym> output = generator.generate_output_data<sym>(contingencies.size());
+            Timer const t_total(info, 0000, "Total");
+            try {
+                main_model->calculate_contingency(options, output.get_dataset(), contingencies);
+                CalculationInfo info_extra = main_model->calculation_info();
+                info.merge(info_extra);
+            } catch (std::exception const& e) {
+                std::cout << "\nAn exception was raised during execution: " << e.what() << '\n';
+            }
+        }
+        print(info);
+        std::cout << "\n\n";
+    }
+
+    // radial feeders from one source, the buses are numbered from the end of the feeder to the source, without fill-ins
+    template <symmetry_tag sym> struct RadialFeeders {
+        std::shared_ptr<MathModelTopology const> topo_ptr;
+        math_solver::YBus<sym> y_bus;
+        PowerFlowInput<sym> input;
+    };
+
+    template <symmetry_tag sym> static RadialFeeders<sym> make_radial_feeders(Idx n_feeder, Idx n_bus_per_feeder) {
+        Idx const n_bus = n_feeder * n_bus_per_feeder + 1;
+        Idx const source_bus = n_bus - 1;
+        MathModelTopology topo;
+        topo.slack_bus = source_bus;
+        topo.phase_shift.resize(n_bus, 0.0);
+        for (Idx bus = 0; bus != source_bus; ++bus) {
+            bool const is_feeder_start = (bus + 1) % n_bus_per_feeder == 0;
+            topo.branch_bus_idx.push_back({bus, is_feeder_start ? source_bus : bus + 1});
+        }
+        IdxVector sources_indptr(n_bus + 1, 0);
+        sources_indptr.back() = 1;
+        IdxVector load_gens_indptr(n_bus + 1);
+        std::iota(load_gens_indptr.begin(), load_gens_indptr.end(), Idx{0});
+        load_gens_indptr.back() = source_bus;
+        topo.sources_per_bus = {from_sparse, sources_indptr};
+        topo.shunts_per_bus = {from_sparse, IdxVector(n_bus + 1, 0)};
+        topo.load_gens_per_bus = {from_sparse, load_gens_indptr};
+        topo.load_gen_type.resize(source_bus, LoadGenType::const_pq);
+
+        auto const tensor = [](DoubleComplex self, DoubleComplex mutual) {
+            if constexpr (is_symmetric_v<sym>) {
+                return self;
+            } else {
+                return ComplexTensor<asymmetric_t>{self, mutual};
+            }
+        };
+        ComplexTensor<sym> const y_series = tensor(100.0 - 200.0i, 20.0 - 40.0i);
+        ComplexTensor<sym> const y_shunt = tensor(0.0001i, 0.0);
+        MathModelParam<sym> param;
+        param.branch_param.resize(topo.n_branch(), {y_series + y_shunt, -y_series, -y_series, y_series + y_shunt});
+        param.source_param = {SourceCalcParam{10.0 - 50.0i, 10.0 - 50.0i}};
+        PowerFlowInput<sym> input;
+        input.source = {1.0};
+        input.s_injection.resize(source_bus, piecewise_complex_value<sym>(-0.0001 - 0.00005i));
+
+        auto topo_ptr = std::make_shared<MathModelTopology const>(std::move(topo));
+        math_solver::YBus<sym> y_bus{topo_ptr, std::make_shared<MathModelParam<sym> const>(std::move(param))};
+        return {.topo_ptr = std::move(topo_ptr), .y_bus = std::move(y_bus), .input = std::move(input)};
+    }
+
+    static std::string feeder_title(std::string const& name, bool is_symmetric, Idx n_bus) {
+        std::string title = "Benchmark case: " + name + ", ";
+        title += is_symmetric ? "symmetric, " : "asymmetric, ";
+        title += std::to_string(n_bus) + " buses";
+        return title;
+    }
+
+    // jacobian calculation of the Newton-Raphson power flow with the interleaved and the split complex layout
+    template <symmetry_tag sym> static void run_complex_layout_benchmark(Idx n_feeder, Idx n_bus_per_feeder) {
+        auto const feeders = make_radial_feeders<sym>(n_feeder, n_bus_per_feeder);
+        std::cout << "=============" << feeder_title("jacobian complex layout", is_symmetric_v<sym>, feeders.y_bus.size())
+                  << "=============\n";
+
+        Idx constexpr n_runs = 100;
+        auto const run = [&]<complex_layout_tag layout>(layout /* tag */, std::string const& name) {
+            math_solver::NewtonRaphsonPFSolver<sym, layout> solver{feeders.y_bus, feeders.topo_ptr};
+            CalculationInfo info;
+            for (Idx run_idx = 0; run_idx != n_runs; ++run_idx) {
+                solver.run_power_flow(feeders.y_bus, feeders.input, 1e-8, 20, info);
+            }
+            std::cout << "*****Run with " << name << " complex layout*****\n";
+            print(info);
+        };
+        run(interleaved_complex_t{}, "interleaved");
+        run(split_complex_t{}, "split");
+        std::cout << "\n\n";
+    }
+
+    // scenarios with different loads and the same parameters,
+    // with Newton-Raphson, with Newton-Raphson re-using the jacobian, with fast decoupled and with dc
+    template <symmetry_tag sym>
+    static void run_scenario_benchmark(Idx n_feeder, Idx n_bus_per_feeder, Idx n_scenarios) {
+        auto const feeders = make_radial_feeders<sym>(n_feeder, n_bus_per_feeder);
+        std::cout << "=============" << feeder_title("scenario", is_symmetric_v<sym>, feeders.y_bus.size())
+                  << "=============\n";
+
+        std::vector<PowerFlowInput<sym>> inputs(n_scenarios, feeders.input);
+        for (Idx scenario = 0; scenario != n_scenarios; ++scenario) {
+            double const scale = 0.8 + 0.4 * static_cast<double>(scenario) / static_cast<double>(n_scenarios);
+            for (auto& s_injection : inputs[scenario].s_injection) {
+                s_injection *= scale;
+            }
+        }
+
+        std::vector<ComplexValueVector<sym>> u_newton_raphson(n_scenarios);
+        auto const run = [&](CalculationMethod calculation_method, std::string const& name,
+                             math_solver::JacobianReuseSettings const& jacobian_reuse = {}) {
+            MathSolver<sym> solver{feeders.topo_ptr};
+            solver.set_jacobian_reuse_settings(jacobian_reuse);
+            CalculationInfo info;
+            double max_deviation = 0.0;
+            {
+                Timer const timer{info, 3301, "Scenarios"};
+                for (Idx scenario = 0; scenario != n_scenarios; ++scenario) {
+                    auto const output = solver.run_power_flow(inputs[scenario], 1e-8, 100, info, calculation_method,
+                                                              feeders.y_bus);
+                    if (calculation_method == CalculationMethod::newton_raphson && !jacobian_reuse.enabled) {
+                        u_newton_raphson[scenario] = output.u;
+                        continue;
+                    }
+                    for (size_t bus = 0; bus != output.u.size(); ++bus) {
+                        max_deviation =
+                            std::max(max_deviation, max_val(cabs(output.u[bus] - u_newton_raphson[scenario][bus])));
+                    }
+                }
+            }
+            std::cout << "*****Run with " << name << " method*****\n";
+            print(info);
+            if (calculation_method != CalculationMethod::newton_raphson || jacobian_reuse.enabled) {
+                std::cout << "Max deviation from Newton-Raphson: " << max_deviation << '\n';
+            }
+        };
+        run(CalculationMethod::newton_raphson, "Newton-Raphson");
+        run(CalculationMethod::newton_raphson, "Newton-Raphson re-using the jacobian", {.enabled = true});
+        run(CalculationMethod::fast_decoupled, "fast decoupled");
+        run(CalculationMethod::dc, "dc");
+        std::cout << "\n\n";
+    }
+
+    // factorization and solve of the admittance matrix with the source, in double and in mixed precision
+    template <symmetry_tag sym> static void run_mixed_precision_benchmark(Idx n_feeder, Idx n_bus_per_feeder) {
+        using math_solver::SparseLUMixedPrecisionSolver;
+        using math_solver::SparseLUSolver;
+
+        auto const feeders = make_radial_feeders<sym>(n_feeder, n_bus_per_feeder);
+        auto const& y_bus = feeders.y_bus;
+        Idx const n_bus = y_bus.size();
+        std::cout << "=============" << feeder_title("sparse LU precision", is_symmetric_v<sym>, n_bus)
+                  << "=============\n";
+
+        ComplexTensorVector<sym> matrix(y_bus.nnz_lu());
+        math_solver::detail::copy_y_bus<sym>(y_bus, matrix);
+        matrix[y_bus.lu_diag()[feeders.topo_ptr->slack_bus]] += ComplexTensor<sym>{10.0 - 50.0i};
+        ComplexValueVector<sym> const rhs(n_bus, ComplexValue<sym>{0.001 - 0.0005i});
+
+        Idx constexpr n_runs = 10;
+        Idx constexpr n_solves = 10;
+        ComplexValueVector<sym> x_double(n_bus);
+        {
+            SparseLUSolver<ComplexTensor<sym>, ComplexValue<sym>, ComplexValue<sym>> solver{y_bus.shared_lu_symbolic()};
+            typename decltype(solver)::BlockPermArray block_perm(n_bus);
+            ComplexTensorVector<sym> lu_data;
+            CalculationInfo info;
+            for (Idx run_idx = 0; run_idx != n_runs; ++run_idx) {
+                {
+                    Timer const timer{info, 3101, "Factorize"};
+                    lu_data = matrix;
+                    solver.prefactorize(lu_data, block_perm);
+                }
+                Timer const timer{info, 3102, "Solve"};
+                for (Idx solve_idx = 0; solve_idx != n_solves; ++solve_idx) {
+                    solver.solve_with_prefactorized_matrix(lu_data, block_perm, rhs, x_double);
+                }
+            }
+            std::cout << "*****Run with double precision*****\n";
+            print(info);
+        }
+        {
+            SparseLUMixedPrecisionSolver<ComplexTensor<sym>, ComplexValue<sym>, ComplexValue<sym>> solver{
+                y_bus.shared_lu_symbolic()};
+            ComplexValueVector<sym> x(n_bus);
+            CalculationInfo info;
+            for (Idx run_idx = 0; run_idx != n_runs; ++run_idx) {
+                {
+                    Timer const timer{info, 3101, "Factorize"};
+                    solver.prefactorize(matrix);
+                }
+                Timer const timer{info, 3102, "Solve"};
+                for (Idx solve_idx = 0; solve_idx != n_solves; ++solve_idx) {
+                    solver.solve_with_prefactorized_matrix(rhs, x);
+                }
+            }
+            double max_deviation = 0.0;
+            for (Idx bus = 0; bus != n_bus; ++bus) {
+                max_deviation = std::max(max_deviation, max_val(cabs(x[bus] - x_double[bus])));
+            }
+            std::cout << "*****Run with mixed precision*****\n";
+            print(info);
+            std::cout << "Double precision fallback: " << solver.is_double_precision() << '\n';
+            std::cout << "Refinement steps: " << solver.n_refinement_steps() << '\n';
+            std::cout << "Max deviation from double precision: " << max_deviation << '\n';
+        }
+        std::cout << "\n\n";
+    }
+
+    // solve for a single injection at the end of a feeder, the voltage is only needed at the same bus
+    template <symmetry_tag sym> static void run_sparse_solve_benchmark(Idx n_feeder, Idx n_bus_per_feeder) {
+        using math_solver::SparseLUSolver;
+
+        auto const feeders = make_radial_feeders<sym>(n_feeder, n_bus_per_feeder);
+        auto const& y_bus = feeders.y_bus;
+        Idx const n_bus = y_bus.size();
+        std::cout << "=============" << feeder_title("sparse right hand side", is_symmetric_v<sym>, n_bus)
+                  << "=============\n";
+
+        ComplexTensorVector<sym> lu_data(y_bus.nnz_lu());
+        math_solver::detail::copy_y_bus<sym>(y_bus, lu_data);
+        lu_data[y_bus.lu_diag()[feeders.topo_ptr->slack_bus]] += ComplexTensor<sym>{10.0 - 50.0i};
+        SparseLUSolver<ComplexTensor<sym>, ComplexValue<sym>, ComplexValue<sym>> solver{y_bus.shared_lu_symbolic()};
+        typename decltype(solver)::BlockPermArray block_perm(n_bus);
+        solver.prefactorize(lu_data, block_perm);
+
+        Idx constexpr n_solves = 1000;
+        IdxVector const rows{0};
+        ComplexValueVector<sym> rhs(n_bus, ComplexValue<sym>{0.0 + 0.0i});
+        rhs[0] = ComplexValue<sym>{1.0 + 0.0i};
+        ComplexValueVector<sym> x_dense(n_bus);
+        ComplexValueVector<sym> x_sparse(n_bus);
+        CalculationInfo info;
+        {
+            Timer const timer{info, 3201, "Dense solve"};
+            for (Idx solve_idx = 0; solve_idx != n_solves; ++solve_idx) {
+                solver.solve_with_prefactorized_matrix(lu_data, block_perm, rhs, x_dense);
+            }
+        }
+        {
+            Timer const timer{info, 3202, "Sparse solve"};
+            for (Idx solve_idx = 0; solve_idx != n_solves; ++solve_idx) {
+                solver.solve_sparse_with_prefactorized_matrix(lu_data, block_perm, rhs, rows, rows, x_sparse);
+            }
+        }
+        print(info);
+        std::cout << "Deviation of the sparse solve: " << max_val(cabs(x_sparse[0] - x_dense[0])) << "\n\n\n";
+    }
+
+    // iterative current power flow of radial feeders, with the sparse LU solver and with backward/forward sweeps
+    template <symmetry_tag sym> static void run_radial_sweep_benchmark(Idx n_feeder, Idx n_bus_per_feeder) {
+        auto const feeders = make_radial_feeders<sym>(n_feeder, n_bus_per_feeder);
+        std::cout << "=============" << feeder_title("radial sweep", is_symmetric_v<sym>, feeders.y_bus.size())
+                  << "=============\n";
+
+        Idx constexpr n_runs = 10;
+        ComplexValueVector<sym> u_sparse_lu;
+        auto const run = [&](auto& solver, std::string const& name) {
+            CalculationInfo info;
+            ComplexValueVector<sym> u;
+            for (Idx run_idx = 0; run_idx != n_runs; ++run_idx) {
+                u = solver.run_power_flow(feeders.y_bus, feeders.input, 1e-8, 100, info).u;
+            }
+            std::cout << "*****Run with " << name << "*****\n";
+            print(info);
+            if (u_sparse_lu.empty()) {
+                u_sparse_lu = u;
+                return;
+            }
+            double max_deviation = 0.0;
+            for (size_t bus = 0; bus != u.size(); ++bus) {
+                max_deviation = std::max(max_deviation, max_val(cabs(u[bus] - u_sparse_lu[bus])));
+            }
+            std::cout << "Max deviation from the sparse LU solver: " << max_deviation << '\n';
+        };
+        math_solver::IterativeCurrentPFSolver<sym> sparse_lu_solver{feeders.y_bus, feeders.topo_ptr};
+        run(sparse_lu_solver, "sparse LU solver");
+        math_solver::RadialSweepPFSolver<sym> sweep_solver{feeders.y_bus, feeders.topo_ptr};
+        run(sweep_solver, "backward/forward sweep");
+        std::cout << "\n\n";
+    }
+
+    // sensitivities of the voltage at the end of each feeder to the injection at the start of each feeder,
+    // with the retained factorization of the Newton-Raphson power flow
+    template <symmetry_tag sym> static void run_sensitivity_benchmark(Idx n_feeder, Idx n_bus_per_feeder) {
+        auto const feeders = make_radial_feeders<sym>(n_feeder, n_bus_per_feeder);
+        std::cout << "=============" << feeder_title("sensitivity", is_symmetric_v<sym>, feeders.y_bus.size())
+                  << "=============\n";
+
+        IdxVector injection_buses;
+        IdxVector buses;
+        for (Idx feeder = 0; feeder != n_feeder; ++feeder) {
+            injection_buses.push_back((feeder + 1) * n_bus_per_feeder - 1);
+            buses.push_back(feeder * n_bus_per_feeder);
+        }
+        MathSolver<sym> solver{feeders.topo_ptr};
+        CalculationInfo info;
+        solver.run_power_flow(feeders.input, 1e-8, 20, info, CalculationMethod::newton_raphson, feeders.y_bus);
+        {
+            Timer const timer{info, 3401, "Sensitivity"};
+            auto const sensitivity =
+                solver.calculate_power_flow_sensitivity(injection_buses, buses, {}, info, feeders.y_bus);
+            std::cout << "Number of sensitivities: " << sensitivity.voltage.size() << '\n';
+        }
+        print(info);
+        std::cout << "\n\n";
+    }
+
+    // minimum degree ordering of an n_side * n_side mesh, compared with the previous map/set implementation
+    static void run_ordering_benchmark(Idx n_side) {
+        std::map<Idx, IdxVector> graph;
+        for (Idx row = 0; row != n_side; ++row) {
+            for (Idx col = 0; col != n_side; ++col) {
+                Idx const vertex = row * n_side + col;
+                if (row + 1 != n_side) {
+                    graph[vertex].push_back(vertex + n_side);
+                }
+                if (col + 1 != n_side) {
+                    graph[vertex].push_back(vertex + 1);
+                }
+            }
+        }
+        std::cout << "=============Benchmark case: minimum degree ordering, " << n_side << " x " << n_side
+                  << " mesh=============\n";
+
+        CalculationInfo info;
+        std::pair<IdxVector, std::vector<std::pair<Idx, Idx>>> map_set_result;
+        std::pair<IdxVector, std::vector<std::pair<Idx, Idx>>> result;
+        {
+            Timer const timer{info, 3501, "Map/set ordering"};
+            map_set_result = map_set_ordering::minimum_degree_ordering(graph);
+        }
+        {
+            Timer const timer{info, 3502, "Ordering"};
+            result = minimum_degree_ordering(graph);
+        }
+        print(info);
+        std::cout << "Number of fill-ins, map/set: " << map_set_result.second.size()
+                  << ", current: " << result.second.size() << '\n';
+        std::cout << "Same ordering and fill-ins: " << std::boolalpha
+                  << (map_set_result.first == result.first && map_set_result.second == result.second) << "\n\n\n";
+    }
+
     static void print(CalculationInfo const& info) {
         for (auto const& [key, val] : info) {
             std::cout << key << ": " << val << '\n';
@@ -138,8 +562,10 @@ int main(int /* argc */, char** /* argv */) {
     option.has_lv_ring = false;
     benchmarker.run_benchmark<symmetric_t>(option, newton_raphson, batch_size);
     benchmarker.run_benchmark<symmetric_t>(option, newton_raphson, batch_size, 6);
+    benchmarker.run_benchmark<symmetric_t>(option, dc, batch_size);
     benchmarker.run_benchmark<symmetric_t>(option, linear);
     benchmarker.run_benchmark<symmetric_t>(option, iterative_current);
+    benchmarker.run_benchmark<symmetric_t>(option, fast_decoupled, batch_size);
     benchmarker.run_benchmark<asymmetric_t>(option, newton_raphson);
     benchmarker.run_benchmark<asymmetric_t>(option, linear);
     // benchmarker.run_benchmark<asymmetric_t>(option, iterative_current);
@@ -153,5 +579,44 @@ int main(int /* argc */, char** /* argv */) {
     benchmarker.run_benchmark<asymmetric_t>(option, newton_raphson);
     benchmarker.run_benchmark<asymmetric_t>(option, linear);
     // benchmarker.run_benchmark<asymmetric_t>(option, iterative_current);
+
+    // skewed batch, sequential and parallel
+    benchmarker.run_skewed_batch_benchmark<symmetric_t>(option, batch_size, 6, -1);
+    benchmarker.run_skewed_batch_benchmark<symmetric_t>(option, batch_size, 6, 6);
+
+    // N-1 check, contingency calculation compared with the equivalent batch
+    benchmarker.run_contingency_benchmark<symmetric_t>(option, newton_raphson, -1);
+    benchmarker.run_contingency_benchmark<symmetric_t>(option, iterative_current, -1);
+    benchmarker.run_contingency_benchmark<symmetric_t>(option, linear, -1);
+    benchmarker.run_contingency_benchmark<symmetric_t>(option, newton_raphson, 6);
+
+    // jacobian calculation with the interleaved and the split complex layout
+    power_grid_model::benchmark::PowerGridBenchmark::run_complex_layout_benchmark<symmetric_t>(100, 100);
+    power_grid_model::benchmark::PowerGridBenchmark::run_complex_layout_benchmark<asymmetric_t>(100, 100);
+
+    // sparse LU factorization and solve in double and in mixed precision
+    power_grid_model::benchmark::PowerGridBenchmark::run_mixed_precision_benchmark<symmetric_t>(1000, 100);
+    power_grid_model::benchmark::PowerGridBenchmark::run_mixed_precision_benchmark<asymmetric_t>(1000, 100);
+
+    // per-scenario speed of the Newton-Raphson method re-using the jacobian and of the fast decoupled method
+    power_grid_model::benchmark::PowerGridBenchmark::run_scenario_benchmark<symmetric_t>(100, 100, 100);
+    power_grid_model::benchmark::PowerGridBenchmark::run_scenario_benchmark<asymmetric_t>(100, 100, 100);
+
+    // solve with a single injection, with the full substitution and with the elimination tree reach
+    power_grid_model::benchmark::PowerGridBenchmark::run_sparse_solve_benchmark<symmetric_t>(1000, 100);
+    power_grid_model::benchmark::PowerGridBenchmark::run_sparse_solve_benchmark<asymmetric_t>(1000, 100);
+
+    // iterative current of radial feeders, with the sparse LU solver and with backward/forward sweeps
+    power_grid_model::benchmark::PowerGridBenchmark::run_radial_sweep_benchmark<symmetric_t>(100, 100);
+    power_grid_model::benchmark::PowerGridBenchmark::run_radial_sweep_benchmark<asymmetric_t>(100, 100);
+
+    // sensitivities with the retained factorization of the Newton-Raphson power flow
+    power_grid_model::benchmark::PowerGridBenchmark::run_sensitivity_benchmark<symmetric_t>(100, 100);
+    power_grid_model::benchmark::PowerGridBenchmark::run_sensitivity_benchmark<asymmetric_t>(100, 100);
+
+    // minimum degree ordering of meshes up to the size of a large meshed grid
+    power_grid_model::benchmark::PowerGridBenchmark::run_ordering_benchmark(30);
+    power_grid_model::benchmark::PowerGridBenchmark::run_ordering_benchmark(70);
+    power_grid_model::benchmark::PowerGridBenchmark::run_ordering_benchmark(140);
     return 0;
 }
@@ -75,6 +75,7 @@ template <symmetry_tag sym> struct OutputData {
 struct BatchData {
     std::vector<SymLoadGenUpdate> sym_load;
     std::vector<AsymLoadGenUpdate> asym_load;
+    std::vector<BranchUpdate> line;
     Idx batch_size{0};
 
     ConstDataset get_dataset() const {
@@ -84,6 +85,9 @@ struct BatchData {
         }
         dataset.add_buffer("sym_load", sym_load.size() / batch_size, sym_load.size(), nullptr, sym_load.data());
         dataset.add_buffer("asym_load", asym_load.size() / batch_size, asym_load.size(), nullptr, asym_load.data());
+        if (!line.empty()) {
+            dataset.add_buffer("line", line.size() / batch_size, line.size(), nullptr, line.data());
+        }
         return dataset;
     }
 };
@@ -154,6 +158,35 @@ class FictionalGridGenerator {
         return batch_data;
     }
 
+    // load series where every period-th scenario also switches off the same line
+    // those scenarios rebuild the topology and are much more expensive than the other scenarios
+    BatchData generate_skewed_batch_input(Idx batch_size, Idx period, std::random_device::result_type seed) {
+        BatchData batch_data = generate_batch_input(batch_size, seed);
+        if (input_.line.empty() || period <= 0) {
+            return batch_data;
+        }
+        ID const switched_line_id = input_.line.back().id;
+        batch_data.line.resize(batch_data.batch_size);
+        for (Idx batch = 0; batch < batch_data.batch_size; ++batch) {
+            BranchUpdate& line_update = batch_data.line[batch];
+            line_update.id = switched_line_id;
+            line_update.from_status = (batch % period == 0) ? IntS{0} : na_IntS;
+            line_update.to_status = na_IntS;
+        }
+        return batch_data;
+    }
+
+    // N-1 check of all lines: in scenario i, line i is switched off
+    BatchData generate_line_outage_input() const {
+        BatchData batch_data{};
+        batch_data.batch_size = static_cast<Idx>(input_.line.size());
+        batch_data.line.resize(input_.line.size());
+        std::ranges::transform(input_.line, batch_data.line.begin(), [](LineInput const& line) {
+            return BranchUpdate{.id = line.id, .from_status = 0, .to_status = 0};
+        });
+        return batch_data;
+    }
+
   private:
     Option option_{};
     std::mt19937_64 gen_;
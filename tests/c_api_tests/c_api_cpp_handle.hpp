@@ -18,6 +18,7 @@ template <auto func> struct DeleterFunctor {
 // unique pointers
 using HandlePtr = std::unique_ptr<PGM_Handle, DeleterFunctor<&PGM_destroy_handle>>;
 using OptionPtr = std::unique_ptr<PGM_Options, DeleterFunctor<&PGM_destroy_options>>;
+using ThreadPoolPtr = std::unique_ptr<PGM_ThreadPool, DeleterFunctor<&PGM_destroy_thread_pool>>;
 using ModelPtr = std::unique_ptr<PGM_PowerGridModel, DeleterFunctor<&PGM_destroy_model>>;
 using BufferPtr = std::unique_ptr<void, DeleterFunctor<&PGM_destroy_buffer>>;
 using SerializerPtr = std::unique_ptr<PGM_Serializer, DeleterFunctor<&PGM_destroy_serializer>>;
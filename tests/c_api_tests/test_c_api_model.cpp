@@ -183,6 +183,90 @@ TEST_CASE("C API Model") {
         CHECK(u[2] == doctest::Approx(70.0));
     }
 
+    SUBCASE("Batch power flow with thread pool") {
+        ThreadPoolPtr const unique_thread_pool{PGM_create_thread_pool(hl, 2)};
+        CHECK(PGM_error_code(hl) == PGM_no_error);
+        PGM_set_thread_pool(hl, opt, unique_thread_pool.get());
+        PGM_set_threading(hl, opt, 0);
+        // the threads of the pool are reused for repeated calculations
+        for (Idx repeat = 0; repeat != 3; ++repeat) {
+            sym_node_outputs = {};
+            PGM_calculate(hl, model, opt, batch_output_dataset, batch_update_dataset);
+            CHECK(PGM_error_code(hl) == PGM_no_error);
+            CHECK(node_result_0.u == doctest::Approx(40.0));
+            CHECK(node_result_1.u == doctest::Approx(70.0));
+        }
+        PGM_set_thread_pool(hl, opt, nullptr);
+    }
+
+    SUBCASE("Batch power flow with previous solution initialization") {
+        PGM_set_initialization_strategy(hl, opt, PGM_initialization_strategy_previous_solution);
+        PGM_calculate(hl, model, opt, batch_output_dataset, batch_update_dataset);
+        CHECK(PGM_error_code(hl) == PGM_no_error);
+        CHECK(node_result_0.u == doctest::Approx(40.0));
+        CHECK(node_result_1.u == doctest::Approx(70.0));
+    }
+
+    SUBCASE("Batch power flow with jacobian reuse") {
+        PGM_set_jacobian_reuse(hl, opt, 1);
+        PGM_set_jacobian_reuse_max_mismatch_ratio(hl, opt, 0.25);
+        PGM_calculate(hl, model, opt, batch_output_dataset, batch_update_dataset);
+        CHECK(PGM_error_code(hl) == PGM_no_error);
+        CHECK(node_result_0.u == doctest::Approx(40.0));
+        CHECK(node_result_1.u == doctest::Approx(70.0));
+    }
+
+    SUBCASE("Contingency power flow") {
+        // base case and source outage
+        std::array<Idx, 3> const outage_indptr{0, 0, 1};
+        std::array<ID, 1> outage_ids{1};
+        PGM_calculate_contingency(hl, model, opt, batch_output_dataset, 2, outage_indptr.data(), outage_ids.data());
+        CHECK(PGM_error_code(hl) == PGM_no_error);
+        CHECK(node_result_0.energized == 1);
+        CHECK(node_result_0.u == doctest::Approx(50.0));
+        CHECK(node_result_1.energized == 0);
+        CHECK(node_result_1.u == doctest::Approx(0.0));
+
+        // the model is not changed
+        PGM_calculate(hl, model, opt, single_output_dataset, nullptr);
+        CHECK(PGM_error_code(hl) == PGM_no_error);
+        CHECK(node_result_0.u == doctest::Approx(50.0));
+
+        // only branches, 3-way branches and sources can be taken out
+        outage_ids[0] = 2;
+        PGM_calculate_contingency(hl, model, opt, batch_output_dataset, 2, outage_indptr.data(), outage_ids.data());
+        CHECK(PGM_error_code(hl) == PGM_regular_error);
+
+        // one scenario of output per contingency
+        PGM_calculate_contingency(hl, model, opt, batch_output_dataset, 1, outage_indptr.data(), outage_ids.data());
+        CHECK(PGM_error_code(hl) == PGM_regular_error);
+    }
+
+    SUBCASE("Power flow sensitivity") {
+        std::array<ID, 1> const node_ids{0};
+        std::array<double, 4> voltage_sensitivity{};
+        // a previous Newton-Raphson calculation is needed
+        PGM_calculate_power_flow_sensitivity(hl, model, opt, 1, node_ids.data(), 1, node_ids.data(), 0, nullptr,
+                                             voltage_sensitivity.data(), nullptr);
+        CHECK(PGM_error_code(hl) == PGM_regular_error);
+
+        PGM_set_calculation_method(hl, opt, PGM_newton_raphson);
+        PGM_calculate(hl, model, opt, single_output_dataset, nullptr);
+        CHECK(PGM_error_code(hl) == PGM_no_error);
+        PGM_calculate_power_flow_sensitivity(hl, model, opt, 1, node_ids.data(), 1, node_ids.data(), 0, nullptr,
+                                             voltage_sensitivity.data(), nullptr);
+        CHECK(PGM_error_code(hl) == PGM_no_error);
+        // dtheta/dp, dtheta/dq, dv/dp, dv/dq, the reactive power injection raises the voltage
+        CHECK(voltage_sensitivity[3] > 0.0);
+
+        // a node is not a branch
+        std::array<double, 1> ptdf{};
+        PGM_calculate_dc_ptdf(hl, model, opt, 1, node_ids.data(), 1, node_ids.data(), ptdf.data());
+        CHECK(PGM_error_code(hl) == PGM_regular_error);
+        PGM_calculate_lodf(hl, model, opt, 0, nullptr, 0, nullptr, nullptr);
+        CHECK(PGM_error_code(hl) == PGM_no_error);
+    }
+
     SUBCASE("Input error handling") {
         using namespace std::string_literals;
 
@@ -217,6 +301,13 @@ TEST_CASE("C API Model") {
             PGM_calculate(hl, model, opt, single_output_dataset, nullptr);
         }
 
+        SUBCASE("Invalid initialization strategy error") {
+            expected_error = "get_initialization_strategy is not implemented for"s;
+
+            PGM_set_initialization_strategy(hl, opt, -128);
+            PGM_calculate(hl, model, opt, single_output_dataset, nullptr);
+        }
+
         SUBCASE("Tap changing strategy") {
             PGM_set_tap_changing_strategy(hl, opt, PGM_tap_changing_strategy_min_voltage_tap);
             CHECK_NOTHROW(PGM_calculate(hl, model, opt, single_output_dataset, nullptr));
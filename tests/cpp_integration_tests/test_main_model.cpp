@@ -1094,6 +1094,514 @@ TEST_CASE_TEMPLATE("Test main model - updates w/ alternating compute mode", sett
     main_model.restore_components(update_data);
 }
 
+TEST_CASE("Test main model - incremental parameter update") {
+    State state;
+    auto main_model = default_model(state);
+    auto const options = get_default_options(symmetric, CalculationMethod::newton_raphson);
+
+    // calculate first, so that the parameter update is applied incrementally
+    main_model.calculate<power_flow_t, symmetric_t>(options);
+
+    ConstDataset update_data{false, 1, "update", meta_data::meta_data_gen::meta_data};
+    update_data.add_buffer("shunt", state.shunt_update.size(), state.shunt_update.size(), nullptr,
+                           state.shunt_update.data());
+    main_model.update_component<permanent_update_t>(update_data);
+    auto const solver_output = main_model.calculate<power_flow_t, symmetric_t>(options);
+    main_model.output_result<Node>(solver_output, state.sym_node);
+    main_model.output_result<Appliance>(solver_output, state.sym_appliance);
+
+    // reference: the same update on a model without previous calculation
+    State ref_state;
+    auto ref_model = default_model(ref_state);
+    ref_model.update_component<permanent_update_t>(update_data);
+    auto const ref_solver_output = ref_model.calculate<power_flow_t, symmetric_t>(options);
+    ref_model.output_result<Node>(ref_solver_output, ref_state.sym_node);
+    ref_model.output_result<Appliance>(ref_solver_output, ref_state.sym_appliance);
+
+    for (size_t i = 0; i != state.sym_node.size(); ++i) {
+        CHECK(state.sym_node[i].u_pu == doctest::Approx(ref_state.sym_node[i].u_pu));
+    }
+    for (size_t i = 0; i != state.sym_appliance.size(); ++i) {
+        CHECK(state.sym_appliance[i].i == doctest::Approx(ref_state.sym_appliance[i].i));
+    }
+}
+
+TEST_CASE("Test main model - parameter update of a copied model") {
+    // meshed grid, so that the iterative current method does not use the radial sweep
+    std::vector<NodeInput> const node_input{{1, 10e3}, {2, 10e3}, {3, 10e3}};
+    std::vector<LineInput> const line_input{{4, 1, 2, 1, 1, 0.5, 2.0, 0.0, 0.0, 0.5, 2.0, 0.0, 0.0, 1e3},
+                                            {5, 2, 3, 1, 1, 0.5, 2.0, 0.0, 0.0, 0.5, 2.0, 0.0, 0.0, 1e3},
+                                            {6, 1, 3, 1, 1, 1.0, 4.0, 0.0, 0.0, 1.0, 4.0, 0.0, 0.0, 1e3}};
+    std::vector<SourceInput> const source_input{{10, 1, 1, 1.05, nan, 1e9, nan, nan}};
+    std::vector<SymLoadGenInput> const sym_load_input{{7, 2, 1, LoadGenType::const_pq, 2e6, 0.5e6}};
+    std::vector<ShuntInput> const shunt_input{{8, 3, 1, 0.015, 0.0, 0.015, 0.0}};
+    std::vector<ShuntUpdate> const shunt_update{{8, na_IntS, 0.03, nan, 0.03, nan}};
+    auto const options = get_default_options(symmetric, CalculationMethod::iterative_current);
+
+    auto const make_model = [&] {
+        auto model = std::make_unique<MainModel>(50.0, meta_data::meta_data_gen::meta_data);
+        model->add_component<Node>(node_input);
+        model->add_component<Line>(line_input);
+        model->add_component<Source>(source_input);
+        model->add_component<SymLoad>(sym_load_input);
+        model->add_component<Shunt>(shunt_input);
+        model->set_construction_complete();
+        return model;
+    };
+    ConstDataset update_data{false, 1, "update", meta_data::meta_data_gen::meta_data};
+    update_data.add_buffer("shunt", static_cast<Idx>(shunt_update.size()), static_cast<Idx>(shunt_update.size()),
+                           nullptr, shunt_update.data());
+    auto const get_node_output = [&options](MainModel& model) {
+        auto const solver_output = model.calculate<power_flow_t, symmetric_t>(options);
+        std::vector<NodeOutput<symmetric_t>> node_output(3);
+        model.output_result<Node>(solver_output, node_output);
+        return node_output;
+    };
+
+    // the solvers of the copy are independent of the original, which can be destroyed before the copy
+    auto main_model = make_model();
+    auto const base_output = get_node_output(*main_model);
+    MainModel model_copy{*main_model};
+    main_model.reset();
+    model_copy.update_component<permanent_update_t>(update_data);
+    auto const copy_output = get_node_output(model_copy);
+
+    // reference: the same update on a model without previous calculation
+    auto ref_model = make_model();
+    ref_model->update_component<permanent_update_t>(update_data);
+    auto const ref_output = get_node_output(*ref_model);
+    for (size_t i = 0; i != ref_output.size(); ++i) {
+        CHECK(copy_output[i].u_pu == doctest::Approx(ref_output[i].u_pu));
+        CHECK(copy_output[i].u_angle == doctest::Approx(ref_output[i].u_angle));
+    }
+    CHECK(copy_output[2].u_pu != doctest::Approx(base_output[2].u_pu));
+}
+
+TEST_CASE("Test main model - jacobian reuse") {
+    std::vector<NodeInput> const node_input{{1, 10e3}, {2, 10e3}, {3, 10e3}};
+    std::vector<LineInput> const line_input{{4, 1, 2, 1, 1, 0.5, 2.0, 0.0, 0.0, 0.5, 2.0, 0.0, 0.0, 1e3},
+                                            {5, 2, 3, 1, 1, 0.5, 2.0, 0.0, 0.0, 0.5, 2.0, 0.0, 0.0, 1e3},
+                                            {6, 1, 3, 1, 1, 1.0, 4.0, 0.0, 0.0, 1.0, 4.0, 0.0, 0.0, 1e3}};
+    std::vector<SourceInput> const source_input{{10, 1, 1, 1.05, nan, 1e9, nan, nan}};
+    std::vector<SymLoadGenInput> const sym_load_input{{7, 2, 1, LoadGenType::const_pq, 2e6, 0.5e6},
+                                                      {8, 3, 1, LoadGenType::const_i, 1e6, 0.2e6}};
+
+    MainModel main_model{50.0, meta_data::meta_data_gen::meta_data};
+    main_model.add_component<Node>(node_input);
+    main_model.add_component<Line>(line_input);
+    main_model.add_component<Source>(source_input);
+    main_model.add_component<SymLoad>(sym_load_input);
+    main_model.set_construction_complete();
+
+    auto const factorization_key = Timer::make_key(2233, "Number of jacobian factorizations");
+    auto const get_node_output = [&main_model](MainModel::Options const& options) {
+        auto const solver_output = main_model.calculate<power_flow_t, symmetric_t>(options);
+        std::vector<NodeOutput<symmetric_t>> node_output(3);
+        main_model.output_result<Node>(solver_output, node_output);
+        return node_output;
+    };
+
+    auto const ref_output = get_node_output(get_default_options(symmetric, CalculationMethod::newton_raphson));
+    CHECK(!main_model.calculation_info().contains(factorization_key));
+
+    auto options = get_default_options(symmetric, CalculationMethod::newton_raphson);
+    options.jacobian_reuse = true;
+    options.jacobian_reuse_max_mismatch_ratio = 0.25;
+    auto const check_output = [&ref_output](std::vector<NodeOutput<symmetric_t>> const& node_output) {
+        for (size_t i = 0; i != ref_output.size(); ++i) {
+            CHECK(node_output[i].u_pu == doctest::Approx(ref_output[i].u_pu));
+            CHECK(node_output[i].u_angle == doctest::Approx(ref_output[i].u_angle));
+        }
+    };
+    check_output(get_node_output(options));
+    double const n_factorizations = main_model.calculation_info().at(factorization_key);
+    CHECK(n_factorizations >= 1.0);
+
+    // the factorization of the previous calculation is re-used
+    check_output(get_node_output(options));
+    CHECK(main_model.calculation_info().at(factorization_key) < n_factorizations);
+}
+
+TEST_CASE("Test main model - contingency calculation") {
+    /*
+    meshed grid, one source and two loads
+
+    source_10 -- node_1 -- line_4 -- node_2 (sym_load_7)
+                   |                   |
+                 line_6             line_5
+                   |                   |
+                 node_3 (sym_load_8) --+
+    */
+    std::vector<NodeInput> const node_input{{1, 10e3}, {2, 10e3}, {3, 10e3}};
+    std::vector<LineInput> const line_input{{4, 1, 2, 1, 1, 0.5, 2.0, 0.0, 0.0, 0.5, 2.0, 0.0, 0.0, 1e3},
+                                            {5, 2, 3, 1, 1, 0.5, 2.0, 0.0, 0.0, 0.5, 2.0, 0.0, 0.0, 1e3},
+                                            {6, 1, 3, 1, 1, 1.0, 4.0, 0.0, 0.0, 1.0, 4.0, 0.0, 0.0, 1e3}};
+    std::vector<SourceInput> const source_input{{10, 1, 1, 1.05, nan, 1e9, nan, nan}};
+    std::vector<SymLoadGenInput> const sym_load_input{{7, 2, 1, LoadGenType::const_pq, 2e6, 0.5e6},
+                                                      {8, 3, 1, LoadGenType::const_pq, 1e6, 0.2e6}};
+
+    MainModel main_model{50.0, meta_data::meta_data_gen::meta_data};
+    main_model.add_component<Node>(node_input);
+    main_model.add_component<Line>(line_input);
+    main_model.add_component<Source>(source_input);
+    main_model.add_component<SymLoad>(sym_load_input);
+    main_model.set_construction_complete();
+
+    // single line outages keep the topology, the double outage disconnects node 2 and 3, the last one is the base case
+    ContingencyList const contingencies{.indptr = {0, 1, 2, 3, 5, 6, 6}, .outage_ids = {4, 5, 6, 4, 6, 10}};
+    Idx const n_contingencies = contingencies.size();
+
+    // reference: the equivalent batch calculation with status updates
+    std::vector<BranchUpdate> const line_update{{4, 0, 0}, {5, 0, 0}, {6, 0, 0}, {4, 0, 0}, {6, 0, 0}};
+    IdxVector const line_update_indptr{0, 1, 2, 3, 5, 5, 5};
+    std::vector<SourceUpdate> const source_update{{10, 0, nan, nan}};
+    IdxVector const source_update_indptr{0, 0, 0, 0, 0, 1, 1};
+    ConstDataset update_data{true, n_contingencies, "update", meta_data::meta_data_gen::meta_data};
+    update_data.add_buffer("line", -1, static_cast<Idx>(line_update.size()), line_update_indptr.data(),
+                           line_update.data());
+    update_data.add_buffer("source", -1, static_cast<Idx>(source_update.size()), source_update_indptr.data(),
+                           source_update.data());
+
+    auto const check_contingency = [&](CalculationMethod calculation_method, Idx threading) {
+        CAPTURE(calculation_method);
+        CAPTURE(threading);
+        auto const options = get_default_options(symmetric, calculation_method, threading);
+
+        std::vector<NodeOutput<symmetric_t>> node_output(node_input.size() * n_contingencies);
+        std::vector<BranchOutput<symmetric_t>> line_output(line_input.size() * n_contingencies);
+        MutableDataset result_data{true, n_contingencies, "sym_output", meta_data::meta_data_gen::meta_data};
+        result_data.add_buffer("node", static_cast<Idx>(node_input.size()), static_cast<Idx>(node_output.size()),
+                               nullptr, node_output.data());
+        result_data.add_buffer("line", static_cast<Idx>(line_input.size()), static_cast<Idx>(line_output.size()),
+                               nullptr, line_output.data());
+        MainModel contingency_model{main_model};
+        contingency_model.calculate_contingency(options, result_data, contingencies);
+
+        std::vector<NodeOutput<symmetric_t>> ref_node_output(node_output.size());
+        std::vector<BranchOutput<symmetric_t>> ref_line_output(line_output.size());
+        MutableDataset ref_result_data{true, n_contingencies, "sym_output", meta_data::meta_data_gen::meta_data};
+        ref_result_data.add_buffer("node", static_cast<Idx>(node_input.size()),
+                                   static_cast<Idx>(ref_node_output.size()), nullptr, ref_node_output.data());
+        ref_result_data.add_buffer("line", static_cast<Idx>(line_input.size()),
+                                   static_cast<Idx>(ref_line_output.size()), nullptr, ref_line_output.data());
+        MainModel ref_model{main_model};
+        ref_model.calculate(options, ref_result_data, update_data);
+
+        for (size_t i = 0; i != node_output.size(); ++i) {
+            CHECK(node_output[i].id == ref_node_output[i].id);
+            CHECK(node_output[i].energized == ref_node_output[i].energized);
+            CHECK(node_output[i].u_pu == doctest::Approx(ref_node_output[i].u_pu));
+            CHECK(node_output[i].u_angle == doctest::Approx(ref_node_output[i].u_angle));
+        }
+        for (size_t i = 0; i != line_output.size(); ++i) {
+            CHECK(line_output[i].id == ref_line_output[i].id);
+            CHECK(line_output[i].energized == ref_line_output[i].energized);
+            CHECK(line_output[i].p_from == doctest::Approx(ref_line_output[i].p_from));
+            CHECK(line_output[i].q_to == doctest::Approx(ref_line_output[i].q_to));
+            CHECK(line_output[i].i_from == doctest::Approx(ref_line_output[i].i_from));
+        }
+        // outaged lines are not energized, the double outage disconnects node 2 and 3
+        // the source outage de-energizes all nodes
+        CHECK(line_output[0].energized == 0);
+        CHECK(line_output[1].energized == 1);
+        CHECK(line_output[3 + 1].energized == 0);
+        CHECK(node_output[3 * 3 + 0].energized == 1);
+        CHECK(node_output[3 * 3 + 1].energized == 0);
+        CHECK(node_output[4 * 3 + 0].energized == 0);
+        CHECK(node_output[5 * 3 + 2].energized == 1);
+    };
+
+    SUBCASE("Compare with batch calculation") {
+        for (auto const calculation_method : {CalculationMethod::newton_raphson, CalculationMethod::iterative_current,
+                                              CalculationMethod::linear}) {
+            check_contingency(calculation_method, -1);
+            check_contingency(calculation_method, 2);
+        }
+    }
+
+    SUBCASE("Previous solution initialization") {
+        auto options = get_default_options(symmetric, CalculationMethod::newton_raphson);
+        options.initialization_strategy = InitializationStrategy::previous_solution;
+        std::vector<NodeOutput<symmetric_t>> node_output(node_input.size() * n_contingencies);
+        MutableDataset result_data{true, n_contingencies, "sym_output", meta_data::meta_data_gen::meta_data};
+        result_data.add_buffer("node", static_cast<Idx>(node_input.size()), static_cast<Idx>(node_output.size()),
+                               nullptr, node_output.data());
+        main_model.calculate_contingency(options, result_data, contingencies);
+
+        // the base case without outages, calculated after the other contingencies
+        auto const base_output = main_model.calculate<power_flow_t, symmetric_t>(
+            get_default_options(symmetric, CalculationMethod::newton_raphson));
+        std::vector<NodeOutput<symmetric_t>> base_node_output(node_input.size());
+        main_model.output_result<Node>(base_output, base_node_output);
+        for (size_t i = 0; i != base_node_output.size(); ++i) {
+            CHECK(node_output[5 * 3 + i].u_pu == doctest::Approx(base_node_output[i].u_pu));
+        }
+    }
+
+    SUBCASE("Invalid outage") {
+        std::vector<NodeOutput<symmetric_t>> node_output(node_input.size());
+        MutableDataset result_data{true, 1, "sym_output", meta_data::meta_data_gen::meta_data};
+        result_data.add_buffer("node", static_cast<Idx>(node_input.size()), static_cast<Idx>(node_output.size()),
+                               nullptr, node_output.data());
+        auto const options = get_default_options(symmetric, CalculationMethod::newton_raphson);
+        CHECK_THROWS_AS(main_model.calculate_contingency(options, result_data, {.indptr = {0, 1}, .outage_ids = {7}}),
+                        IDWrongType);
+        CHECK_THROWS_AS(main_model.calculate_contingency(options, result_data, {.indptr = {0, 1}, .outage_ids = {99}}),
+                        IDNotFound);
+    }
+}
+
+TEST_CASE("Test main model - sensitivities by id") {
+    /*
+    meshed grid with one source and two loads, and a separate island
+
+    source_10 -- node_1 -- line_4 -- node_2 (sym_load_7)
+                   |                   |
+                 line_6             line_5
+                   |                   |
+                 node_3 (sym_load_8) --+
+
+    source_13 -- node_11 -- line_14 -- node_12 (sym_load_15)
+    */
+    std::vector<NodeInput> const node_input{{1, 10e3}, {2, 10e3}, {3, 10e3}, {11, 10e3}, {12, 10e3}};
+    std::vector<LineInput> const line_input{{4, 1, 2, 1, 1, 0.5, 2.0, 0.0, 0.0, 0.5, 2.0, 0.0, 0.0, 1e3},
+                                            {5, 2, 3, 1, 1, 0.5, 2.0, 0.0, 0.0, 0.5, 2.0, 0.0, 0.0, 1e3},
+                                            {6, 1, 3, 1, 1, 1.0, 4.0, 0.0, 0.0, 1.0, 4.0, 0.0, 0.0, 1e3},
+                                            {14, 11, 12, 1, 1, 0.5, 2.0, 0.0, 0.0, 0.5, 2.0, 0.0, 0.0, 1e3}};
+    std::vector<SourceInput> const source_input{{10, 1, 1, 1.05, nan, 1e9, nan, nan},
+                                                {13, 11, 1, 1.05, nan, 1e9, nan, nan}};
+    std::vector<SymLoadGenInput> const sym_load_input{{7, 2, 1, LoadGenType::const_pq, 2e6, 0.5e6},
+                                                      {8, 3, 1, LoadGenType::const_pq, 1e6, 0.2e6},
+                                                      {15, 12, 1, LoadGenType::const_pq, 1e6, 0.2e6}};
+
+    MainModel main_model{50.0, meta_data::meta_data_gen::meta_data};
+    main_model.add_component<Node>(node_input);
+    main_model.add_component<Line>(line_input);
+    main_model.add_component<Source>(source_input);
+    main_model.add_component<SymLoad>(sym_load_input);
+    main_model.set_construction_complete();
+
+    auto const options = get_default_options(symmetric, CalculationMethod::newton_raphson);
+    std::vector<NodeOutput<symmetric_t>> node_output(node_input.size());
+    std::vector<BranchOutput<symmetric_t>> branch_output(line_input.size());
+    auto const calculate = [&] {
+        auto const solver_output = main_model.calculate<power_flow_t, symmetric_t>(options);
+        main_model.output_result<Node>(solver_output, node_output);
+        main_model.output_result<Branch>(solver_output, branch_output);
+    };
+
+    std::array<ID, 2> const injection_nodes{2, 12};
+    std::array<ID, 3> const nodes{3, 12, 2};
+    std::array<ID, 3> const branches{14, 4, 5};
+
+    SUBCASE("Power flow sensitivity") {
+        // a previous Newton-Raphson calculation is needed
+        CHECK_THROWS_AS(main_model.calculate_power_flow_sensitivity<symmetric_t>(injection_nodes, nodes, branches),
+                        CalculationError);
+        calculate();
+        auto const sensitivity =
+            main_model.calculate_power_flow_sensitivity<symmetric_t>(injection_nodes, nodes, branches);
+        REQUIRE(sensitivity.voltage.size() == nodes.size() * injection_nodes.size());
+        REQUIRE(sensitivity.branch.size() == branches.size() * injection_nodes.size());
+
+        // no sensitivity between the islands
+        CHECK(sensitivity.voltage[0 * 2 + 1].dv_dp == 0.0);
+        CHECK(sensitivity.voltage[1 * 2 + 0].dv_dp == 0.0);
+        CHECK(sensitivity.branch[0 * 2 + 0].dp_dp == 0.0);
+        CHECK(sensitivity.branch[1 * 2 + 1].dp_dp == 0.0);
+
+        // central difference of the injection at node 2, by the load at node 2
+        constexpr double delta = 1e3;
+        constexpr double delta_pu = delta / base_power<symmetric_t>;
+        constexpr double tolerance = 1e-4;
+        auto const run = [&](double p_load) {
+            std::vector<SymLoadGenUpdate> const load_update{{7, na_IntS, p_load, nan}};
+            ConstDataset update_data{false, 1, "update", meta_data::meta_data_gen::meta_data};
+            update_data.add_buffer("sym_load", 1, 1, nullptr, load_update.data());
+            main_model.update_component<permanent_update_t>(update_data);
+            calculate();
+            return std::pair{node_output, branch_output};
+        };
+        auto const [node_plus, branch_plus] = run(2e6 - delta);
+        auto const [node_minus, branch_minus] = run(2e6 + delta);
+        auto const diff_u_pu = [&node_plus, &node_minus](Idx seq) {
+            return (node_plus[seq].u_pu - node_minus[seq].u_pu) / (2.0 * delta_pu);
+        };
+        auto const diff_angle = [&node_plus, &node_minus](Idx seq) {
+            return (node_plus[seq].u_angle - node_minus[seq].u_angle) / (2.0 * delta_pu);
+        };
+        CHECK(sensitivity.voltage[2 * 2 + 0].dv_dp == doctest::Approx(diff_u_pu(1)).epsilon(tolerance));
+        CHECK(sensitivity.voltage[2 * 2 + 0].dtheta_dp == doctest::Approx(diff_angle(1)).epsilon(tolerance));
+        CHECK(sensitivity.voltage[0 * 2 + 0].dv_dp == doctest::Approx(diff_u_pu(2)).epsilon(tolerance));
+        CHECK(sensitivity.branch[1 * 2 + 0].dp_dp ==
+              doctest::Approx((branch_plus[0].p_from - branch_minus[0].p_from) / (2.0 * delta)).epsilon(tolerance));
+        CHECK(sensitivity.branch[2 * 2 + 0].dp_dp ==
+              doctest::Approx((branch_plus[1].p_from - branch_minus[1].p_from) / (2.0 * delta)).epsilon(tolerance));
+    }
+
+    SUBCASE("Line outage distribution factors") {
+        calculate();
+        std::array<ID, 2> const outage_branches{6, 14};
+        auto const lodf = main_model.calculate_lodf<symmetric_t>(branches, outage_branches);
+        REQUIRE(lodf.size() == branches.size() * outage_branches.size());
+        CHECK(lodf[0 * 2 + 1] == doctest::Approx(-1.0));
+        CHECK(lodf[0 * 2 + 0] == 0.0);
+        CHECK(lodf[1 * 2 + 1] == 0.0);
+        // the flow of line 6 is taken over by line 4 and line 5 in series
+        CHECK(lodf[1 * 2 + 0] == doctest::Approx(lodf[2 * 2 + 0]).epsilon(0.05));
+        CHECK(lodf[1 * 2 + 0] > 0.9);
+    }
+
+    SUBCASE("DC power transfer distribution factors") {
+        std::array<ID, 3> const ptdf_nodes{1, 2, 12};
+        auto const ptdf = main_model.calculate_dc_ptdf<symmetric_t>(branches, ptdf_nodes);
+        REQUIRE(ptdf.size() == branches.size() * ptdf_nodes.size());
+        // the injection at the source node does not change the flows
+        CHECK(ptdf[1 * 3 + 0] == doctest::Approx(0.0));
+        CHECK(ptdf[2 * 3 + 0] == doctest::Approx(0.0));
+        // the injection at node 2 flows through line 4 and line 5
+        CHECK(-ptdf[1 * 3 + 1] + ptdf[2 * 3 + 1] == doctest::Approx(1.0));
+        // the injection at node 12 flows through line 14 only
+        CHECK(ptdf[0 * 3 + 2] == doctest::Approx(-1.0));
+        CHECK(ptdf[1 * 3 + 2] == 0.0);
+        CHECK(ptdf[0 * 3 + 1] == 0.0);
+    }
+
+    SUBCASE("Invalid ids") {
+        std::array<ID, 1> const node_as_branch{1};
+        std::array<ID, 1> const unknown{99};
+        CHECK_THROWS_AS(main_model.calculate_dc_ptdf<symmetric_t>(node_as_branch, nodes), IDWrongType);
+        CHECK_THROWS_AS(main_model.calculate_dc_ptdf<symmetric_t>(branches, unknown), IDNotFound);
+    }
+}
+
+TEST_CASE("Test main model - batch scenarios keeping the base topology") {
+    /*
+    meshed grid, one source and two loads, line 9 is open at the from side
+
+    source_10 -- node_1 -- line_4 -- node_2 (sym_load_7)
+                   |                   |   |
+                 line_6          line_5   line_9 (open)
+                   |                   |   |
+                 node_3 (sym_load_8) --+---+
+    */
+    std::vector<NodeInput> const node_input{{1, 10e3}, {2, 10e3}, {3, 10e3}};
+    std::vector<LineInput> const line_input{{4, 1, 2, 1, 1, 0.5, 2.0, 0.0, 0.0, 0.5, 2.0, 0.0, 0.0, 1e3},
+                                            {5, 2, 3, 1, 1, 0.5, 2.0, 1e-6, 0.0, 0.5, 2.0, 1e-6, 0.0, 1e3},
+                                            {6, 1, 3, 1, 1, 1.0, 4.0, 0.0, 0.0, 1.0, 4.0, 0.0, 0.0, 1e3},
+                                            {9, 2, 3, 0, 1, 1.0, 4.0, 1e-6, 0.0, 1.0, 4.0, 1e-6, 0.0, 1e3}};
+    std::vector<SourceInput> const source_input{{10, 1, 1, 1.05, nan, 1e9, nan, nan}};
+    std::vector<SymLoadGenInput> const sym_load_input{{7, 2, 1, LoadGenType::const_pq, 2e6, 0.5e6},
+                                                      {8, 3, 1, LoadGenType::const_pq, 1e6, 0.2e6}};
+    std::vector<SymVoltageSensorInput> const sym_voltage_sensor_input{{20, 1, 100.0, 10.5e3, 0.0}};
+    std::vector<SymPowerSensorInput> const sym_power_sensor_input{
+        {21, 7, MeasuredTerminalType::load, 1e3, 2e6, 0.5e6, nan, nan},
+        {22, 8, MeasuredTerminalType::load, 1e3, 1e6, 0.2e6, nan, nan},
+        {23, 4, MeasuredTerminalType::branch_from, 1e3, 2.02e6, 0.52e6, nan, nan}};
+
+    MainModel main_model{50.0, meta_data::meta_data_gen::meta_data};
+    main_model.add_component<Node>(node_input);
+    main_model.add_component<Line>(line_input);
+    main_model.add_component<Source>(source_input);
+    main_model.add_component<SymLoad>(sym_load_input);
+    main_model.add_component<SymVoltageSensor>(sym_voltage_sensor_input);
+    main_model.add_component<SymPowerSensor>(sym_power_sensor_input);
+    main_model.set_construction_complete();
+
+    /*
+    0: switch off line 6, keeps the topology
+    1: switch off line 4 and 6, disconnects node 2 and 3
+    2: switch off the from side of line 5, keeps the topology
+    3: switch on line 9, rebuilds the topology
+    4: switch off line 4, keeps the topology, except for the state estimation with the power sensor on line 4
+    5: no change
+    */
+    std::vector<BranchUpdate> const line_update{{6, 0, 0}, {4, 0, 0}, {6, 0, 0}, {5, 0, na_IntS}, {9, 1, 1}, {4, 0, 0}};
+    IdxVector const line_update_indptr{0, 1, 3, 4, 5, 6, 6};
+    Idx const n_scenarios = static_cast<Idx>(line_update_indptr.size()) - 1;
+    ConstDataset update_data{true, n_scenarios, "update", meta_data::meta_data_gen::meta_data};
+    update_data.add_buffer("line", -1, static_cast<Idx>(line_update.size()), line_update_indptr.data(),
+                           line_update.data());
+
+    auto const check_batch = [&](MainModel::Options const& options) {
+        CAPTURE(options.calculation_method);
+        CAPTURE(options.threading);
+        Idx const n_node = static_cast<Idx>(node_input.size());
+        Idx const n_line = static_cast<Idx>(line_input.size());
+        Idx const n_sensor = static_cast<Idx>(sym_power_sensor_input.size());
+        bool const is_se = options.calculation_type == CalculationType::state_estimation;
+
+        std::vector<NodeOutput<symmetric_t>> node_output(n_node * n_scenarios);
+        std::vector<BranchOutput<symmetric_t>> line_output(n_line * n_scenarios);
+        MutableDataset result_data{true, n_scenarios, "sym_output", meta_data::meta_data_gen::meta_data};
+        result_data.add_buffer("node", n_node, n_node * n_scenarios, nullptr, node_output.data());
+        result_data.add_buffer("line", n_line, n_line * n_scenarios, nullptr, line_output.data());
+        std::vector<PowerSensorOutput<symmetric_t>> sensor_output(is_se ? n_sensor * n_scenarios : 0);
+        if (is_se) {
+            result_data.add_buffer("sym_power_sensor", n_sensor, n_sensor * n_scenarios, nullptr,
+                                   sensor_output.data());
+        }
+        MainModel batch_model{main_model};
+        batch_model.calculate(options, result_data, update_data);
+
+        // reference: each scenario in a new copy of the model, of which the topology is rebuilt
+        std::vector<NodeOutput<symmetric_t>> ref_node_output(node_output.size());
+        std::vector<BranchOutput<symmetric_t>> ref_line_output(line_output.size());
+        std::vector<PowerSensorOutput<symmetric_t>> ref_sensor_output(sensor_output.size());
+        for (Idx scenario = 0; scenario != n_scenarios; ++scenario) {
+            MutableDataset ref_result_data{false, 1, "sym_output", meta_data::meta_data_gen::meta_data};
+            ref_result_data.add_buffer("node", n_node, n_node, nullptr, ref_node_output.data() + scenario * n_node);
+            ref_result_data.add_buffer("line", n_line, n_line, nullptr, ref_line_output.data() + scenario * n_line);
+            if (is_se) {
+                ref_result_data.add_buffer("sym_power_sensor", n_sensor, n_sensor, nullptr,
+                                           ref_sensor_output.data() + scenario * n_sensor);
+            }
+            MainModel ref_model{main_model};
+            ref_model.update_component<permanent_update_t>(update_data.get_individual_scenario(scenario));
+            ref_model.calculate(options, ref_result_data);
+        }
+
+        for (size_t i = 0; i != node_output.size(); ++i) {
+            CHECK(node_output[i].energized == ref_node_output[i].energized);
+            CHECK(node_output[i].u_pu == doctest::Approx(ref_node_output[i].u_pu));
+            CHECK(node_output[i].u_angle == doctest::Approx(ref_node_output[i].u_angle));
+        }
+        for (size_t i = 0; i != line_output.size(); ++i) {
+            CHECK(line_output[i].energized == ref_line_output[i].energized);
+            CHECK(line_output[i].p_from == doctest::Approx(ref_line_output[i].p_from));
+            CHECK(line_output[i].q_from == doctest::Approx(ref_line_output[i].q_from));
+            CHECK(line_output[i].p_to == doctest::Approx(ref_line_output[i].p_to));
+            CHECK(line_output[i].i_to == doctest::Approx(ref_line_output[i].i_to));
+        }
+        // the measurements of a switched off line are ignored
+        for (size_t i = 0; i != sensor_output.size(); ++i) {
+            CHECK(sensor_output[i].energized == ref_sensor_output[i].energized);
+            CHECK(sensor_output[i].p_residual == doctest::Approx(ref_sensor_output[i].p_residual));
+            CHECK(sensor_output[i].q_residual == doctest::Approx(ref_sensor_output[i].q_residual));
+        }
+        // the switched off lines are not energized
+        CHECK(line_output[0 * n_line + 2].energized == 0);
+        CHECK(line_output[4 * n_line + 0].energized == 0);
+        CHECK(node_output[1 * n_node + 1].energized == 0);
+        CHECK(line_output[3 * n_line + 3].energized == 1);
+    };
+
+    SUBCASE("Power flow") {
+        for (auto const calculation_method : {CalculationMethod::newton_raphson, CalculationMethod::iterative_current,
+                                              CalculationMethod::linear}) {
+            check_batch(get_default_options(symmetric, calculation_method, -1));
+            check_batch(get_default_options(symmetric, calculation_method, 2));
+        }
+    }
+
+    SUBCASE("State estimation") {
+        auto options = get_default_options(symmetric, CalculationMethod::iterative_linear);
+        options.calculation_type = CalculationType::state_estimation;
+        options.max_iter = 100;
+        check_batch(options);
+    }
+}
+
 TEST_CASE("Test main model - runtime dispatch") {
     using CalculationMethod::newton_raphson;
 
@@ -13,6 +13,8 @@
 
 namespace power_grid_model {
 namespace {
+using CalculationMethod::dc;
+using CalculationMethod::fast_decoupled;
 using CalculationMethod::iterative_current;
 using CalculationMethod::iterative_linear;
 using CalculationMethod::linear;
@@ -329,6 +331,20 @@ TEST_CASE("Test math solver") {
     YBus<symmetric_t> y_bus_sym{topo_ptr, param_ptr};
     YBus<asymmetric_t> const y_bus_asym{topo_ptr, param_asym_ptr};
 
+    // the symmetric network as asymmetric network, without coupling between the phases
+    MathModelParam<asymmetric_t> param_decoupled;
+    for (auto const& branch : param.branch_param) {
+        BranchCalcParam<asymmetric_t> branch_decoupled{};
+        for (size_t i = 0; i != branch.value.size(); ++i) {
+            branch_decoupled.value[i] = ComplexTensor<asymmetric_t>{branch.value[i], 0.0};
+        }
+        param_decoupled.branch_param.push_back(branch_decoupled);
+    }
+    param_decoupled.shunt_param = {ComplexTensor<asymmetric_t>{param.shunt_param[0], 0.0}};
+    param_decoupled.source_param = param.source_param;
+    YBus<asymmetric_t> const y_bus_decoupled{topo_ptr,
+                                             std::make_shared<MathModelParam<asymmetric_t> const>(param_decoupled)};
+
     // state estimation input
     // symmetric, with u angle, with u angle and const z, without u angle
     StateEstimationInput<symmetric_t> se_input_angle;
@@ -453,6 +469,237 @@ TEST_CASE("Test math solver") {
         assert_output(output, output_ref);
     }
 
+    SUBCASE("Test iterative current pf solver partial refactorization") {
+        auto const key = Timer::make_key(2229, "Number of partial refactorizations");
+        math_solver::IterativeCurrentPFSolver<symmetric_t> solver{y_bus_sym, topo_ptr};
+        CalculationInfo info;
+        SolverOutput<symmetric_t> output = solver.run_power_flow(y_bus_sym, pf_input, 1e-12, 20, info);
+        assert_output(output, output_ref);
+        CHECK(info[key] == 0.0);
+
+        // change the shunt, the same solver only refactorizes the affected rows
+        MathModelParam<symmetric_t> param_changed = param;
+        param_changed.shunt_param[0] *= 1.1;
+        YBus<symmetric_t> y_bus_changed{y_bus_sym};
+        y_bus_changed.update_admittance(std::make_shared<MathModelParam<symmetric_t> const>(param_changed));
+        CalculationInfo changed_info;
+        output = solver.run_power_flow(y_bus_changed, pf_input, 1e-12, 20, changed_info);
+        CHECK(changed_info[key] == 1.0);
+
+        // same result as a new solver with a full factorization
+        math_solver::IterativeCurrentPFSolver<symmetric_t> new_solver{y_bus_changed, topo_ptr};
+        CalculationInfo new_info;
+        SolverOutput<symmetric_t> const output_changed_ref =
+            new_solver.run_power_flow(y_bus_changed, pf_input, 1e-12, 20, new_info);
+        CHECK(new_info[key] == 0.0);
+        assert_output(output, output_changed_ref);
+    }
+
+    SUBCASE("Test radial sweep pf solver") {
+        // the test network is radial, the math solver uses the sweeps for the iterative current methods
+        CHECK(math_solver::RadialSweepPFSolver<symmetric_t>::is_radial(topo));
+        MathModelTopology topo_meshed = topo;
+        topo_meshed.branch_bus_idx.push_back({0, 2});
+        CHECK(!math_solver::RadialSweepPFSolver<symmetric_t>::is_radial(topo_meshed));
+        MathModelTopology topo_parallel = topo;
+        topo_parallel.branch_bus_idx.push_back({1, 0});
+        CHECK(math_solver::RadialSweepPFSolver<symmetric_t>::is_radial(topo_parallel));
+
+        // the same iteration as with the sparse LU solver
+        auto const iter_key = Timer::make_key(2226, "Max number of iterations");
+        CalculationInfo info;
+        math_solver::RadialSweepPFSolver<symmetric_t> solver_sym{y_bus_sym, topo_ptr};
+        assert_output(solver_sym.run_power_flow(y_bus_sym, pf_input, 1e-12, 20, info), output_ref);
+        CalculationInfo ref_info;
+        math_solver::IterativeCurrentPFSolver<symmetric_t> ref_solver_sym{y_bus_sym, topo_ptr};
+        assert_output(ref_solver_sym.run_power_flow(y_bus_sym, pf_input, 1e-12, 20, ref_info), output_ref);
+        CHECK(info[iter_key] == ref_info[iter_key]);
+
+        math_solver::RadialSweepPFSolver<asymmetric_t> solver_asym{y_bus_asym, topo_ptr};
+        assert_output(solver_asym.run_power_flow(y_bus_asym, pf_input_asym, 1e-12, 20, info), output_ref_asym);
+
+        // warm start
+        CalculationInfo warm_info;
+        assert_output(solver_sym.run_power_flow(y_bus_sym, pf_input, 1e-12, 20, warm_info, output_ref.u), output_ref);
+        CHECK(warm_info[iter_key] == 1.0);
+    }
+
+    SUBCASE("Test symmetric fast decoupled pf solver") {
+        auto const iter_key = Timer::make_key(2226, "Max number of iterations");
+        auto const fallback_key = Timer::make_key(2232, "Number of fallbacks to Newton-Raphson");
+        MathSolver<symmetric_t> solver{topo_ptr};
+        CalculationInfo info;
+        SolverOutput<symmetric_t> output = solver.run_power_flow(pf_input, 1e-12, 100, info, fast_decoupled, y_bus_sym);
+        assert_output(output, output_ref);
+        CHECK(!info.contains(fallback_key));
+        Idx const n_iter = static_cast<Idx>(info[iter_key]);
+        // linear convergence
+        CHECK(n_iter > 5);
+
+        // the factorization is re-used
+        info.clear();
+        output = solver.run_power_flow(pf_input, 1e-12, 100, info, fast_decoupled, y_bus_sym);
+        assert_output(output, output_ref);
+        CHECK(static_cast<Idx>(info[iter_key]) == n_iter);
+
+        SUBCASE("Fall back to Newton-Raphson") {
+            info.clear();
+            output = solver.run_power_flow(pf_input, 1e-12, 5, info, fast_decoupled, y_bus_sym);
+            assert_output(output, output_ref);
+            CHECK(info[fallback_key] == 1.0);
+        }
+    }
+
+    SUBCASE("Test warm start pf solver") {
+        auto const key = Timer::make_key(2226, "Max number of iterations");
+        for (auto const method : {newton_raphson, iterative_current}) {
+            MathSolver<symmetric_t> solver{topo_ptr};
+            CalculationInfo cold_info;
+            SolverOutput<symmetric_t> output = solver.run_power_flow(pf_input, 1e-12, 20, cold_info, method, y_bus_sym,
+                                                                     InitializationStrategy::previous_solution);
+            assert_output(output, output_ref);
+
+            // start from the converged solution of the same input
+            CalculationInfo warm_info;
+            output = solver.run_power_flow(pf_input, 1e-12, 20, warm_info, method, y_bus_sym,
+                                           InitializationStrategy::previous_solution);
+            assert_output(output, output_ref);
+            CHECK(warm_info[key] == 1.0);
+            CHECK(warm_info[key] < cold_info[key]);
+
+            // no previous solution after clearing the solver
+            solver.clear_solver();
+            CalculationInfo cleared_info;
+            output = solver.run_power_flow(pf_input, 1e-12, 20, cleared_info, method, y_bus_sym,
+                                           InitializationStrategy::previous_solution);
+            assert_output(output, output_ref);
+            CHECK(cleared_info[key] == cold_info[key]);
+        }
+    }
+
+    SUBCASE("Test parallel sparse lu pf solver") {
+        ThreadPool thread_pool{2};
+        for (auto const method : {newton_raphson, iterative_current}) {
+            MathSolver<symmetric_t> solver{topo_ptr};
+            solver.set_lu_parallelism({.thread_pool = &thread_pool, .n_threads = 2, .min_size = 0});
+            CalculationInfo info;
+            SolverOutput<symmetric_t> const output =
+                solver.run_power_flow(pf_input, 1e-12, 20, info, method, y_bus_sym);
+            assert_output(output, output_ref);
+        }
+    }
+
+    SUBCASE("Test pf solver with jacobian reuse") {
+        auto const iter_key = Timer::make_key(2226, "Max number of iterations");
+        auto const factorization_key = Timer::make_key(2233, "Number of jacobian factorizations");
+
+        MathSolver<symmetric_t> solver{topo_ptr};
+        solver.set_jacobian_reuse_settings({.enabled = true});
+        CalculationInfo info;
+        SolverOutput<symmetric_t> output = solver.run_power_flow(pf_input, 1e-12, 20, info, newton_raphson, y_bus_sym);
+        assert_output(output, output_ref);
+        CHECK(info[factorization_key] >= 1.0);
+        CHECK(info[factorization_key] < info[iter_key]);
+
+        // the factorization of the previous calculation is re-used for a slightly different input
+        PowerFlowInput<symmetric_t> pf_input_scaled = pf_input;
+        for (auto& s_injection : pf_input_scaled.s_injection) {
+            s_injection *= 1.01;
+        }
+        MathSolver<symmetric_t> ref_solver{topo_ptr};
+        CalculationInfo ref_info;
+        SolverOutput<symmetric_t> const output_scaled_ref =
+            ref_solver.run_power_flow(pf_input_scaled, 1e-12, 20, ref_info, newton_raphson, y_bus_sym);
+        CalculationInfo scaled_info;
+        output = solver.run_power_flow(pf_input_scaled, 1e-12, 20, scaled_info, newton_raphson, y_bus_sym);
+        assert_output(output, output_scaled_ref);
+        CHECK(scaled_info[factorization_key] < info[factorization_key]);
+
+        // no reuse without the setting
+        CHECK(ref_info.find(factorization_key) == ref_info.end());
+
+        math_solver::NewtonRaphsonPFSolver<asymmetric_t> solver_asym{y_bus_asym, topo_ptr, {.enabled = true}};
+        CalculationInfo asym_info;
+        assert_output(solver_asym.run_power_flow(y_bus_asym, pf_input_asym, 1e-12, 20, asym_info), output_ref_asym);
+        CHECK(asym_info[factorization_key] >= 1.0);
+    }
+
+    SUBCASE("Test pf sensitivity") {
+        // central difference of the power flow to the injection of the const pq load at bus 1
+        constexpr double delta = 1e-4;
+        constexpr double tolerance = 1e-6;
+        std::array<Idx, 1> const injection_buses{1};
+        std::array<Idx, 3> const buses{0, 1, 2};
+        std::array<Idx, 2> const branches{0, 1};
+
+        MathSolver<symmetric_t> solver{topo_ptr};
+        CalculationInfo info;
+        CHECK_THROWS_AS(solver.calculate_power_flow_sensitivity(injection_buses, buses, branches, info, y_bus_sym),
+                        CalculationError);
+
+        auto const run = [&](DoubleComplex const& ds) {
+            PowerFlowInput<symmetric_t> pf_input_changed = pf_input;
+            pf_input_changed.s_injection[3] += ds;
+            return solver.run_power_flow(pf_input_changed, 1e-12, 20, info, newton_raphson, y_bus_sym);
+        };
+        for (DoubleComplex const ds : {DoubleComplex{delta}, DoubleComplex{0.0, delta}}) {
+            bool const reactive = imag(ds) != 0.0;
+            SolverOutput<symmetric_t> const output_minus = run(-ds);
+            SolverOutput<symmetric_t> const output_plus = run(ds);
+            solver.run_power_flow(pf_input, 1e-12, 20, info, newton_raphson, y_bus_sym);
+            auto const sensitivity =
+                solver.calculate_power_flow_sensitivity(injection_buses, buses, branches, info, y_bus_sym);
+            REQUIRE(sensitivity.voltage.size() == buses.size());
+            REQUIRE(sensitivity.branch.size() == branches.size());
+
+            for (size_t bus = 0; bus != buses.size(); ++bus) {
+                auto const& entry = sensitivity.voltage[bus];
+                double const dv = (cabs(output_plus.u[bus]) - cabs(output_minus.u[bus])) / (2.0 * delta);
+                double const dtheta = (arg(output_plus.u[bus]) - arg(output_minus.u[bus])) / (2.0 * delta);
+                check_close(reactive ? entry.dv_dq : entry.dv_dp, dv, tolerance);
+                check_close(reactive ? entry.dtheta_dq : entry.dtheta_dp, dtheta, tolerance);
+            }
+            for (size_t branch = 0; branch != branches.size(); ++branch) {
+                auto const& entry = sensitivity.branch[branch];
+                DoubleComplex const ds_f =
+                    (output_plus.branch[branch].s_f - output_minus.branch[branch].s_f) / (2.0 * delta);
+                check_close(reactive ? entry.dp_dq : entry.dp_dp, real(ds_f), tolerance);
+                check_close(reactive ? entry.dq_dq : entry.dq_dp, imag(ds_f), tolerance);
+            }
+        }
+
+        // the factorization of another admittance is not available
+        YBus<symmetric_t> const y_bus_other{topo_ptr, param_ptr};
+        CHECK_THROWS_AS(solver.calculate_power_flow_sensitivity(injection_buses, buses, branches, info, y_bus_other),
+                        CalculationError);
+        MathSolver<asymmetric_t> solver_asym{topo_ptr};
+        CHECK_THROWS_AS(
+            solver_asym.calculate_power_flow_sensitivity(injection_buses, buses, branches, info, y_bus_decoupled),
+            CalculationError);
+
+        // injection in phase a
+        auto const run_asym = [&](double dp) {
+            PowerFlowInput<asymmetric_t> pf_input_changed = pf_input_asym;
+            pf_input_changed.s_injection[3](0) += dp;
+            return solver_asym.run_power_flow(pf_input_changed, 1e-12, 20, info, newton_raphson, y_bus_asym);
+        };
+        SolverOutput<asymmetric_t> const output_minus = run_asym(-delta);
+        SolverOutput<asymmetric_t> const output_plus = run_asym(delta);
+        solver_asym.run_power_flow(pf_input_asym, 1e-12, 20, info, newton_raphson, y_bus_asym);
+        auto const sensitivity =
+            solver_asym.calculate_power_flow_sensitivity(injection_buses, buses, branches, info, y_bus_asym);
+        for (size_t bus = 0; bus != buses.size(); ++bus) {
+            RealValue<asymmetric_t> const dv = (cabs(output_plus.u[bus]) - cabs(output_minus.u[bus])) / (2.0 * delta);
+            check_close<asymmetric_t>(RealValue<asymmetric_t>{sensitivity.voltage[bus].dv_dp.col(0)}, dv, tolerance);
+        }
+        for (size_t branch = 0; branch != branches.size(); ++branch) {
+            RealValue<asymmetric_t> const dp_f =
+                real(output_plus.branch[branch].s_f - output_minus.branch[branch].s_f) / (2.0 * delta);
+            check_close<asymmetric_t>(RealValue<asymmetric_t>{sensitivity.branch[branch].dp_dp.col(0)}, dp_f,
+                                      tolerance);
+        }
+    }
+
     SUBCASE("Test symmetric linear current pf solver") {
         // low precision
         constexpr auto error_tolerance{5e-3};
@@ -465,6 +712,56 @@ TEST_CASE("Test math solver") {
         assert_output(output, output_ref, false, result_tolerance);
     }
 
+    SUBCASE("Test dc pf solver") {
+        auto const approximate_key = Timer::make_key(2234, "Approximate result (DC power flow)");
+        MathSolver<symmetric_t> solver{topo_ptr};
+        CalculationInfo info;
+        SolverOutput<symmetric_t> const output = solver.run_power_flow(pf_input, 1e-12, 20, info, dc, y_bus_sym);
+        CHECK(info[approximate_key] == 1.0);
+
+        // flat voltage magnitude
+        // the result is not close to the exact solution, the shunt consumes active power in the exact solution
+        for (size_t bus = 0; bus != output.u.size(); ++bus) {
+            CHECK(cabs(output.u[bus]) == doctest::Approx(vref));
+        }
+
+        // lossless active power flow, without reactive power
+        double total_load_gen = 0.0;
+        for (auto const& load_gen : output.load_gen) {
+            CHECK(imag(load_gen.s) == 0.0);
+            total_load_gen += real(load_gen.s);
+        }
+        CHECK(imag(output.source[0].s) == 0.0);
+        CHECK(real(output.source[0].s) == doctest::Approx(-total_load_gen));
+        CHECK(imag(output.branch[0].s_f) == 0.0);
+        CHECK(real(output.branch[0].s_f) == doctest::Approx(real(output.bus_injection[0])));
+        CHECK(real(output.branch[0].s_t) == doctest::Approx(-real(output.branch[0].s_f)));
+        CHECK(real(output.branch[1].s_f) == doctest::Approx(0.0));
+        CHECK(output.shunt[0].s == 0.0);
+
+        // radial network: an injection flows to the source over the branches in between
+        std::array<Idx, 2> const branches{0, 1};
+        std::array<Idx, 3> const buses{0, 1, 2};
+        std::array<double, 6> const ptdf_ref{0.0, -1.0, -1.0, 0.0, 0.0, -1.0};
+        auto const ptdf = solver.calculate_dc_ptdf(branches, buses, info, y_bus_sym);
+        REQUIRE(ptdf.size() == ptdf_ref.size());
+        for (size_t i = 0; i != ptdf.size(); ++i) {
+            CHECK(ptdf[i] == doctest::Approx(ptdf_ref[i]));
+        }
+
+        // the flows are linear in the injections
+        PowerFlowInput<symmetric_t> pf_input_changed = pf_input;
+        pf_input_changed.s_injection[3] += 0.1;
+        SolverOutput<symmetric_t> const output_changed =
+            solver.run_power_flow(pf_input_changed, 1e-12, 20, info, dc, y_bus_sym);
+        CHECK(real(output_changed.branch[0].s_f - output.branch[0].s_f) == doctest::Approx(ptdf[1] * 0.1));
+
+        // no linear method for all const z
+        CalculationInfo z_info;
+        solver.run_power_flow(pf_input_z, 1e-12, 20, z_info, dc, y_bus_sym);
+        CHECK(z_info[approximate_key] == 1.0);
+    }
+
     SUBCASE("Test wrong calculation type") {
         MathSolver<symmetric_t> solver{topo_ptr};
         CalculationInfo info;
@@ -483,6 +780,78 @@ TEST_CASE("Test math solver") {
         assert_output(output, output_ref_z);
     }
 
+    SUBCASE("Test const z pf solver with changing input") {
+        MathSolver<symmetric_t> solver{topo_ptr};
+        CalculationInfo info;
+        SolverOutput<symmetric_t> output = solver.run_power_flow(pf_input_z, 1e-12, 20, info, linear, y_bus_sym);
+        assert_output(output, output_ref_z);
+
+        // same matrix, different source voltage: the voltages scale linearly
+        PowerFlowInput<symmetric_t> pf_input_scaled = pf_input_z;
+        for (auto& u_ref : pf_input_scaled.source) {
+            u_ref *= 1.05;
+        }
+        output = solver.run_power_flow(pf_input_scaled, 1e-12, 20, info, linear, y_bus_sym);
+        for (size_t i = 0; i != output.u.size(); ++i) {
+            check_close(output.u[i], output_ref_z.u[i] * 1.05);
+        }
+
+        // different matrix
+        PowerFlowInput<symmetric_t> pf_input_changed = pf_input_z;
+        pf_input_changed.s_injection[2] *= 2.0;
+        MathSolver<symmetric_t> new_solver{topo_ptr};
+        SolverOutput<symmetric_t> const output_changed_ref =
+            new_solver.run_power_flow(pf_input_changed, 1e-12, 20, info, linear, y_bus_sym);
+        output = solver.run_power_flow(pf_input_changed, 1e-12, 20, info, linear, y_bus_sym);
+        assert_output(output, output_changed_ref);
+
+        // back to the original input
+        output = solver.run_power_flow(pf_input_z, 1e-12, 20, info, linear, y_bus_sym);
+        assert_output(output, output_ref_z);
+    }
+
+    SUBCASE("Test const z pf solver with Krylov solver") {
+        // all math models use the Krylov solver
+        math_solver::SparseKrylovSettings const krylov_settings{.min_size = 0};
+        auto const iter_key = Timer::make_key(2230, "Max number of linear solver iterations");
+        auto const memory_key = Timer::make_key(2231, "Max linear solver memory (bytes)");
+
+        MathSolver<symmetric_t> solver{topo_ptr};
+        solver.set_krylov_settings(krylov_settings);
+        CalculationInfo info;
+        SolverOutput<symmetric_t> output = solver.run_power_flow(pf_input_z, 1e-12, 20, info, linear, y_bus_sym);
+        assert_output(output, output_ref_z);
+        CHECK(info[iter_key] >= 1.0);
+        CHECK(info[memory_key] > 0.0);
+
+        // re-use of the preconditioner with a different source voltage
+        PowerFlowInput<symmetric_t> pf_input_scaled = pf_input_z;
+        for (auto& u_ref : pf_input_scaled.source) {
+            u_ref *= 1.05;
+        }
+        output = solver.run_power_flow(pf_input_scaled, 1e-12, 20, info, linear, y_bus_sym);
+        for (size_t i = 0; i != output.u.size(); ++i) {
+            check_close(output.u[i], output_ref_z.u[i] * 1.05);
+        }
+
+        math_solver::LinearPFSolver<asymmetric_t> solver_asym{y_bus_asym, topo_ptr, krylov_settings};
+        CHECK(solver_asym.use_krylov());
+        assert_output(solver_asym.run_power_flow(y_bus_asym, pf_input_asym_z, info), output_ref_asym_z);
+
+        // the LU factorization is used below the threshold
+        math_solver::LinearPFSolver<asymmetric_t> const solver_lu{y_bus_asym, topo_ptr};
+        CHECK(!solver_lu.use_krylov());
+
+        // the Krylov solver does not need the symbolic LU factorization of the y bus
+        auto const lu_symbolic_cache = std::make_shared<math_solver::SparseLUSymbolicCache>();
+        YBus<symmetric_t> const y_bus_krylov{
+            topo_ptr, std::make_shared<MathModelParam<symmetric_t> const>(param),
+            std::make_shared<math_solver::YBusStructure const>(*topo_ptr, lu_symbolic_cache)};
+        math_solver::LinearPFSolver<symmetric_t> solver_krylov{y_bus_krylov, topo_ptr, krylov_settings};
+        assert_output(solver_krylov.run_power_flow(y_bus_krylov, pf_input_z, info), output_ref_z);
+        CHECK(lu_symbolic_cache->size() == 0);
+    }
+
     SUBCASE("Test not converge") {
         MathSolver<symmetric_t> solver{topo_ptr};
         CalculationInfo info;
@@ -491,7 +860,8 @@ TEST_CASE("Test math solver") {
     }
 
     SUBCASE("Test singular ybus") {
-        std::vector<CalculationMethod> const methods{linear, newton_raphson, linear_current, iterative_current};
+        std::vector<CalculationMethod> const methods{linear, newton_raphson, linear_current, iterative_current,
+                                                     fast_decoupled};
 
         param.branch_param[0] = BranchCalcParam<symmetric_t>{};
         param.branch_param[1] = BranchCalcParam<symmetric_t>{};
@@ -514,6 +884,14 @@ TEST_CASE("Test math solver") {
         assert_output(output, output_ref_asym);
     }
 
+    SUBCASE("Test interleaved complex layout pf solver") {
+        CalculationInfo info;
+        math_solver::NewtonRaphsonPFSolver<symmetric_t, interleaved_complex_t> solver_sym{y_bus_sym, topo_ptr};
+        assert_output(solver_sym.run_power_flow(y_bus_sym, pf_input, 1e-12, 20, info), output_ref);
+        math_solver::NewtonRaphsonPFSolver<asymmetric_t, interleaved_complex_t> solver_asym{y_bus_asym, topo_ptr};
+        assert_output(solver_asym.run_power_flow(y_bus_asym, pf_input_asym, 1e-12, 20, info), output_ref_asym);
+    }
+
     SUBCASE("Test iterative current asymmetric pf solver") {
         MathSolver<asymmetric_t> solver{topo_ptr};
         CalculationInfo info;
@@ -522,6 +900,50 @@ TEST_CASE("Test math solver") {
         assert_output(output, output_ref_asym);
     }
 
+    SUBCASE("Test fast decoupled asymmetric pf solver") {
+        auto const fallback_key = Timer::make_key(2232, "Number of fallbacks to Newton-Raphson");
+        MathSolver<asymmetric_t> solver{topo_ptr};
+        CalculationInfo info;
+
+        // the zero sequence admittance of the network is capacitive, the decoupled iteration does not converge
+        SolverOutput<asymmetric_t> output =
+            solver.run_power_flow(pf_input_asym, 1e-12, 100, info, fast_decoupled, y_bus_asym);
+        assert_output(output, output_ref_asym);
+        CHECK(info[fallback_key] == 1.0);
+
+        // the same network without coupling between the phases
+        info.clear();
+        output = solver.run_power_flow(pf_input_asym, 1e-12, 100, info, fast_decoupled, y_bus_decoupled);
+        assert_output(output, output_ref_asym);
+        CHECK(!info.contains(fallback_key));
+    }
+
+    SUBCASE("Test dc asymmetric pf solver") {
+        MathSolver<symmetric_t> solver{topo_ptr};
+        MathSolver<asymmetric_t> solver_asym{topo_ptr};
+        CalculationInfo info;
+
+        // the same result in all phases for the network without coupling between the phases
+        SolverOutput<symmetric_t> const output = solver.run_power_flow(pf_input, 1e-12, 20, info, dc, y_bus_sym);
+        SolverOutput<asymmetric_t> const output_asym =
+            solver_asym.run_power_flow(pf_input_asym, 1e-12, 20, info, dc, y_bus_decoupled);
+        for (size_t bus = 0; bus != output.u.size(); ++bus) {
+            check_close<asymmetric_t>(output_asym.u[bus], ComplexValue<asymmetric_t>{output.u[bus]});
+        }
+        for (size_t branch = 0; branch != output.branch.size(); ++branch) {
+            check_close<asymmetric_t>(output_asym.branch[branch].s_f,
+                                      output.branch[branch].s_f * RealValue<asymmetric_t>{1.0});
+            check_close<asymmetric_t>(output_asym.branch[branch].i_f,
+                                      ComplexValue<asymmetric_t>{output.branch[branch].i_f});
+        }
+        check_close<asymmetric_t>(output_asym.source[0].s, output.source[0].s * RealValue<asymmetric_t>{1.0});
+
+        std::array<Idx, 1> const branches{0};
+        std::array<Idx, 1> const buses{1};
+        auto const ptdf = solver_asym.calculate_dc_ptdf(branches, buses, info, y_bus_decoupled);
+        check_close<asymmetric_t>(ptdf[0], RealTensor<asymmetric_t>{-1.0});
+    }
+
     SUBCASE("Test asym const z pf solver") {
         MathSolver<asymmetric_t> solver{topo_ptr};
         CalculationInfo info;
@@ -658,6 +1080,26 @@ TEST_CASE("Test math solver") {
 
         assert_output(output, output_ref_asym);
     }
+
+    SUBCASE("Test sym se with mixed precision gain matrix") {
+        MathSolver<symmetric_t> solver{topo_ptr};
+        solver.set_se_mixed_precision(true);
+        CalculationInfo info;
+        SolverOutput<symmetric_t> const output =
+            solver.run_state_estimation(se_input_angle, 1e-10, 20, info, iterative_linear, y_bus_sym);
+        assert_output(output, output_ref);
+        CHECK(!info.contains(Timer::make_key(2236, "Number of fallbacks to double precision")));
+    }
+
+    SUBCASE("Test asym se with mixed precision gain matrix") {
+        MathSolver<asymmetric_t> solver{topo_ptr};
+        solver.set_se_mixed_precision(true);
+        CalculationInfo info;
+        SolverOutput<asymmetric_t> const output =
+            solver.run_state_estimation(se_input_asym_angle, 1e-10, 20, info, iterative_linear, y_bus_asym);
+        assert_output(output, output_ref_asym);
+        CHECK(!info.contains(Timer::make_key(2236, "Number of fallbacks to double precision")));
+    }
 }
 
 namespace {
@@ -750,6 +1192,145 @@ ShortCircuitSolverOutput<sym> create_sc_test_output(FaultType fault_type, Double
 
 } // namespace
 
+TEST_CASE("Math solver, line outage distribution factors") {
+    /*
+    network, loop of branch 0, 1, 2, lossless branch 3 to the load at bus 3
+
+    source --yref-- bus0 --branch0-- bus1 (load0)
+                     |                |
+                     ---branch2--- bus2 --branch3-- bus3 (load1)
+    */
+    MathModelTopology topo;
+    topo.slack_bus = 0;
+    topo.phase_shift = {0.0, 0.0, 0.0, 0.0};
+    topo.branch_bus_idx = {{0, 1}, {1, 2}, {0, 2}, {2, 3}};
+    topo.sources_per_bus = {from_sparse, {0, 1, 1, 1, 1}};
+    topo.shunts_per_bus = {from_sparse, {0, 0, 0, 0, 0}};
+    topo.load_gens_per_bus = {from_sparse, {0, 0, 1, 1, 2}};
+    topo.load_gen_type = {LoadGenType::const_pq, LoadGenType::const_pq};
+    topo.voltage_sensors_per_bus = {from_sparse, {0, 0, 0, 0, 0}};
+    topo.power_sensors_per_bus = {from_sparse, {0, 0, 0, 0, 0}};
+    topo.power_sensors_per_source = {from_sparse, {0, 0}};
+    topo.power_sensors_per_load_gen = {from_sparse, {0, 0, 0}};
+    topo.power_sensors_per_shunt = {from_sparse, {0}};
+    topo.power_sensors_per_branch_from = {from_sparse, {0, 0, 0, 0, 0}};
+    topo.power_sensors_per_branch_to = {from_sparse, {0, 0, 0, 0, 0}};
+    auto topo_ptr = std::make_shared<MathModelTopology const>(topo);
+
+    DoubleComplex const y = 2.0 - 20.0i;
+    DoubleComplex const y_lossless = -10.0i;
+    DoubleComplex const yref = 10.0 - 50.0i;
+    MathModelParam<symmetric_t> param;
+    param.branch_param = {
+        {y, -y, -y, y}, {y, -y, -y, y}, {y, -y, -y, y}, {y_lossless, -y_lossless, -y_lossless, y_lossless}};
+    param.source_param = {SourceCalcParam{yref, yref}};
+    YBus<symmetric_t> y_bus{topo_ptr, std::make_shared<MathModelParam<symmetric_t> const>(param)};
+
+    PowerFlowInput<symmetric_t> pf_input;
+    pf_input.source = {1.0};
+    pf_input.s_injection = {-0.2 - 0.05i, -0.1 - 0.02i};
+
+    MathSolver<symmetric_t> solver{topo_ptr};
+    CalculationInfo info;
+    SolverOutput<symmetric_t> const output = solver.run_power_flow(pf_input, 1e-12, 20, info, newton_raphson, y_bus);
+
+    std::array<Idx, 4> const branches{0, 1, 2, 3};
+    std::array<Idx, 2> const outage_branches{2, 3};
+    auto const lodf = solver.calculate_lodf(branches, outage_branches, info, y_bus);
+    REQUIRE(lodf.size() == branches.size() * outage_branches.size());
+
+    // the outage branch itself
+    CHECK(lodf[2 * 2 + 0] == doctest::Approx(-1.0));
+    CHECK(lodf[3 * 2 + 1] == doctest::Approx(-1.0));
+    // the lossless radial branch is a bridge
+    CHECK(std::isnan(lodf[0 * 2 + 1]));
+
+    // the flow of branch 2 is distributed over the other path, compared with the outage in the power flow
+    // the factors are linearized, the change in losses gives a small difference
+    param.branch_param[2] = BranchCalcParam<symmetric_t>{};
+    y_bus.update_admittance(std::make_shared<MathModelParam<symmetric_t> const>(param));
+    MathSolver<symmetric_t> outage_solver{topo_ptr};
+    SolverOutput<symmetric_t> const output_outage =
+        outage_solver.run_power_flow(pf_input, 1e-12, 20, info, newton_raphson, y_bus);
+    double const flow_outage = real(output.branch[2].s_f);
+    for (Idx const branch : {0, 1, 3}) {
+        double const flow_change = real(output_outage.branch[branch].s_f - output.branch[branch].s_f);
+        check_close(flow_change, lodf[branch * 2 + 0] * flow_outage, 1e-3);
+    }
+    CHECK(lodf[3 * 2 + 0] == doctest::Approx(0.0));
+}
+
+TEST_CASE("Math solver, low-rank update of the factorization") {
+    /*
+    complete graph of 8 buses, source at bus 0, a load at all other buses
+
+    the LU factorization is dense, a change of the first rows refactorizes the whole matrix
+    */
+    Idx const n_bus = 8;
+    MathModelTopology topo;
+    topo.slack_bus = 0;
+    topo.phase_shift.assign(n_bus, 0.0);
+    for (Idx bus_from = 0; bus_from != n_bus; ++bus_from) {
+        for (Idx bus_to = bus_from + 1; bus_to != n_bus; ++bus_to) {
+            topo.branch_bus_idx.push_back({bus_from, bus_to});
+        }
+    }
+    auto const n_branch = static_cast<Idx>(topo.branch_bus_idx.size());
+    IdxVector source_indptr(n_bus + 1, 1);
+    source_indptr[0] = 0;
+    IdxVector load_gen_indptr{0, 0};
+    for (Idx bus = 1; bus != n_bus; ++bus) {
+        load_gen_indptr.push_back(bus);
+    }
+    topo.sources_per_bus = {from_sparse, source_indptr};
+    topo.shunts_per_bus = {from_sparse, IdxVector(n_bus + 1, 0)};
+    topo.load_gens_per_bus = {from_sparse, load_gen_indptr};
+    topo.load_gen_type.assign(n_bus - 1, LoadGenType::const_pq);
+    auto const topo_ptr = std::make_shared<MathModelTopology const>(topo);
+
+    DoubleComplex const y = 2.0 - 20.0i;
+    DoubleComplex const yref = 10.0 - 50.0i;
+    MathModelParam<symmetric_t> param;
+    param.branch_param.assign(n_branch, BranchCalcParam<symmetric_t>{y, -y, -y, y});
+    param.source_param = {SourceCalcParam{yref, yref}};
+    // outage of branch 0 between bus 0 and 1
+    MathModelParam<symmetric_t> param_outage = param;
+    param_outage.branch_param[0] = BranchCalcParam<symmetric_t>{};
+
+    PowerFlowInput<symmetric_t> pf_input;
+    pf_input.source = {1.0};
+    pf_input.s_injection.assign(n_bus - 1, -0.1 - 0.02i);
+
+    auto const low_rank_key = Timer::make_key(2235, "Number of low-rank updates");
+    auto const refactorization_key = Timer::make_key(2229, "Number of partial refactorizations");
+
+    for (auto const method : {CalculationMethod::linear, CalculationMethod::iterative_current}) {
+        CAPTURE(method);
+        YBus<symmetric_t> y_bus{topo_ptr, std::make_shared<MathModelParam<symmetric_t> const>(param)};
+        MathSolver<symmetric_t> solver{topo_ptr};
+        CalculationInfo info;
+        SolverOutput<symmetric_t> const output_ref = solver.run_power_flow(pf_input, 1e-12, 20, info, method, y_bus);
+        CHECK(info[low_rank_key] == 0.0);
+
+        // the outage is solved with a low-rank update of the factorization of the base case
+        y_bus.update_admittance(std::make_shared<MathModelParam<symmetric_t> const>(param_outage));
+        SolverOutput<symmetric_t> const output = solver.run_power_flow(pf_input, 1e-12, 20, info, method, y_bus);
+        CHECK(info[low_rank_key] == 1.0);
+        CHECK(info[refactorization_key] == 0.0);
+
+        // same result as a new solver with a full factorization
+        MathSolver<symmetric_t> outage_solver{topo_ptr};
+        CalculationInfo outage_info;
+        assert_output(output, outage_solver.run_power_flow(pf_input, 1e-12, 20, outage_info, method, y_bus));
+
+        // the base case uses the kept factorization without any update
+        y_bus.update_admittance(std::make_shared<MathModelParam<symmetric_t> const>(param));
+        assert_output(solver.run_power_flow(pf_input, 1e-12, 20, info, method, y_bus), output_ref);
+        CHECK(info[low_rank_key] == 1.0);
+        CHECK(info[refactorization_key] == 0.0);
+    }
+}
+
 TEST_CASE("Short circuit solver") {
     // Test case grid
     // source -- bus --- line -- bus -- fault(type varying as per subcase)
@@ -0,0 +1,104 @@
+// SPDX-FileCopyrightText: Contributors to the Power Grid Model project <powergridmodel@lfenergy.org>
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#include <power_grid_model/batch_planner.hpp>
+
+#include <doctest/doctest.h>
+
+namespace power_grid_model {
+namespace {
+template <typename T> std::vector<std::span<T const>> split_scenarios(std::vector<T> const& data, Idx n_per_scenario) {
+    std::vector<std::span<T const>> result;
+    for (Idx begin = 0; begin < static_cast<Idx>(data.size()); begin += n_per_scenario) {
+        result.emplace_back(data.data() + begin, n_per_scenario);
+    }
+    return result;
+}
+} // namespace
+
+TEST_CASE("Test batch planner") {
+    // 6 scenarios, one load update and one line update each
+    std::vector<SymLoadGenUpdate> const load_updates{
+        {.id = 10, .status = na_IntS, .p_specified = 1.0, .q_specified = nan},
+        {.id = 10, .status = 0, .p_specified = 2.0, .q_specified = nan},
+        {.id = 10, .status = na_IntS, .p_specified = 3.0, .q_specified = nan},
+        {.id = 10, .status = na_IntS, .p_specified = 4.0, .q_specified = nan},
+        {.id = 10, .status = na_IntS, .p_specified = 5.0, .q_specified = nan},
+        {.id = 10, .status = na_IntS, .p_specified = 6.0, .q_specified = nan},
+    };
+    std::vector<BranchUpdate> const line_updates{
+        {.id = 1, .from_status = 0, .to_status = na_IntS}, {.id = 1, .from_status = na_IntS, .to_status = na_IntS},
+        {.id = 1, .from_status = 0, .to_status = na_IntS}, {.id = 1, .from_status = na_IntS, .to_status = na_IntS},
+        {.id = 1, .from_status = 0, .to_status = na_IntS}, {.id = 1, .from_status = na_IntS, .to_status = 0},
+    };
+
+    SUBCASE("Empty batch") {
+        BatchPlanner const planner{0};
+        BatchPlan const plan = planner.plan();
+        CHECK(plan.is_independent);
+        CHECK(plan.execution_order.empty());
+    }
+
+    SUBCASE("Independent batch, group by topology") {
+        BatchPlanner planner{6};
+        planner.add_component<SymLoad>(split_scenarios(load_updates, 1));
+        planner.add_component<Line>(split_scenarios(line_updates, 1));
+        BatchPlan const plan = planner.plan();
+
+        CHECK(plan.is_independent);
+        // appliance status does not change the topology
+        auto const& signature = planner.topology_signature();
+        CHECK(signature[1] == 0);
+        CHECK(signature[3] == 0);
+        CHECK(signature[0] != 0);
+        CHECK(signature[0] == signature[2]);
+        CHECK(signature[0] == signature[4]);
+        CHECK(signature[5] != 0);
+        CHECK(signature[5] != signature[0]);
+
+        // base topology first, then the groups, stable within each group
+        REQUIRE(plan.execution_order.size() == 6);
+        CHECK(plan.execution_order[0] == 1);
+        CHECK(plan.execution_order[1] == 3);
+        IdxVector const rest{plan.execution_order.begin() + 2, plan.execution_order.end()};
+        bool const group_first = rest == IdxVector{0, 2, 4, 5};
+        bool const group_last = rest == IdxVector{5, 0, 2, 4};
+        CHECK((group_first || group_last));
+    }
+
+    SUBCASE("Dependent batch") {
+        std::vector<BranchUpdate> dependent_line_updates = line_updates;
+        dependent_line_updates[3].id = 2;
+        BatchPlanner planner{6};
+        planner.add_component<SymLoad>(split_scenarios(load_updates, 1));
+        planner.add_component<Line>(split_scenarios(dependent_line_updates, 1));
+        CHECK_FALSE(planner.plan().is_independent);
+        // different line, different topology
+        CHECK(planner.topology_signature()[2] != planner.topology_signature()[3]);
+    }
+
+    SUBCASE("Independence only") {
+        BatchPlanner planner{6, false};
+        planner.add_component<SymLoad>(split_scenarios(load_updates, 1));
+        planner.add_component<Line>(split_scenarios(line_updates, 1));
+        CHECK(planner.is_independent());
+        // no topology signatures
+        CHECK(planner.topology_signature().empty());
+
+        std::vector<BranchUpdate> dependent_line_updates = line_updates;
+        dependent_line_updates[3].id = 2;
+        BatchPlanner dependent_planner{6, false};
+        dependent_planner.add_component<Line>(split_scenarios(dependent_line_updates, 1));
+        CHECK_FALSE(dependent_planner.is_independent());
+    }
+
+    SUBCASE("Different number of elements per scenario") {
+        BatchPlanner planner{2};
+        planner.add_component<SymLoad>(std::vector<std::span<SymLoadGenUpdate const>>{
+            {load_updates.data(), 1}, {load_updates.data() + 1, 2}});
+        CHECK_FALSE(planner.is_independent());
+    }
+}
+
+} // namespace power_grid_model
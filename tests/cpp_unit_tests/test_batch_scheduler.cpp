@@ -0,0 +1,82 @@
+// SPDX-FileCopyrightText: Contributors to the Power Grid Model project <powergridmodel@lfenergy.org>
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#include <power_grid_model/batch_scheduler.hpp>
+
+#include <doctest/doctest.h>
+
+#include <thread>
+
+namespace power_grid_model {
+
+TEST_CASE("Test batch scheduler") {
+    SUBCASE("Empty batch") {
+        BatchScheduler scheduler{0, 4};
+        CHECK(scheduler.next().empty());
+    }
+
+    SUBCASE("Single worker gets all scenarios in order") {
+        constexpr Idx n_scenarios = 37;
+        BatchScheduler scheduler{n_scenarios, 1};
+        Idx expected_begin = 0;
+        Idx previous_size = n_scenarios;
+        for (ScenarioRange range = scheduler.next(); !range.empty(); range = scheduler.next()) {
+            CHECK(range.begin == expected_begin);
+            CHECK(range.size() >= 1);
+            // chunk size never grows
+            CHECK(range.size() <= previous_size);
+            previous_size = range.size();
+            expected_begin = range.end;
+        }
+        CHECK(expected_begin == n_scenarios);
+        CHECK(scheduler.next().empty());
+    }
+
+    SUBCASE("Chunks shrink towards the end of the batch") {
+        BatchScheduler scheduler{1000, 4};
+        ScenarioRange const first = scheduler.next();
+        CHECK(first.begin == 0);
+        CHECK(first.size() == 125);
+        ScenarioRange last = first;
+        for (ScenarioRange range = scheduler.next(); !range.empty(); range = scheduler.next()) {
+            last = range;
+        }
+        CHECK(last.end == 1000);
+        CHECK(last.size() == 1);
+    }
+
+    SUBCASE("Minimum chunk size") {
+        BatchScheduler scheduler{10, 8, 3};
+        CHECK(scheduler.next().size() == 3);
+        CHECK(scheduler.next().size() == 3);
+        CHECK(scheduler.next().size() == 3);
+        ScenarioRange const tail = scheduler.next();
+        CHECK(tail.begin == 9);
+        CHECK(tail.end == 10);
+        CHECK(scheduler.next().empty());
+    }
+
+    SUBCASE("Parallel workers calculate each scenario exactly once") {
+        constexpr Idx n_scenarios = 10000;
+        constexpr Idx n_workers = 4;
+        BatchScheduler scheduler{n_scenarios, n_workers};
+        std::vector<Idx> count(n_scenarios, 0);
+        std::vector<std::thread> threads;
+        for (Idx worker = 0; worker != n_workers; ++worker) {
+            threads.emplace_back([&scheduler, &count] {
+                for (ScenarioRange range = scheduler.next(); !range.empty(); range = scheduler.next()) {
+                    for (Idx scenario = range.begin; scenario != range.end; ++scenario) {
+                        ++count[scenario];
+                    }
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        CHECK(std::ranges::all_of(count, [](Idx c) { return c == 1; }));
+    }
+}
+
+} // namespace power_grid_model
@@ -0,0 +1,68 @@
+// SPDX-FileCopyrightText: Contributors to the Power Grid Model project <powergridmodel@lfenergy.org>
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#include <power_grid_model/contingency.hpp>
+
+#include <doctest/doctest.h>
+
+namespace power_grid_model {
+TEST_CASE("Test contingency list") {
+    ContingencyList const contingencies{.indptr = {0, 1, 1, 3}, .outage_ids = {10, 11, 12}};
+    CHECK(contingencies.size() == 3);
+    CHECK(std::ranges::equal(contingencies.outages(0), std::vector<ID>{10}));
+    CHECK(contingencies.outages(1).empty());
+    CHECK(std::ranges::equal(contingencies.outages(2), std::vector<ID>{11, 12}));
+    CHECK(ContingencyList{}.size() == 0);
+}
+
+TEST_CASE("Test connectivity without branches") {
+    /*
+    source at bus 0, ring 0-1-2-0 and a radial branch 2-3
+    branch 4 is only connected at bus 3, the other side is open
+
+    0 --0-- 1
+    |       |
+    2       1
+    |       |
+    +-- 2 --+ --3-- 3 --4-- (open)
+    */
+    MathModelTopology topo;
+    topo.slack_bus = 0;
+    topo.phase_shift.resize(4, 0.0);
+    topo.branch_bus_idx = {{0, 1}, {1, 2}, {0, 2}, {2, 3}, {3, -1}};
+    topo.sources_per_bus = {from_dense, {0}, 4};
+
+    CHECK(is_connected_without_branches(topo, IdxVector{}));
+    // a single branch of the ring
+    CHECK(is_connected_without_branches(topo, IdxVector{0}));
+    CHECK(is_connected_without_branches(topo, IdxVector{2}));
+    // a branch which is only connected at one side
+    CHECK(is_connected_without_branches(topo, IdxVector{4}));
+    // the radial branch
+    CHECK_FALSE(is_connected_without_branches(topo, IdxVector{3}));
+    // two branches of the ring
+    CHECK_FALSE(is_connected_without_branches(topo, IdxVector{0, 1}));
+    CHECK(is_connected_without_branches(topo, IdxVector{0, 4}));
+
+    SUBCASE("Second source") {
+        topo.sources_per_bus = {from_dense, {0, 3}, 4};
+        CHECK(is_connected_without_branches(topo, IdxVector{3}));
+        CHECK(is_connected_without_branches(topo, IdxVector{1, 2}));
+        CHECK_FALSE(is_connected_without_branches(topo, IdxVector{0, 2, 3}));
+    }
+}
+
+TEST_CASE("Test branch power sensors") {
+    MathModelTopology topo;
+    topo.branch_bus_idx = {{0, 1}, {1, 2}, {0, 2}};
+    // one sensor at the from side of branch 0, one at the to side of branch 2
+    topo.power_sensors_per_branch_from = {from_dense, {0}, 3};
+    topo.power_sensors_per_branch_to = {from_dense, {2}, 3};
+
+    CHECK_FALSE(has_branch_power_sensors(topo, IdxVector{}));
+    CHECK_FALSE(has_branch_power_sensors(topo, IdxVector{1}));
+    CHECK(has_branch_power_sensors(topo, IdxVector{0}));
+    CHECK(has_branch_power_sensors(topo, IdxVector{1, 2}));
+}
+} // namespace power_grid_model
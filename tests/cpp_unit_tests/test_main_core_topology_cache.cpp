@@ -0,0 +1,71 @@
+// SPDX-FileCopyrightText: Contributors to the Power Grid Model project <powergridmodel@lfenergy.org>
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#include <power_grid_model/main_core/topology_cache.hpp>
+
+#include <doctest/doctest.h>
+
+namespace power_grid_model::main_core {
+namespace {
+ComponentConnections make_connections(IntS from_status) {
+    return ComponentConnections{.branch_connected = {{from_status, 1}, {1, 1}},
+                                .branch3_connected = {{1, 1, 0}},
+                                .branch_phase_shift = {0.0, 1.0},
+                                .branch3_phase_shift = {{0.0, 0.0, 0.0}},
+                                .source_connected = {1}};
+}
+
+std::shared_ptr<CachedTopology const> make_topology(Idx n_math_models) {
+    return std::make_shared<CachedTopology const>(
+        CachedTopology{.math_topology = std::vector<std::shared_ptr<MathModelTopology const>>(n_math_models),
+                       .topo_comp_coup = {},
+                       .y_bus_structure = {}});
+}
+} // namespace
+
+TEST_CASE("Test topology cache") {
+    SUBCASE("Hash of component connections") {
+        CHECK(hash_component_connections(make_connections(0)) == hash_component_connections(make_connections(0)));
+        CHECK(hash_component_connections(make_connections(0)) != hash_component_connections(make_connections(1)));
+        CHECK(make_connections(0) == make_connections(0));
+        CHECK_FALSE(make_connections(0) == make_connections(1));
+    }
+
+    SUBCASE("Find and insert") {
+        TopologyCache cache{};
+        CHECK(cache.find(make_connections(0)) == nullptr);
+
+        auto const topology = make_topology(1);
+        cache.insert(make_connections(0), topology);
+        CHECK(cache.size() == 1);
+        CHECK(cache.find(make_connections(0)) == topology);
+        CHECK(cache.find(make_connections(1)) == nullptr);
+
+        // replace existing entry
+        auto const replaced = make_topology(2);
+        cache.insert(make_connections(0), replaced);
+        CHECK(cache.size() == 1);
+        CHECK(cache.find(make_connections(0)) == replaced);
+
+        cache.clear();
+        CHECK(cache.size() == 0);
+        CHECK(cache.find(make_connections(0)) == nullptr);
+    }
+
+    SUBCASE("Evict least recently used") {
+        TopologyCache cache{2};
+        CHECK(cache.capacity() == 2);
+        cache.insert(make_connections(0), make_topology(1));
+        cache.insert(make_connections(1), make_topology(1));
+        // use the first one, so that the second one is the least recently used
+        CHECK(cache.find(make_connections(0)) != nullptr);
+        cache.insert(make_connections(2), make_topology(1));
+        CHECK(cache.size() == 2);
+        CHECK(cache.find(make_connections(0)) != nullptr);
+        CHECK(cache.find(make_connections(1)) == nullptr);
+        CHECK(cache.find(make_connections(2)) != nullptr);
+    }
+}
+
+} // namespace power_grid_model::main_core
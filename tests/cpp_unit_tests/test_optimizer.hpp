@@ -146,8 +146,8 @@ constexpr auto strategies = [] {
 
 constexpr auto calculation_methods = [] {
     using enum CalculationMethod;
-    return std::array{default_method,    linear,         linear_current, iterative_linear,
-                      iterative_current, newton_raphson, iec60909};
+    return std::array{default_method, linear,   linear_current, iterative_linear, iterative_current,
+                      newton_raphson, iec60909, fast_decoupled, dc};
 }();
 
 constexpr auto tap_sides = [] { return std::array{ControlSide::side_1, ControlSide::side_2, ControlSide::side_3}; }();
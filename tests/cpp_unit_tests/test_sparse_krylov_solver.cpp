@@ -0,0 +1,160 @@
+// SPDX-FileCopyrightText: Contributors to the Power Grid Model project <powergridmodel@lfenergy.org>
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#include <power_grid_model/common/three_phase_tensor.hpp>
+#include <power_grid_model/math_solver/sparse_krylov_solver.hpp>
+
+#include <doctest/doctest.h>
+
+namespace power_grid_model::math_solver {
+
+namespace {
+using Tensor = Eigen::Array<double, 2, 2, Eigen::ColMajor>;
+using Array = Eigen::Array<double, 2, 1, Eigen::ColMajor>;
+
+// 2D grid of n * n buses with the neighbours connected, without any fill-ins
+struct GridPattern {
+    std::shared_ptr<IdxVector const> row_indptr;
+    std::shared_ptr<IdxVector const> col_indices;
+    std::shared_ptr<IdxVector const> diag;
+};
+
+GridPattern grid_pattern(Idx n) {
+    IdxVector row_indptr{0};
+    IdxVector col_indices;
+    IdxVector diag;
+    for (Idx row = 0; row != n * n; ++row) {
+        Idx const i = row / n;
+        Idx const j = row % n;
+        for (Idx const col : {row - n, row - 1, row, row + 1, row + n}) {
+            bool const is_neighbour = (col == row - n && i > 0) || (col == row - 1 && j > 0) || col == row ||
+                                      (col == row + 1 && j < n - 1) || (col == row + n && i < n - 1);
+            if (!is_neighbour) {
+                continue;
+            }
+            if (col == row) {
+                diag.push_back(static_cast<Idx>(col_indices.size()));
+            }
+            col_indices.push_back(col);
+        }
+        row_indptr.push_back(static_cast<Idx>(col_indices.size()));
+    }
+    return {.row_indptr = std::make_shared<IdxVector const>(std::move(row_indptr)),
+            .col_indices = std::make_shared<IdxVector const>(std::move(col_indices)),
+            .diag = std::make_shared<IdxVector const>(std::move(diag))};
+}
+
+// b = A * x
+template <class T, class X>
+std::vector<X> multiply(GridPattern const& pattern, std::vector<T> const& data, std::vector<X> const& x) {
+    std::vector<X> result(x.size());
+    for (Idx row = 0; row != static_cast<Idx>(x.size()); ++row) {
+        result[row] = 0.0 * x[row];
+        for (Idx idx = (*pattern.row_indptr)[row]; idx != (*pattern.row_indptr)[row + 1]; ++idx) {
+            result[row] += dot(data[idx], x[(*pattern.col_indices)[idx]]);
+        }
+    }
+    return result;
+}
+} // namespace
+
+TEST_CASE("Test sparse Krylov solver") {
+    SUBCASE("Scalar(double) calculation with full pattern") {
+        // [4 1 5        3          21
+        //  3 7 0     * [-1]   =  [ 2 ]
+        //  2 0 6]       2          18
+        auto const row_indptr = std::make_shared<IdxVector const>(IdxVector{0, 3, 6, 9});
+        auto const col_indices = std::make_shared<IdxVector const>(IdxVector{0, 1, 2, 0, 1, 2, 0, 1, 2});
+        auto const diag = std::make_shared<IdxVector const>(IdxVector{0, 4, 8});
+        std::vector<double> const data = {4, 1, 5, 3, 7, 0, 2, 0, 6};
+        std::vector<double> x(3, 0.0);
+        SparseKrylovSolver<double, double, double> solver{row_indptr, col_indices, diag};
+        solver.prefactorize(data);
+
+        // the incomplete factorization of the full pattern is exact
+        CHECK(solver.solve_with_prefactorized_matrix(data, {21, 2, 18}, x) == 1);
+        CHECK(x[0] == doctest::Approx(3.0));
+        CHECK(x[1] == doctest::Approx(-1.0));
+        CHECK(x[2] == doctest::Approx(2.0));
+
+        // zero right hand side
+        CHECK(solver.solve_with_prefactorized_matrix(data, {0, 0, 0}, x) == 0);
+        CHECK(x == std::vector<double>{0.0, 0.0, 0.0});
+
+        // singular pivot
+        std::vector<double> singular_data = data;
+        singular_data[0] = 0.0;
+        CHECK_THROWS_AS(solver.prefactorize(singular_data), SparseMatrixError);
+    }
+
+    constexpr Idx n = 10;
+    auto const pattern = grid_pattern(n);
+    Idx const size = n * n;
+
+    SUBCASE("Scalar(complex) calculation with dropped fill-ins") {
+        // admittance matrix of a meshed grid with a small shunt at every bus
+        std::vector<DoubleComplex> data(pattern.col_indices->size());
+        for (Idx row = 0; row != size; ++row) {
+            for (Idx idx = (*pattern.row_indptr)[row]; idx != (*pattern.row_indptr)[row + 1]; ++idx) {
+                if (idx != (*pattern.diag)[row]) {
+                    data[idx] = -1.0 + 2.0i;
+                    data[(*pattern.diag)[row]] += 1.0 - 2.0i;
+                }
+            }
+            data[(*pattern.diag)[row]] += 0.1 - 0.05i;
+        }
+        ComplexValueVector<symmetric_t> x_ref(size);
+        for (Idx row = 0; row != size; ++row) {
+            x_ref[row] = DoubleComplex{1.0 + 0.01 * static_cast<double>(row), -0.1};
+        }
+        auto const rhs = multiply(pattern, data, x_ref);
+
+        SparseKrylovSolver<DoubleComplex, DoubleComplex, DoubleComplex> solver{pattern.row_indptr,
+                                                                               pattern.col_indices, pattern.diag};
+        solver.prefactorize(data);
+        // rhs and x are the same vector
+        ComplexValueVector<symmetric_t> x = rhs;
+        Idx const n_iter = solver.solve_with_prefactorized_matrix(data, x, x);
+        CHECK(n_iter > 1);
+        for (Idx row = 0; row != size; ++row) {
+            CHECK(cabs(x[row] - x_ref[row]) < 1e-8);
+        }
+        CHECK(solver.memory_usage() > 0);
+
+        SUBCASE("Not converged") {
+            SparseKrylovSolver<DoubleComplex, DoubleComplex, DoubleComplex> limited_solver{
+                pattern.row_indptr, pattern.col_indices, pattern.diag, {.tolerance = 1e-12, .max_iter = 1}};
+            limited_solver.prefactorize(data);
+            CHECK_THROWS_AS(limited_solver.solve_with_prefactorized_matrix(data, rhs, x), IterationDiverge);
+        }
+    }
+
+    SUBCASE("Block(double 2*2) calculation with dropped fill-ins") {
+        std::vector<Tensor> data(pattern.col_indices->size());
+        for (Idx row = 0; row != size; ++row) {
+            for (Idx idx = (*pattern.row_indptr)[row]; idx != (*pattern.row_indptr)[row + 1]; ++idx) {
+                if (idx != (*pattern.diag)[row]) {
+                    data[idx] = Tensor{{-1.0, -0.2}, {0.1, -1.0}};
+                    data[(*pattern.diag)[row]] += Tensor{{1.0, 0.2}, {-0.1, 1.0}};
+                }
+            }
+            data[(*pattern.diag)[row]] += Tensor{{0.1, 0.0}, {0.0, 0.1}};
+        }
+        std::vector<Array> x_ref(size);
+        for (Idx row = 0; row != size; ++row) {
+            x_ref[row] = Array{1.0, -0.01 * static_cast<double>(row)};
+        }
+        auto const rhs = multiply(pattern, data, x_ref);
+
+        SparseKrylovSolver<Tensor, Array, Array> solver{pattern.row_indptr, pattern.col_indices, pattern.diag};
+        solver.prefactorize(data);
+        std::vector<Array> x(size);
+        CHECK(solver.solve_with_prefactorized_matrix(data, rhs, x) > 1);
+        for (Idx row = 0; row != size; ++row) {
+            CHECK((cabs(x[row] - x_ref[row]) < 1e-8).all());
+        }
+    }
+}
+
+} // namespace power_grid_model::math_solver
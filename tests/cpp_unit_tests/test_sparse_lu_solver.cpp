@@ -3,10 +3,16 @@
 // SPDX-License-Identifier: MPL-2.0
 
 #include <power_grid_model/common/three_phase_tensor.hpp>
+#include <power_grid_model/math_solver/sparse_lu_low_rank_update.hpp>
+#include <power_grid_model/math_solver/sparse_lu_mixed_precision.hpp>
 #include <power_grid_model/math_solver/sparse_lu_solver.hpp>
+#include <power_grid_model/thread_pool.hpp>
 
 #include <doctest/doctest.h>
 
+#include <random>
+#include <set>
+
 namespace power_grid_model::math_solver {
 
 using lu_trait_double = math_solver::sparse_lu_entry_trait<double, double, double>;
@@ -125,6 +131,552 @@ TEST_CASE("Test Sparse LU solver") {
             solver.solve_with_prefactorized_matrix((std::vector<Tensor> const&)data, block_perm, rhs, x);
             check_result(x, x_ref);
         }
+
+        SUBCASE("Test pivot permutation") {
+            solver.prefactorize(data, block_perm);
+            // zero diagonal in the first pivot, the rows are swapped
+            CHECK(block_perm[0].permuted);
+            CHECK(block_perm[0].p[0] == 1);
+            CHECK(block_perm[0].p[1] == 0);
+            // large diagonal in the last pivot, no row swaps
+            CHECK(!block_perm[2].permuted);
+        }
+    }
+}
+
+TEST_CASE("Test Sparse LU solver - low rank update") {
+    // 3 * 3 matrix, with diagonal, two fill-ins
+    /// x x x
+    /// x x f
+    /// x f x
+
+    auto row_indptr = std::make_shared<IdxVector const>(IdxVector{0, 3, 6, 9});
+    auto col_indices = std::make_shared<IdxVector const>(IdxVector{0, 1, 2, 0, 1, 2, 0, 1, 2});
+    auto diag_lu = std::make_shared<IdxVector const>(IdxVector{0, 4, 8});
+
+    SUBCASE("Scalar(double) calculation") {
+        std::vector<double> data = {
+            4, 1, 5, // row 0
+            3, 7, 0, // row 1
+            2, 0, 6  // row 2
+        };
+        SparseLUSolver<double, double, double> solver{row_indptr, col_indices, diag_lu};
+        SparseLUSolver<double, double, double>::BlockPermArray block_perm{};
+        solver.prefactorize(data, block_perm);
+        std::vector<double> x(3, 0.0);
+
+        SUBCASE("Test rank 2 update") {
+            // [4 1   5        3          21
+            //  3 8   2     * [-1]   =  [ 5  ]
+            //  2 0.5 5]       2          15.5
+            SparseLULowRankUpdate<double, double, double> const update{
+                solver, data, block_perm, {1, 2}, {1.0, 2.0, 0.5, -1.0}};
+            CHECK(update.rank() == 2);
+            CHECK(!update.is_singular());
+            update.solve(solver, data, block_perm, {21, 5, 15.5}, x);
+            check_result(x, {3, -1, 2});
+
+            // the factorization is not changed
+            solver.solve_with_prefactorized_matrix(data, block_perm, {21, 2, 18}, x);
+            check_result(x, {3, -1, 2});
+        }
+
+        SUBCASE("Test singular update") {
+            // all entries become one
+            SparseLULowRankUpdate<double, double, double> const update{
+                solver, data, block_perm, {0, 1, 2}, {-3.0, 0.0, -4.0, -2.0, -6.0, 1.0, -1.0, 1.0, -5.0}};
+            CHECK(update.is_singular());
+            CHECK_THROWS_AS(update.solve(solver, data, block_perm, {1, 1, 1}, x), SparseMatrixError);
+        }
+    }
+
+    SUBCASE("Block(double 2*2) calculation") {
+        std::vector<Tensor> data = {
+            {{0, 1}, {100, 0}}, // 0, 0
+            {{1, 2}, {7, -1}},  // 0, 1
+            {{3, 4}, {5, 6}},   // 0, 2
+            {{1, 2}, {-3, 4}},  // 1, 0
+            {{0, 200}, {3, 1}}, // 1, 1
+            {{0, 0}, {0, 0}},   // 1, 2
+            {{5, 6}, {-7, 8}},  // 2, 0
+            {{0, 0}, {0, 0}},   // 2, 1
+            {{1, 0}, {0, 100}}, // 2, 2
+        };
+        SparseLUSolver<Tensor, Array, Array> solver{row_indptr, col_indices, diag_lu};
+        SparseLUSolver<Tensor, Array, Array>::BlockPermArray block_perm(3);
+        solver.prefactorize(data, block_perm);
+
+        // the block (2, 2) becomes [[2, 0], [0, 50]]
+        SparseLULowRankUpdate<Tensor, Array, Array> const update{
+            solver, data, block_perm, {2}, {Tensor{{1, 0}, {0, -50}}}};
+        CHECK(update.rank() == 2);
+        CHECK(!update.is_singular());
+        std::vector<Array> x(3, Array::Zero());
+        update.solve(solver, data, block_perm, {{38, 356}, {-389, 2}, {49, 311}}, x);
+        check_result(x, {{3, 4}, {-1, -2}, {5, 6}});
+    }
+}
+
+TEST_CASE("Test Sparse LU solver - mixed precision") {
+    // 3 * 3 matrix, with diagonal, two fill-ins
+    /// x x x
+    /// x x f
+    /// x f x
+    auto const symbolic =
+        std::make_shared<SparseLUSymbolic const>(IdxVector{0, 3, 6, 9}, IdxVector{0, 1, 2, 0, 1, 2, 0, 1, 2});
+
+    SUBCASE("Scalar(double) calculation") {
+        // entries which cannot be represented in single precision
+        std::vector<double> const data = {
+            4.1, 1.3, 5.7,  // row 0
+            3.3, 7.1, 0.0,  // row 1
+            2.9, 0.0, 6.3}; // row 2
+        std::vector<double> const rhs = {0.1, 0.2, 0.3};
+        std::vector<double> x_ref(3, 0.0);
+        std::vector<double> x(3, 0.0);
+        SparseLUSolver<double, double, double> solver_ref{symbolic};
+        SparseLUSolver<double, double, double>::BlockPermArray block_perm_ref{};
+        auto lu_data_ref = data;
+        solver_ref.prefactorize_and_solve(lu_data_ref, block_perm_ref, rhs, x_ref);
+
+        SparseLUMixedPrecisionSolver<double, double, double> solver{symbolic};
+
+        SUBCASE("Test refinement") {
+            solver.prefactorize_and_solve(data, rhs, x);
+            CHECK(!solver.is_double_precision());
+            CHECK(solver.n_refinement_steps() > 0);
+            for (Idx i = 0; i != 3; ++i) {
+                CHECK(x[i] == doctest::Approx(x_ref[i]).epsilon(1e-14));
+            }
+        }
+
+        SUBCASE("Test out of single precision range") {
+            auto large_data = data;
+            for (double& value : large_data) {
+                value *= 1e40;
+            }
+            solver.prefactorize_and_solve(large_data, rhs, x);
+            CHECK(solver.is_double_precision());
+            for (Idx i = 0; i != 3; ++i) {
+                CHECK(x[i] * 1e40 == doctest::Approx(x_ref[i]).epsilon(1e-14));
+            }
+        }
+
+        SUBCASE("Test singular in single precision") {
+            // row 1 is the same as row 0 in single precision
+            std::vector<double> const near_singular_data = {
+                1.0, 1.0,          1.0,  // row 0
+                1.0, 1.0 + 1e-10, 0.0,  // row 1
+                1.0, 0.0,          1.0}; // row 2
+            auto near_singular_lu_data = near_singular_data;
+            solver_ref.prefactorize_and_solve(near_singular_lu_data, block_perm_ref, rhs, x_ref);
+            solver.prefactorize_and_solve(near_singular_data, rhs, x);
+            CHECK(solver.is_double_precision());
+            for (Idx i = 0; i != 3; ++i) {
+                CHECK(x[i] == doctest::Approx(x_ref[i]).epsilon(1e-14));
+            }
+
+            // the next factorization starts in single precision again
+            solver.prefactorize_and_solve(data, rhs, x);
+            CHECK(!solver.is_double_precision());
+        }
+
+        SUBCASE("Test (pseudo) singular") {
+            std::vector<double> const singular_data(9, 0.0);
+            CHECK_THROWS_AS(solver.prefactorize_and_solve(singular_data, rhs, x), SparseMatrixError);
+        }
+    }
+
+    SUBCASE("Block(double 2*2) calculation") {
+        std::vector<Tensor> const data = {
+            {{0, 1.1}, {100, 0}},  // 0, 0
+            {{1, 2}, {7.3, -1}},   // 0, 1
+            {{3, 4}, {5, 6.7}},    // 0, 2
+            {{1, 2}, {-3.9, 4}},   // 1, 0
+            {{0, 200.1}, {3, 1}},  // 1, 1
+            {{0, 0}, {0, 0}},      // 1, 2
+            {{5, 6}, {-7, 8.3}},   // 2, 0
+            {{0, 0}, {0, 0}},      // 2, 1
+            {{1.7, 0}, {0, 100}}}; // 2, 2
+        std::vector<Array> const rhs = {{0.1, 0.2}, {0.3, 0.4}, {0.5, 0.6}};
+        std::vector<Array> x_ref(3, Array::Zero());
+        std::vector<Array> x(3, Array::Zero());
+        SparseLUSolver<Tensor, Array, Array> solver_ref{symbolic};
+        SparseLUSolver<Tensor, Array, Array>::BlockPermArray block_perm_ref(3);
+        auto lu_data_ref = data;
+        solver_ref.prefactorize_and_solve(lu_data_ref, block_perm_ref, rhs, x_ref);
+
+        SparseLUMixedPrecisionSolver<Tensor, Array, Array> solver{symbolic};
+        solver.prefactorize_and_solve(data, rhs, x);
+        CHECK(!solver.is_double_precision());
+        CHECK(solver.n_refinement_steps() > 0);
+        for (Idx i = 0; i != 3; ++i) {
+            for (Idx j = 0; j != 2; ++j) {
+                CHECK(x[i](j) == doctest::Approx(x_ref[i](j)).epsilon(1e-14));
+            }
+        }
+    }
+
+    SUBCASE("Stalled refinement") {
+        // dense 8 * 8 hilbert matrix, with a condition number of 1e10
+        constexpr Idx size = 8;
+        IdxVector indptr{0};
+        IdxVector indices;
+        std::vector<DoubleComplex> data;
+        for (Idx row = 0; row != size; ++row) {
+            for (Idx col = 0; col != size; ++col) {
+                indices.push_back(col);
+                data.emplace_back(1.0 / static_cast<double>(row + col + 1), 0.0);
+            }
+            indptr.push_back(static_cast<Idx>(indices.size()));
+        }
+        auto const hilbert_symbolic = std::make_shared<SparseLUSymbolic const>(indptr, indices);
+        // x = [1, 1, ..., 1]
+        std::vector<DoubleComplex> rhs(size);
+        for (Idx row = 0; row != size; ++row) {
+            for (Idx col = 0; col != size; ++col) {
+                rhs[row] += data[row * size + col];
+            }
+        }
+        std::vector<DoubleComplex> x(size);
+        SparseLUMixedPrecisionSolver<DoubleComplex, DoubleComplex, DoubleComplex> solver{hilbert_symbolic};
+        solver.prefactorize_and_solve(data, rhs, x);
+        CHECK(solver.is_double_precision());
+        for (Idx row = 0; row != size; ++row) {
+            CHECK(cabs(x[row] - 1.0) < 1e-5);
+        }
+    }
+}
+
+TEST_CASE("Test Sparse LU symbolic factorization") {
+    // 5 * 5 matrix, elimination tree: 0 -> 2, 1 -> 2, 2 -> 4, 3 -> 4
+    /// x 0 x 0 0
+    /// 0 x x 0 0
+    /// x x x 0 x
+    /// 0 0 0 x x
+    /// 0 0 x x x
+    IdxVector const row_indptr{0, 2, 4, 8, 10, 13};
+    IdxVector const col_indices{0, 2, 1, 2, 0, 1, 2, 4, 3, 4, 2, 3, 4};
+
+    SUBCASE("Test structure") {
+        SparseLUSymbolic const symbolic{row_indptr, col_indices};
+        CHECK(symbolic.size() == 5);
+        CHECK(symbolic.nnz() == 13);
+        CHECK(symbolic.diag == IdxVector{0, 2, 6, 8, 12});
+        CHECK(symbolic.transpose_entry == IdxVector{0, 4, 2, 5, 1, 3, 6, 10, 8, 11, 7, 9, 12});
+        CHECK(symbolic.parent == IdxVector{2, 2, 4, 4, -1});
+        CHECK(symbolic.n_levels() == 3);
+        CHECK(symbolic.level_indptr == IdxVector{0, 3, 4, 5});
+        CHECK(symbolic.level_rows == IdxVector{0, 1, 3, 2, 4});
+        CHECK(symbolic.update_indptr == IdxVector{0, 1, 2, 3, 4, 4});
+        CHECK(symbolic.update_entry == IdxVector{6, 6, 12, 12});
+        CHECK(symbolic.has_update_entry());
+        CHECK(symbolic.has_pattern(row_indptr, col_indices));
+        CHECK(!symbolic.has_pattern(row_indptr, IdxVector{0, 2, 1, 2, 0, 1, 2, 3, 3, 4, 2, 3, 4}));
+    }
+
+    SUBCASE("Test update entries with fill-ins") {
+        // 3 * 3 matrix, with diagonal, two fill-ins
+        /// x x x
+        /// x x f
+        /// x f x
+        SparseLUSymbolic const symbolic{IdxVector{0, 3, 6, 9}, IdxVector{0, 1, 2, 0, 1, 2, 0, 1, 2}};
+        CHECK(symbolic.update_indptr == IdxVector{0, 4, 5, 5});
+        // pivot 0: (1, 1), (1, 2), (2, 1), (2, 2); pivot 1: (2, 2)
+        CHECK(symbolic.update_entry == IdxVector{4, 5, 7, 8, 8});
+    }
+
+    SUBCASE("Test cache") {
+        SparseLUSymbolicCache cache;
+        auto const symbolic = cache.get(row_indptr, col_indices);
+        CHECK(cache.get(row_indptr, col_indices) == symbolic);
+        CHECK(cache.size() == 1);
+
+        // different pattern
+        IdxVector const other_indptr{0, 1, 2};
+        IdxVector const other_indices{0, 1};
+        auto other = cache.get(other_indptr, other_indices);
+        CHECK(other != symbolic);
+        CHECK(other->parent == IdxVector{-1, -1});
+        CHECK(cache.size() == 2);
+
+        // released entries are not re-used and are pruned when a new pattern is added
+        std::weak_ptr<SparseLUSymbolic const> const released = other;
+        other.reset();
+        CHECK(released.expired());
+        other = cache.get(other_indptr, other_indices);
+        CHECK(cache.size() == 2);
+        CHECK(cache.get(row_indptr, col_indices) == symbolic);
+
+        // solvers can share the symbolic factorization
+        SparseLUSolver<double, double, double> const solver_1{symbolic};
+        SparseLUSolver<DoubleComplex, DoubleComplex, DoubleComplex> const solver_2{symbolic};
+        CHECK(symbolic.use_count() == 3);
+    }
+}
+
+TEST_CASE("Test Sparse LU solver - without update entries") {
+    // dense matrix, the update entries would be about size / 3 times the size of the lu matrix
+    constexpr Idx size = 16;
+    IdxVector indptr{0};
+    IdxVector indices;
+    for (Idx row = 0; row != size; ++row) {
+        for (Idx col = 0; col != size; ++col) {
+            indices.push_back(col);
+        }
+        indptr.push_back(static_cast<Idx>(indices.size()));
+    }
+    auto const symbolic = std::make_shared<SparseLUSymbolic const>(indptr, indices);
+    CHECK(symbolic->n_updates() > SparseLUSymbolic::max_update_entry_ratio * symbolic->nnz());
+    CHECK(!symbolic->has_update_entry());
+    CHECK(symbolic->update_entry.empty());
+
+    // x = [1, 1, ..., 1]
+    std::mt19937 gen{42};
+    std::uniform_real_distribution<double> value{-1.0, 1.0};
+    std::vector<double> data(indices.size());
+    std::vector<double> rhs(size, 0.0);
+    for (Idx row = 0; row != size; ++row) {
+        for (Idx col = 0; col != size; ++col) {
+            data[row * size + col] = value(gen) + (row == col ? 2.0 * size : 0.0);
+            rhs[row] += data[row * size + col];
+        }
+    }
+    SparseLUSolver<double, double, double>::BlockPermArray block_perm{};
+    std::vector<double> const x_ref(size, 1.0);
+
+    SUBCASE("Test calculation") {
+        SparseLUSolver<double, double, double> solver{symbolic};
+        auto lu_data = data;
+        std::vector<double> x(size);
+        solver.prefactorize_and_solve(lu_data, block_perm, rhs, x);
+        check_result(x, x_ref);
+
+        // the elimination tree factorization of the rows gives the same result
+        ThreadPool thread_pool{2};
+        SparseLUSolver<double, double, double> parallel_solver{symbolic};
+        parallel_solver.set_parallelism({.thread_pool = &thread_pool, .n_threads = 2, .min_size = 0});
+        auto parallel_lu_data = data;
+        parallel_solver.prefactorize(parallel_lu_data, block_perm);
+        check_result(parallel_lu_data, lu_data);
+    }
+
+    SUBCASE("Test refactorize") {
+        SparseLUSolver<double, double, double> solver{symbolic};
+        auto lu_data = data;
+        solver.prefactorize(lu_data, block_perm);
+        // an off-diagonal pair in the last row, only the last row is factorized again
+        auto changed_data = data;
+        IdxVector const changed{indptr[size - 1], size - 1};
+        for (Idx const entry : changed) {
+            changed_data[entry] *= 1.5;
+        }
+        CHECK(solver.refactorize(changed_data, lu_data, block_perm, changed));
+        auto lu_data_ref = changed_data;
+        solver.prefactorize(lu_data_ref, block_perm);
+        check_result(lu_data, lu_data_ref);
+    }
+}
+
+TEST_CASE("Test Sparse LU solver - elimination tree") {
+    // random tree with extra meshes, natural ordering with the fill-ins of the elimination
+    constexpr Idx size = 200;
+    std::mt19937 gen{42};
+    std::vector<std::set<Idx>> pattern(size);
+    auto const add_edge = [&pattern](Idx i, Idx j) {
+        pattern[i].insert(j);
+        pattern[j].insert(i);
+    };
+    for (Idx i = 0; i != size - 1; ++i) {
+        add_edge(i, std::uniform_int_distribution<Idx>{i + 1, size - 1}(gen));
+    }
+    for (Idx mesh = 0; mesh != 10; ++mesh) {
+        add_edge(std::uniform_int_distribution<Idx>{0, size - 1}(gen), std::uniform_int_distribution<Idx>{0, size - 1}(gen));
+    }
+    for (Idx k = 0; k != size; ++k) {
+        for (Idx const i : pattern[k]) {
+            for (Idx const j : pattern[k]) {
+                if (i > k && j > k && i != j) {
+                    add_edge(i, j);
+                }
+            }
+        }
+    }
+    IdxVector indptr{0};
+    IdxVector indices;
+    IdxVector diag;
+    for (Idx row = 0; row != size; ++row) {
+        pattern[row].insert(row);
+        for (Idx const col : pattern[row]) {
+            if (col == row) {
+                diag.push_back(static_cast<Idx>(indices.size()));
+            }
+            indices.push_back(col);
+        }
+        indptr.push_back(static_cast<Idx>(indices.size()));
+    }
+    auto const row_indptr = std::make_shared<IdxVector const>(indptr);
+    auto const col_indices = std::make_shared<IdxVector const>(indices);
+    auto const diag_lu = std::make_shared<IdxVector const>(diag);
+
+    ThreadPool thread_pool{4};
+    std::uniform_real_distribution<double> value{-1.0, 1.0};
+
+    auto const check_parallel = [&]<class SolverType, class T, class RHS>(std::vector<T> const& data,
+                                                                          std::vector<RHS> const& rhs) {
+        typename SolverType::BlockPermArray block_perm{};
+        if constexpr (SolverType::is_block) {
+            block_perm.resize(size);
+        }
+        auto const solve = [&](Idx n_threads) {
+            SolverType solver{row_indptr, col_indices, diag_lu};
+            solver.set_parallelism({.thread_pool = &thread_pool, .n_threads = n_threads, .min_size = 0});
+            CHECK(solver.is_parallel() == (n_threads > 1));
+            auto lu_data = data;
+            std::vector<RHS> x(size);
+            solver.prefactorize_and_solve(lu_data, block_perm, rhs, x);
+            return std::make_pair(lu_data, x);
+        };
+
+        auto const [lu_sequential, x_sequential] = solve(1);
+        auto const [lu_parallel, x_parallel] = solve(2);
+        auto const [lu_parallel_4, x_parallel_4] = solve(4);
+
+        // same result as the sequential factorization
+        check_result(lu_parallel, lu_sequential);
+        check_result(x_parallel, x_sequential);
+        // deterministic, independent of the number of threads
+        auto const is_same = [](auto const& lhs, auto const& rhs) {
+            if constexpr (SolverType::is_block) {
+                return (lhs == rhs).all();
+            } else {
+                return lhs == rhs;
+            }
+        };
+        CHECK(std::ranges::equal(lu_parallel, lu_parallel_4, is_same));
+        CHECK(std::ranges::equal(x_parallel, x_parallel_4, is_same));
+
+        // singular pivot in a leaf
+        SolverType solver{row_indptr, col_indices, diag_lu};
+        solver.set_parallelism({.thread_pool = &thread_pool, .n_threads = 4, .min_size = 0});
+        auto singular_data = data;
+        if constexpr (SolverType::is_block) {
+            singular_data[diag.front()].setZero();
+        } else {
+            singular_data[diag.front()] = 0.0;
+        }
+        std::vector<RHS> x(size);
+        CHECK_THROWS_AS(solver.prefactorize_and_solve(singular_data, block_perm, rhs, x), SparseMatrixError);
+    };
+
+    auto const check_refactorize = [&]<class SolverType, class T>(std::vector<T> const& data) {
+        typename SolverType::BlockPermArray block_perm{};
+        typename SolverType::BlockPermArray block_perm_ref{};
+        if constexpr (SolverType::is_block) {
+            block_perm.resize(size);
+            block_perm_ref.resize(size);
+        }
+        auto const is_same = [](auto const& lhs, auto const& rhs) {
+            if constexpr (SolverType::is_block) {
+                return (lhs == rhs).all();
+            } else {
+                return lhs == rhs;
+            }
+        };
+        SolverType solver{row_indptr, col_indices, diag_lu};
+        auto lu_data = data;
+        solver.prefactorize(lu_data, block_perm);
+        auto changed_data = data;
+
+        auto const check_changed = [&](IdxVector const& changed) {
+            for (Idx const entry : changed) {
+                changed_data[entry] *= 1.5;
+            }
+            solver.refactorize(changed_data, lu_data, block_perm, changed);
+
+            // same result as a full factorization
+            auto lu_data_ref = changed_data;
+            solver.prefactorize(lu_data_ref, block_perm_ref);
+            CHECK(std::ranges::equal(lu_data, lu_data_ref, is_same));
+            if constexpr (SolverType::is_block) {
+                CHECK(block_perm == block_perm_ref);
+            }
+        };
+
+        SparseLUSymbolic const symbolic{indptr, indices};
+        // the diagonal and an off-diagonal pair in the last row: only the root is refactorized
+        Idx const last_row = size - 1;
+        check_changed({diag.back(), indptr[last_row], symbolic.transpose_entry[indptr[last_row]]});
+        // the diagonal of the first row and an off-diagonal pair in the middle: long paths in the elimination tree
+        Idx const row = size / 2;
+        check_changed({diag.front(), indptr[row], symbolic.transpose_entry[indptr[row]]});
+        // nothing changed
+        check_changed({});
+    };
+
+    auto const check_sparse = [&]<class SolverType, class T, class RHS>(std::vector<T> const& data,
+                                                                        std::vector<RHS> const& rhs) {
+        typename SolverType::BlockPermArray block_perm{};
+        if constexpr (SolverType::is_block) {
+            block_perm.resize(size);
+        }
+        SolverType solver{row_indptr, col_indices, diag_lu};
+        auto lu_data = data;
+        solver.prefactorize(lu_data, block_perm);
+
+        auto const check_rows = [&](IdxVector const& rhs_rows, IdxVector const& x_rows) {
+            // right hand side with zeros outside rhs_rows
+            std::vector<RHS> sparse_rhs(size, 0.0 * rhs.front());
+            for (Idx const row : rhs_rows) {
+                sparse_rhs[row] = rhs[row];
+            }
+            std::vector<RHS> x_ref(size);
+            solver.solve_with_prefactorized_matrix(lu_data, block_perm, sparse_rhs, x_ref);
+            std::vector<RHS> x(size);
+            solver.solve_sparse_with_prefactorized_matrix(lu_data, block_perm, sparse_rhs, rhs_rows, x_rows, x);
+            for (Idx const row : x_rows) {
+                check_result(std::vector<RHS>{x[row]}, std::vector<RHS>{x_ref[row]});
+            }
+        };
+
+        Idx const last_row = size - 1;
+        check_rows({0}, {0});
+        check_rows({3, size / 2}, {1, last_row});
+        check_rows({last_row}, {0, size / 3, size / 2});
+        // the solve can be repeated with other rows
+        check_rows({size / 3, size / 3 + 1, last_row}, {size / 3 + 2});
+        check_rows({}, {0, last_row});
+    };
+
+    SUBCASE("Scalar(complex) calculation") {
+        ComplexTensorVector<symmetric_t> data(indices.size());
+        ComplexValueVector<symmetric_t> rhs(size);
+        for (Idx row = 0; row != size; ++row) {
+            for (Idx idx = indptr[row]; idx != indptr[row + 1]; ++idx) {
+                data[idx] = DoubleComplex{value(gen), value(gen)};
+            }
+            data[diag[row]] += 20.0;
+            rhs[row] = DoubleComplex{value(gen), value(gen)};
+        }
+        check_parallel.template operator()<SparseLUSolver<DoubleComplex, DoubleComplex, DoubleComplex>>(data, rhs);
+        check_refactorize.template operator()<SparseLUSolver<DoubleComplex, DoubleComplex, DoubleComplex>>(data);
+        check_sparse.template operator()<SparseLUSolver<DoubleComplex, DoubleComplex, DoubleComplex>>(data, rhs);
+    }
+
+    SUBCASE("Block(double 2*2) calculation") {
+        std::vector<Tensor> data(indices.size());
+        std::vector<Array> rhs(size);
+        for (Idx row = 0; row != size; ++row) {
+            for (Idx idx = indptr[row]; idx != indptr[row + 1]; ++idx) {
+                data[idx] = Tensor{{value(gen), value(gen)}, {value(gen), value(gen)}};
+            }
+            // off-diagonal pivot to have non-trivial block permutations
+            data[diag[row]] += Tensor{{0.0, 20.0}, {20.0, 0.0}};
+            rhs[row] = Array{value(gen), value(gen)};
+        }
+        check_parallel.template operator()<SparseLUSolver<Tensor, Array, Array>>(data, rhs);
+        check_refactorize.template operator()<SparseLUSolver<Tensor, Array, Array>>(data);
+        check_sparse.template operator()<SparseLUSolver<Tensor, Array, Array>>(data, rhs);
     }
 }
 
@@ -6,12 +6,34 @@
 
 #include <doctest/doctest.h>
 
+#include <algorithm>
 #include <chrono>
 #include <iostream>
+#include <set>
 #include <sstream>
 
 namespace {
 using power_grid_model::Idx;
+
+// n_side x n_side mesh with vertex ids with gaps, optionally with a diagonal in every cell
+std::map<Idx, std::vector<Idx>> make_mesh(Idx n_side, bool with_diagonals) {
+    auto const id = [n_side](Idx row, Idx col) { return 2 * (row * n_side + col) + 1; };
+    std::map<Idx, std::vector<Idx>> graph;
+    for (Idx row = 0; row != n_side; ++row) {
+        for (Idx col = 0; col != n_side; ++col) {
+            if (row + 1 != n_side) {
+                graph[id(row, col)].push_back(id(row + 1, col));
+            }
+            if (col + 1 != n_side) {
+                graph[id(row, col)].push_back(id(row, col + 1));
+            }
+            if (with_diagonals && row + 1 != n_side && col + 1 != n_side) {
+                graph[id(row, col)].push_back(id(row + 1, col + 1));
+            }
+        }
+    }
+    return graph;
+}
 } // namespace
 
 TEST_CASE("Test sparse ordering") {
@@ -29,4 +51,77 @@ TEST_CASE("Test sparse ordering") {
         CHECK(alpha == std::vector<Idx>{0, 1, 2, 3, 4, 5, 6, 7, 8, 9});
         CHECK(fills == std::vector<std::pair<Idx, Idx>>{{3, 5}, {4, 5}, {5, 8}, {5, 6}, {5, 7}});
     }
+
+    SUBCASE("minimum_degree_ordering on mesh") {
+        // 10 x 10 mesh, vertex ids with gaps
+        auto const graph = make_mesh(10, false);
+        std::map<Idx, std::set<Idx>> eliminated_graph;
+        for (auto const& [from, adjacent] : graph) {
+            for (Idx const to : adjacent) {
+                eliminated_graph[from].insert(to);
+                eliminated_graph[to].insert(from);
+            }
+        }
+
+        auto const [alpha, fills] = power_grid_model::minimum_degree_ordering(graph);
+
+        // the ordering is a permutation of all vertices
+        std::vector<Idx> sorted_alpha = alpha;
+        std::ranges::sort(sorted_alpha);
+        std::vector<Idx> all_vertices;
+        for (auto const& [vertex, adjacent] : eliminated_graph) {
+            all_vertices.push_back(vertex);
+        }
+        CHECK(sorted_alpha == all_vertices);
+
+        // the fill-ins are exactly the edges created by eliminating the vertices in this order
+        std::set<std::pair<Idx, Idx>> expected_fills;
+        for (Idx const u : alpha) {
+            std::set<Idx> const neighbours = eliminated_graph[u];
+            for (Idx const v : neighbours) {
+                eliminated_graph[v].erase(u);
+                for (Idx const w : neighbours) {
+                    if (v < w && eliminated_graph[v].insert(w).second) {
+                        eliminated_graph[w].insert(v);
+                        expected_fills.emplace(v, w);
+                    }
+                }
+            }
+            eliminated_graph.erase(u);
+        }
+        std::set<std::pair<Idx, Idx>> actual_fills;
+        for (auto const& [from, to] : fills) {
+            actual_fills.emplace(std::min(from, to), std::max(from, to));
+        }
+        CHECK(actual_fills.size() == fills.size());
+        CHECK(actual_fills == expected_fills);
+    }
+    SUBCASE("minimum_degree_ordering same as the map/set implementation") {
+        // orderings and fill-ins recorded with the previous implementation based on std::map and std::set
+        SUBCASE("6 x 6 mesh") {
+            auto const [alpha, fills] = power_grid_model::minimum_degree_ordering(make_mesh(6, false));
+            CHECK(alpha == std::vector<Idx>{1,  11, 61, 71, 3,  7,  13, 23, 37, 47, 63, 67, 9,  15, 21, 29, 43, 49,
+                                            51, 57, 59, 69, 19, 33, 39, 53, 5,  17, 31, 25, 27, 65, 41, 55, 35, 45});
+            CHECK(fills == std::vector<std::pair<Idx, Idx>>{
+                               {3, 13},  {9, 23},  {49, 63}, {59, 69}, {5, 15},  {5, 13},  {5, 9},   {5, 19},
+                               {9, 19},  {5, 25},  {15, 25}, {9, 35},  {21, 35}, {25, 39}, {25, 49}, {39, 49},
+                               {35, 45}, {35, 59}, {45, 59}, {49, 65}, {51, 65}, {55, 65}, {55, 69}, {65, 69},
+                               {5, 21},  {5, 35},  {19, 35}, {5, 27},  {17, 27}, {17, 25}, {5, 33},  {19, 33},
+                               {17, 31}, {17, 41}, {27, 31}, {27, 41}, {31, 41}, {31, 45}, {31, 55}, {41, 45},
+                               {41, 55}, {45, 55}, {25, 51}, {25, 65}, {39, 65}, {25, 53}, {39, 53}, {45, 69},
+                               {55, 59}, {35, 69}, {35, 55}, {35, 65}, {45, 65}, {5, 31},  {17, 35}, {17, 33},
+                               {31, 35}, {5, 45},  {17, 45}, {25, 41}, {27, 65}, {27, 53}, {41, 65}, {25, 55},
+                               {27, 55}, {25, 35}, {25, 31}, {25, 45}, {27, 35}, {27, 45}, {35, 41}});
+        }
+        SUBCASE("5 x 5 mesh with diagonals") {
+            auto const [alpha, fills] = power_grid_model::minimum_degree_ordering(make_mesh(5, true));
+            CHECK(alpha == std::vector<Idx>{9,  41, 1,  7,  19, 31, 43, 49, 3,  17, 21, 29, 33,
+                                            45, 5,  15, 13, 27, 25, 11, 23, 35, 47, 39, 37});
+            CHECK(fills == std::vector<std::pair<Idx, Idx>>{
+                               {3, 11},  {5, 19},  {5, 29},  {21, 43}, {21, 45}, {39, 47}, {5, 13},  {5, 11},
+                               {11, 15}, {5, 27},  {15, 29}, {11, 33}, {11, 45}, {23, 45}, {5, 39},  {15, 39},
+                               {11, 35}, {11, 47}, {23, 47}, {11, 27}, {11, 39}, {13, 27}, {13, 39}, {11, 25},
+                               {25, 39}, {23, 27}, {23, 39}, {11, 37}, {23, 37}, {35, 39}});
+        }
+    }
 }
@@ -0,0 +1,54 @@
+// SPDX-FileCopyrightText: Contributors to the Power Grid Model project <powergridmodel@lfenergy.org>
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#include <power_grid_model/thread_pool.hpp>
+
+#include <doctest/doctest.h>
+
+#include <atomic>
+#include <set>
+#include <stdexcept>
+
+namespace power_grid_model {
+
+TEST_CASE("Test thread pool") {
+    ThreadPool pool{4};
+    CHECK(pool.n_threads() == 4);
+
+    SUBCASE("Run job on requested number of workers") {
+        std::atomic<Idx> count{0};
+        pool.run(3, [&count] { ++count; });
+        CHECK(count == 3);
+        pool.run(10, [&count] { ++count; });
+        CHECK(count == 7);
+    }
+
+    SUBCASE("Threads are reused between runs") {
+        std::mutex mutex;
+        std::set<std::thread::id> thread_ids;
+        auto const job = [&mutex, &thread_ids] {
+            std::scoped_lock const lock{mutex};
+            thread_ids.insert(std::this_thread::get_id());
+        };
+        for (Idx repeat = 0; repeat != 20; ++repeat) {
+            pool.run(4, job);
+        }
+        CHECK(thread_ids.size() == 4);
+    }
+
+    SUBCASE("Exception is re-thrown") {
+        CHECK_THROWS_AS(pool.run(2, [] { throw std::runtime_error{"error"}; }), std::runtime_error);
+        // the pool is still usable afterwards
+        std::atomic<Idx> count{0};
+        pool.run(4, [&count] { ++count; });
+        CHECK(count == 4);
+    }
+
+    SUBCASE("Hardware threads") {
+        ThreadPool const hardware_pool{0};
+        CHECK(hardware_pool.n_threads() >= 1);
+    }
+}
+
+} // namespace power_grid_model
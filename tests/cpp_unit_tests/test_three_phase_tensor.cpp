@@ -206,6 +206,26 @@ TEST_CASE("Three phase tensor") {
         CHECK(is_nan(vec(1)));
         CHECK(vec(2) == 6.0);
     }
+
+    SUBCASE("Test split complex layout - sym") {
+        SplitComplexValue<symmetric_t> const value{DoubleComplex{1.0, 2.0}};
+        CHECK(value.real == 1.0);
+        CHECK(value.imag == 2.0);
+        SplitComplexTensor<symmetric_t> const tensor{DoubleComplex{3.0, -4.0}};
+        CHECK(tensor.real == 3.0);
+        CHECK(tensor.imag == -4.0);
+    }
+
+    SUBCASE("Test split complex layout - asym") {
+        ComplexValue<asymmetric_t> const vec{DoubleComplex{1.0, 2.0}, DoubleComplex{3.0, 4.0}, DoubleComplex{5.0, 6.0}};
+        SplitComplexValue<asymmetric_t> const value{vec};
+        CHECK((value.real == real(vec)).all());
+        CHECK((value.imag == imag(vec)).all());
+        ComplexTensor<asymmetric_t> const mat{1.0 + 2.0i, 3.0 - 1.0i};
+        SplitComplexTensor<asymmetric_t> const tensor{mat};
+        CHECK((tensor.real == real(mat)).all());
+        CHECK((tensor.imag == imag(mat)).all());
+    }
 }
 
 } // namespace power_grid_model
\ No newline at end of file
@@ -15,6 +15,7 @@
 namespace power_grid_model {
 
 namespace {
+using math_solver::SparseLUSymbolicCache;
 using math_solver::YBusStructure;
 } // namespace
 
@@ -144,17 +145,50 @@ TEST_CASE("Test y bus") {
             auto const& ybus_struct = ybus.get_y_bus_structure();
             CHECK(ybus_struct->bus_entry == ybus_struct_ref.bus_entry);
             CHECK(ybus_struct->col_indices == ybus_struct_ref.col_indices);
-            CHECK(ybus_struct->col_indices_lu == ybus_struct_ref.col_indices_lu);
-            CHECK(ybus_struct->diag_lu == ybus_struct_ref.diag_lu);
-            CHECK(ybus_struct->lu_transpose_entry == ybus_struct_ref.lu_transpose_entry);
+            CHECK(ybus_struct->lu_symbolic()->col_indices == ybus_struct_ref.lu_symbolic()->col_indices);
+            CHECK(ybus_struct->lu_symbolic()->diag == ybus_struct_ref.lu_symbolic()->diag);
+            CHECK(ybus_struct->lu_symbolic()->transpose_entry == ybus_struct_ref.lu_symbolic()->transpose_entry);
             CHECK(ybus_struct->map_lu_y_bus == ybus_struct_ref.map_lu_y_bus);
             CHECK(ybus_struct->row_indptr == ybus_struct_ref.row_indptr);
-            CHECK(ybus_struct->row_indptr_lu == ybus_struct_ref.row_indptr_lu);
+            CHECK(ybus_struct->lu_symbolic()->row_indptr == ybus_struct_ref.lu_symbolic()->row_indptr);
             CHECK(ybus_struct->y_bus_element.size() == ybus_struct_ref.y_bus_element.size());
             CHECK(ybus_struct->y_bus_entry_indptr == ybus_struct_ref.y_bus_entry_indptr);
         }
     }
 
+    SUBCASE("Test parameter to entry map") {
+        YBusStructure const ybus_struct{topo};
+        CHECK(ybus_struct.branch_param_entry_indptr == IdxVector{0, 4, 8, 12, 16, 20, 21});
+        CHECK(ybus_struct.branch_param_entries == IdxVector{0, 1, 2, 3,  // branch 0: [0,0], [0,1], [1,0], [1,1]
+                                                            3, 4, 5, 6,  // branch 1: [1,1], [1,2], [2,1], [2,2]
+                                                            6, 7, 8, 9,  // branch 2: [2,2], [2,3], [3,2], [3,3]
+                                                            6, 7, 8, 9,  // branch 3: [2,2], [2,3], [3,2], [3,3]
+                                                            0, 1, 2, 3,  // branch 4: [0,0], [0,1], [1,0], [1,1]
+                                                            6});         // branch 5: [2,2]
+        CHECK(ybus_struct.shunt_param_entry_indptr == IdxVector{0, 1, 2});
+        CHECK(ybus_struct.shunt_param_entries == IdxVector{0, 9});
+
+        YBus<symmetric_t> const ybus{topo_ptr, std::make_shared<MathModelParam<symmetric_t> const>(param_sym)};
+        MathModelParamIncrement math_model_param_incrmt;
+        math_model_param_incrmt.branch_param_to_change = {5, 2};
+        math_model_param_incrmt.shunt_param_to_change = {1};
+        CHECK(ybus.increments_to_entries(math_model_param_incrmt) == IdxVector{6, 7, 8, 9});
+    }
+
+    SUBCASE("Test shared symbolic factorization") {
+        auto const cache = std::make_shared<SparseLUSymbolicCache>();
+        YBusStructure const ybus_struct_1{topo, cache};
+        YBusStructure const ybus_struct_2{topo, cache};
+        YBusStructure const ybus_struct_3{topo};
+        // the symbolic factorization is only calculated at the first use
+        CHECK(cache->size() == 0);
+        CHECK(ybus_struct_1.lu_symbolic() == ybus_struct_2.lu_symbolic());
+        CHECK(ybus_struct_1.lu_symbolic() != ybus_struct_3.lu_symbolic());
+        CHECK(ybus_struct_3.lu_symbolic()->has_pattern(ybus_struct_1.lu_symbolic()->row_indptr,
+                                                       ybus_struct_1.lu_symbolic()->col_indices));
+        CHECK(cache->size() == 1);
+    }
+
     SUBCASE("Test y bus construction (asymmetrical)") {
         YBus<symmetric_t> const ybus_sym{topo_ptr, std::make_shared<MathModelParam<symmetric_t> const>(param_sym)};
         // construct from existing structure
@@ -264,12 +298,12 @@ TEST_CASE("Test fill-in y bus") {
     CHECK(row_indptr == ybus.row_indptr);
     CHECK(col_indices == ybus.col_indices);
     CHECK(bus_entry == ybus.bus_entry);
-    CHECK(lu_transpose_entry == ybus.lu_transpose_entry);
+    CHECK(lu_transpose_entry == ybus.lu_symbolic()->transpose_entry);
     CHECK(y_bus_entry_indptr == ybus.y_bus_entry_indptr);
     // check lu
-    CHECK(ybus.row_indptr_lu == row_indptr_lu);
-    CHECK(ybus.col_indices_lu == col_indices_lu);
-    CHECK(ybus.diag_lu == diag_lu);
+    CHECK(ybus.lu_symbolic()->row_indptr == row_indptr_lu);
+    CHECK(ybus.lu_symbolic()->col_indices == col_indices_lu);
+    CHECK(ybus.lu_symbolic()->diag == diag_lu);
     CHECK(ybus.map_lu_y_bus == map_lu_y_bus);
 }
 
@@ -398,6 +432,19 @@ TEST_CASE("Incremental update y-bus") {
         verify_admittance(ybus.admittance(), admittance_sym);
     }
 
+    SUBCASE("Test admittance id") {
+        YBus<symmetric_t> ybus{topo_ptr, std::make_shared<MathModelParam<symmetric_t> const>(param_sym)};
+        YBus<symmetric_t> const ybus_copy{ybus};
+        CHECK(ybus_copy.admittance_id() == ybus.admittance_id());
+
+        // every update gets a new id, also for the same parameters
+        ybus.update_admittance(std::make_shared<MathModelParam<symmetric_t> const>(param_sym));
+        CHECK(ybus.admittance_id() != ybus_copy.admittance_id());
+        YBus<symmetric_t> const other_ybus{topo_ptr, std::make_shared<MathModelParam<symmetric_t> const>(param_sym)};
+        CHECK(other_ybus.admittance_id() != ybus.admittance_id());
+        CHECK(other_ybus.admittance_id() != ybus_copy.admittance_id());
+    }
+
     SUBCASE("Test progressive update") {
         YBus<symmetric_t> ybus{topo_ptr, std::make_shared<MathModelParam<symmetric_t> const>(param_sym)};
         verify_admittance(ybus.admittance(), admittance_sym);
@@ -296,7 +296,9 @@ std::map<std::string, CalculationMethod, std::less<>> const calculation_method_m
     {"iterative_current", CalculationMethod::iterative_current},
     {"iterative_linear", CalculationMethod::iterative_linear},
     {"linear_current", CalculationMethod::linear_current},
-    {"iec60909", CalculationMethod::iec60909}};
+    {"iec60909", CalculationMethod::iec60909},
+    {"fast_decoupled", CalculationMethod::fast_decoupled},
+    {"dc", CalculationMethod::dc}};
 std::map<std::string, ShortCircuitVoltageScaling, std::less<>> const sc_voltage_scaling_mapping = {
     {"", ShortCircuitVoltageScaling::maximum}, // not provided returns default value
     {"minimum", ShortCircuitVoltageScaling::minimum},